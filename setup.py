@@ -73,6 +73,20 @@ class CMakeBuild(build_ext):
         subprocess.check_call(['cmake', ext.sourcedir] + cmake_args, cwd=self.build_temp, env=env)
         subprocess.check_call(['cmake', '--build', '.'] + build_args, cwd=self.build_temp)
 
+        # Compile the binary CAD tables (see CADTable) of the JSON databases
+        # with the module just built, so they match its layout and byte order
+        json_dir = os.path.join(ext.sourcedir, 'src', 'DSGRN', 'Resources', 'CAD')
+        cad_dir = os.path.join(extdir, 'Resources', 'CAD')
+        compile_script = '\n'.join([
+            'import glob, os, sys',
+            'sys.path.insert(0, sys.argv[1])',
+            'import _dsgrn',
+            'os.makedirs(sys.argv[3], exist_ok=True)',
+            'for json_filename in sorted(glob.glob(os.path.join(sys.argv[2], "*.json"))):',
+            '    name = os.path.splitext(os.path.basename(json_filename))[0]',
+            '    _dsgrn.CADTable.compile(json_filename, os.path.join(sys.argv[3], name + ".cad"))'])
+        subprocess.check_call([sys.executable, '-c', compile_script, extdir, json_dir, cad_dir])
+
 # Read the contents of README.md file
 this_directory = os.path.abspath(os.path.dirname(__file__))
 with open(os.path.join(this_directory, 'README.md'), encoding='utf-8') as f:
@@ -18,11 +18,16 @@ public:
 private:
   std::string network_spec_filename_;
   std::string database_filename_;
+  bool bulk_load_;
+  bool wal_;
+  std::string index_profile_;
+  bool compact_;
   ParameterGraph pg_;
   Network network_;
   uint64_t start_job_;
   uint64_t end_job_;
   sqlite::database db_;
   std::unordered_map<std::string, uint64_t> mg_lookup_;
+  std::unordered_map<std::string, uint64_t> label_lookup_;
 };
 #endif
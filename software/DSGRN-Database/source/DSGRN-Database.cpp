@@ -4,13 +4,150 @@
 
 using namespace sqlite;
 
+/// Compact schema (user_version 2)
+///   One row per Morse graph in MorseGraphs holding the vertex count
+///   (vertices are always 0..n-1), the edge list as a blob of big-endian
+///   uint32 (Source, Target) pairs and the Graphviz text. Annotations
+///   are integer rows (MorseGraphIndex, Vertex, LabelIndex) of
+///   MorseGraphLabels, where labels are interned in AnnotationLabels, so
+///   that label lookups go through the UNIQUE index on Label and the
+///   indices of MorseGraphLabels. The legacy tables MorseGraphVertices,
+///   MorseGraphEdges, MorseGraphAnnotations and MorseGraphViz are
+///   provided as views, so that existing SQL (e.g. DSGRN.Query) keeps
+///   working. The vertex and edge views join MorseGraphs with Positions
+///   (0, 1, 2, ... up to the longest list) so that lookups by
+///   MorseGraphIndex go through the primary keys.
+
+/// compact_uint32
+///   Append x to a blob as a big-endian uint32
+static void
+compact_uint32 ( blob & b, uint64_t x ) {
+  if ( x > 0xFFFFFFFFULL ) throw std::runtime_error ( "compact schema: value exceeds 32 bits" );
+  for ( int shift = 24; shift >= 0; shift -= 8 ) b . push_back ( (unsigned char) ( x >> shift ) );
+}
+
+/// decode_uint32
+///   SQL expression decoding the big-endian uint32 starting at
+///   (1-based) byte "offset" of the blob "column"
+static std::string
+decode_uint32 ( std::string const& column, std::string const& offset ) {
+  std::string H = "hex(substr(" + column + ", " + offset + ", 4))";
+  std::string result = "(";
+  for ( int k = 0; k < 8; ++ k ) {
+    if ( k > 0 ) result += " + ";
+    result += "((instr('0123456789ABCDEF', substr(" + H + ", " 
+              + std::to_string(k+1) + ", 1)) - 1) << " + std::to_string(4*(7-k)) + ")";
+  }
+  return result + ")";
+}
+
+/// decode_pairs
+///   SQL query listing (MorseGraphIndex, First, Second) for the
+///   uint32 pairs stored in the blob column of MorseGraphs
+static std::string
+decode_pairs ( std::string const& column, std::string const& first, std::string const& second ) {
+  return "select MorseGraphIndex, " + decode_uint32 ( column, "8*Position + 1" ) + " as " + first + ", "
+         + decode_uint32 ( column, "8*Position + 5" ) + " as " + second + " "
+         "from MorseGraphs join Positions on Position < length(" + column + ")/8";
+}
+
+static std::vector<std::string> const
+compact_schema = {
+  "create table if not exists MorseGraphs (MorseGraphIndex INTEGER PRIMARY KEY, Vertices INTEGER, Edges BLOB, Graphviz TEXT);",
+  "create table if not exists AnnotationLabels (LabelIndex INTEGER PRIMARY KEY, Label TEXT UNIQUE);",
+  "create table if not exists MorseGraphLabels (MorseGraphIndex INTEGER, Vertex INTEGER, LabelIndex INTEGER);",
+  "create table if not exists Positions (Position INTEGER PRIMARY KEY);",
+  "create view if not exists MorseGraphVertices as "
+    "select MorseGraphIndex, Position as Vertex from MorseGraphs join Positions on Position < Vertices;",
+  "create view if not exists MorseGraphEdges as " + decode_pairs ( "Edges", "Source", "Target" ) + ";",
+  "create view if not exists MorseGraphAnnotations as "
+    "select MorseGraphIndex, Vertex, Label from MorseGraphLabels natural join AnnotationLabels;",
+  "create view if not exists MorseGraphViz as select MorseGraphIndex, Graphviz from MorseGraphs;",
+  "pragma user_version = 2;" };
+
+/// compact_positions
+///   Fill Positions with 0..n-1, n the largest vertex or edge count
+static std::string const
+compact_positions = "insert or ignore into Positions (Position) "
+  "with recursive P(k) as (select 0 union all select k + 1 from P where k + 1 < "
+  "(select max(max(Vertices), length(Edges)/8) from MorseGraphs)) "
+  "select k from P;";
+
+/// MorseGraphFeatures
+///   Per Morse graph summary of its minimal (stable) Morse nodes, used by
+///   the Python queries (MonostableQuery, StableFCQuery, ...) in place of
+///   joins over MorseGraphVertices, MorseGraphEdges and MorseGraphAnnotations.
+///     MinimalCount         : number of minimal Morse nodes
+///     MinimalFP/FC/XC      : number of minimal nodes annotated FP, FC, XC
+///     MinimalFPCoordinates : JSON list of the FP coordinates of minimal nodes
+///     MinimalFCVertices    : JSON list of minimal nodes annotated FC
+static std::string const
+features_schema = "create table if not exists MorseGraphFeatures (MorseGraphIndex INTEGER PRIMARY KEY, "
+  "MinimalCount INTEGER, MinimalFP INTEGER, MinimalFC INTEGER, MinimalXC INTEGER, "
+  "MinimalFPCoordinates TEXT, MinimalFCVertices TEXT);";
+
+struct MorseGraphFeatures {
+  uint64_t minimal = 0;
+  uint64_t fp = 0;
+  uint64_t fc = 0;
+  uint64_t xc = 0;
+  std::string fp_coordinates = "[]";
+  std::string fc_vertices = "[]";
+};
+
+/// morse_graph_features
+///   Compute the MorseGraphFeatures row of a Morse graph
+static MorseGraphFeatures
+morse_graph_features ( MorseGraph const& mg ) {
+  MorseGraphFeatures result;
+  std::vector<std::string> coordinates;
+  std::vector<std::string> fc_vertices;
+  uint64_t N = mg . poset () . size ();
+  for ( uint64_t v = 0; v < N; ++ v ) {
+    if ( not mg . poset () . children ( v ) . empty () ) continue;
+    ++ result . minimal;
+    for ( std::string const& label : mg . annotation ( v ) ) {
+      if ( label . compare ( 0, 2, "FP" ) == 0 ) {
+        ++ result . fp;
+        // "FP { a, b, c }" -> "[a,b,c]"
+        std::string coordinate = "[";
+        for ( char c : label . substr ( 2 ) ) {
+          if ( std::isdigit ( c ) || c == ',' ) coordinate . push_back ( c );
+        }
+        coordinates . push_back ( coordinate + "]" );
+      } else if ( label == "FC" ) {
+        ++ result . fc;
+        fc_vertices . push_back ( std::to_string ( v ) );
+      } else if ( label . compare ( 0, 2, "XC" ) == 0 ) {
+        ++ result . xc;
+      }
+    }
+  }
+  auto join = [] ( std::vector<std::string> const& items ) {
+    std::string joined = "[";
+    for ( uint64_t i = 0; i < items . size (); ++ i ) {
+      if ( i > 0 ) joined += ",";
+      joined += items [ i ];
+    }
+    return joined + "]";
+  };
+  result . fp_coordinates = join ( coordinates );
+  result . fc_vertices = join ( fc_vertices );
+  return result;
+}
+
 int main ( int argc, char * argv [] ) {
   if ( argc < 3 ) {
     std::cout << "Please supply the following arguments:\n" 
                   " --> network specification file \n"
                   " --> output file \n"
                   " --> [start parameter index] (optional)\n"
-                  " --> [one-past-end parameter index] (optional)\n";
+                  " --> [one-past-end parameter index] (optional)\n"
+                 " Options:\n"
+                 " --> --bulk : bulk-load pragmas (no journal, no sync)\n"
+                 " --> --wal : bulk-load pragmas with a write-ahead log\n"
+                 " --> --indices=full|query|none : index profile (default full)\n"
+                 " --> --compact : compact schema with compatibility views\n";
     return 1;
   }
   Signatures process;
@@ -23,23 +160,52 @@ int main ( int argc, char * argv [] ) {
 
 int Signatures::
 command_line ( int argc, char * argv [] ) {
-  network_spec_filename_ = argv[1];
-  database_filename_ = argv[2];
+  // Separate options from positional arguments
+  bulk_load_ = false;
+  wal_ = false;
+  index_profile_ = "full";
+  compact_ = false;
+  std::vector<std::string> args;
+  for ( int i = 1; i < argc; ++ i ) {
+    std::string arg ( argv[i] );
+    if ( arg == "--bulk" ) {
+      bulk_load_ = true;
+    } else if ( arg == "--wal" ) {
+      bulk_load_ = true;
+      wal_ = true;
+    } else if ( arg == "--compact" ) {
+      compact_ = true;
+    } else if ( arg . compare ( 0, 10, "--indices=" ) == 0 ) {
+      index_profile_ = arg . substr ( 10 );
+      auto const& profiles = DatabaseIndexProfiles ();
+      auto it = std::find_if ( profiles . begin (), profiles . end (),
+        [&](DatabaseIndexProfile const& p){ return p.first == index_profile_; });
+      if ( it == profiles . end () ) {
+        std::cout << "Unknown index profile " << index_profile_ << "\n";
+        return 1;
+      }
+    } else {
+      args . push_back ( arg );
+    }
+  }
+  if ( args . size () < 2 ) return 1;
+  network_spec_filename_ = args[0];
+  database_filename_ = args[1];
 
   // Load the network file and initialize the parameter graph
   network_ . load ( network_spec_filename_ );
   pg_ . assign ( network_ );
   std::cout << "Parameter Graph size = " << pg_ . size () << "\n";
 
-  if ( argc == 3 ) {
+  if ( args . size () == 2 ) {
     start_job_ = 0;
     end_job_ = pg_ . size ();
   } else {
-    if ( argc < 5 ) { 
+    if ( args . size () < 4 ) { 
       return 1;
     }
-    start_job_ = std::stoull(argv[3]);
-    end_job_ = std::stoull(argv[4]);
+    start_job_ = std::stoull(args[2]);
+    end_job_ = std::stoull(args[3]);
   }
   return 0;
 }
@@ -48,14 +214,20 @@ void Signatures::
 initialize ( void ) {
   // Open the database
   db_ = database ( database_filename_ );
+  if ( bulk_load_ ) db_ . bulk_load ( wal_ );
 
   // Create an SQLite database
   db_ . exec ( "create table if not exists Signatures (ParameterIndex INTEGER PRIMARY KEY, MorseGraphIndex INTEGER);" );
-  //db_ . exec ( "create table if not exists MorseGraphSHA (MorseGraphIndex INTEGER PRIMARY KEY, SHA TEXT);" );
-  db_ . exec ( "create table if not exists MorseGraphViz (MorseGraphIndex INTEGER PRIMARY KEY, Graphviz TEXT);" );
-  db_ . exec ( "create table if not exists MorseGraphVertices (MorseGraphIndex INTEGER, Vertex INTEGER);" );
-  db_ . exec ( "create table if not exists MorseGraphEdges (MorseGraphIndex INTEGER, Source INTEGER, Target INTEGER);" );
-  db_ . exec ( "create table if not exists MorseGraphAnnotations (MorseGraphIndex INTEGER, Vertex INTEGER, Label TEXT);" );
+  db_ . exec ( features_schema );
+  if ( compact_ ) {
+    for ( std::string const& sql_expr : compact_schema ) db_ . exec ( sql_expr );
+  } else {
+    //db_ . exec ( "create table if not exists MorseGraphSHA (MorseGraphIndex INTEGER PRIMARY KEY, SHA TEXT);" );
+    db_ . exec ( "create table if not exists MorseGraphViz (MorseGraphIndex INTEGER PRIMARY KEY, Graphviz TEXT);" );
+    db_ . exec ( "create table if not exists MorseGraphVertices (MorseGraphIndex INTEGER, Vertex INTEGER);" );
+    db_ . exec ( "create table if not exists MorseGraphEdges (MorseGraphIndex INTEGER, Source INTEGER, Target INTEGER);" );
+    db_ . exec ( "create table if not exists MorseGraphAnnotations (MorseGraphIndex INTEGER, Vertex INTEGER, Label TEXT);" );
+  }
 
   // Create Network metadata
 
@@ -73,12 +245,28 @@ initialize ( void ) {
 
 void Signatures::mainloop ( void ) {
 
-  // Prepare statements
-  statement InsertIntoMorseGraphViz = db_ . prepare ( "insert into MorseGraphViz (MorseGraphIndex, Graphviz) values (?, ?);" );
-  statement InsertIntoMorseGraphVertices = db_ . prepare ( "insert into MorseGraphVertices (MorseGraphIndex, Vertex) values (?, ?);" );
-  statement InsertIntoMorseGraphEdges = db_ . prepare ( "insert into MorseGraphEdges (MorseGraphIndex, Source, Target) values (?, ?, ?);" );
-  statement InsertIntoMorseGraphAnnotations = db_ . prepare ( "insert into MorseGraphAnnotations (MorseGraphIndex, Vertex, Label) values (?, ?, ?);" );
-  statement InsertIntoSignatures = db_ . prepare ( "insert into Signatures (ParameterIndex, MorseGraphIndex) values (?, ?);" );
+  // Prepare batched insertions
+  std::unique_ptr<batch<uint64_t, std::string>> InsertIntoMorseGraphViz;
+  std::unique_ptr<batch<uint64_t, uint64_t>> InsertIntoMorseGraphVertices;
+  std::unique_ptr<batch<uint64_t, uint64_t, uint64_t>> InsertIntoMorseGraphEdges;
+  std::unique_ptr<batch<uint64_t, uint64_t, std::string>> InsertIntoMorseGraphAnnotations;
+  std::unique_ptr<batch<uint64_t, uint64_t, blob, std::string>> InsertIntoMorseGraphs;
+  std::unique_ptr<batch<uint64_t, std::string>> InsertIntoAnnotationLabels;
+  std::unique_ptr<batch<uint64_t, uint64_t, uint64_t>> InsertIntoMorseGraphLabels;
+  batch<uint64_t, uint64_t> InsertIntoSignatures ( db_, "Signatures", {"ParameterIndex", "MorseGraphIndex"} );
+  batch<uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, std::string, std::string> 
+    InsertIntoMorseGraphFeatures ( db_, "MorseGraphFeatures", {"MorseGraphIndex", "MinimalCount", 
+      "MinimalFP", "MinimalFC", "MinimalXC", "MinimalFPCoordinates", "MinimalFCVertices"} );
+  if ( compact_ ) {
+    InsertIntoMorseGraphs . reset ( new batch<uint64_t, uint64_t, blob, std::string> ( db_, "MorseGraphs", {"MorseGraphIndex", "Vertices", "Edges", "Graphviz"} ) );
+    InsertIntoAnnotationLabels . reset ( new batch<uint64_t, std::string> ( db_, "AnnotationLabels", {"LabelIndex", "Label"} ) );
+    InsertIntoMorseGraphLabels . reset ( new batch<uint64_t, uint64_t, uint64_t> ( db_, "MorseGraphLabels", {"MorseGraphIndex", "Vertex", "LabelIndex"} ) );
+  } else {
+    InsertIntoMorseGraphViz . reset ( new batch<uint64_t, std::string> ( db_, "MorseGraphViz", {"MorseGraphIndex", "Graphviz"} ) );
+    InsertIntoMorseGraphVertices . reset ( new batch<uint64_t, uint64_t> ( db_, "MorseGraphVertices", {"MorseGraphIndex", "Vertex"} ) );
+    InsertIntoMorseGraphEdges . reset ( new batch<uint64_t, uint64_t, uint64_t> ( db_, "MorseGraphEdges", {"MorseGraphIndex", "Source", "Target"} ) );
+    InsertIntoMorseGraphAnnotations . reset ( new batch<uint64_t, uint64_t, std::string> ( db_, "MorseGraphAnnotations", {"MorseGraphIndex", "Vertex", "Label"} ) );
+  }
 
   // Begin a transaction
   db_ . exec ( "begin;" );
@@ -107,40 +295,77 @@ void Signatures::mainloop ( void ) {
     } else {
       mgi = mg_lookup_ . size ();
       mg_lookup_ [ gv ] = mgi;
-      InsertIntoMorseGraphViz . bind ( mgi, gv ) . exec ();
       uint64_t N = mg . poset () . size ();
-      for ( uint64_t v = 0; v < N; ++ v ) { 
-        InsertIntoMorseGraphVertices . bind ( mgi, v ) . exec ();
-      }
-      for ( uint64_t source = 0; source < N; ++ source ) { 
-        for ( uint64_t target : mg . poset () . children ( source ) ) {
-          InsertIntoMorseGraphEdges . bind ( mgi, source, target ) . exec ();
+      MorseGraphFeatures f = morse_graph_features ( mg );
+      InsertIntoMorseGraphFeatures . insert ( mgi, f . minimal, f . fp, f . fc, f . xc, 
+                                              f . fp_coordinates, f . fc_vertices );
+      if ( compact_ ) {
+        blob edges;
+        for ( uint64_t source = 0; source < N; ++ source ) { 
+          for ( uint64_t target : mg . poset () . children ( source ) ) {
+            compact_uint32 ( edges, source );
+            compact_uint32 ( edges, target );
+          }
         }
-      }
-      for ( uint64_t v = 0; v < N; ++ v ) { 
-        Annotation const& a = mg . annotation ( v );
-        for ( std::string const& label : a ) { 
-          InsertIntoMorseGraphAnnotations . bind ( mgi, v, label ) . exec ();
+        for ( uint64_t v = 0; v < N; ++ v ) { 
+          Annotation const& a = mg . annotation ( v );
+          for ( std::string const& label : a ) { 
+            uint64_t li;
+            if ( label_lookup_ . count ( label ) ) {
+              li = label_lookup_ [ label ];
+            } else {
+              li = label_lookup_ . size ();
+              label_lookup_ [ label ] = li;
+              InsertIntoAnnotationLabels -> insert ( li, label );
+            }
+            InsertIntoMorseGraphLabels -> insert ( mgi, v, li );
+          }
+        }
+        InsertIntoMorseGraphs -> insert ( mgi, N, edges, gv );
+      } else {
+        InsertIntoMorseGraphViz -> insert ( mgi, gv );
+        for ( uint64_t v = 0; v < N; ++ v ) { 
+          InsertIntoMorseGraphVertices -> insert ( mgi, v );
+        }
+        for ( uint64_t source = 0; source < N; ++ source ) { 
+          for ( uint64_t target : mg . poset () . children ( source ) ) {
+            InsertIntoMorseGraphEdges -> insert ( mgi, source, target );
+          }
+        }
+        for ( uint64_t v = 0; v < N; ++ v ) { 
+          Annotation const& a = mg . annotation ( v );
+          for ( std::string const& label : a ) { 
+            InsertIntoMorseGraphAnnotations -> insert ( mgi, v, label );
+          }
         }
       }
     }
     //////////////////////
     // Insert signature //
     //////////////////////
-    InsertIntoSignatures . bind ( pi, mgi ) . exec ();
+    InsertIntoSignatures . insert ( pi, mgi );
+  }
+  if ( compact_ ) {
+    InsertIntoMorseGraphs -> flush ();
+    InsertIntoAnnotationLabels -> flush ();
+    InsertIntoMorseGraphLabels -> flush ();
+    db_ . exec ( compact_positions );
+  } else {
+    InsertIntoMorseGraphViz -> flush ();
+    InsertIntoMorseGraphVertices -> flush ();
+    InsertIntoMorseGraphEdges -> flush ();
+    InsertIntoMorseGraphAnnotations -> flush ();
   }
+  InsertIntoMorseGraphFeatures . flush ();
+  InsertIntoSignatures . flush ();
   // End the transaction
   db_ . exec ( "end;" );
 }
 
 void Signatures::
 finalize ( void ) {
-  // Create the indices
-  db_ . exec ( "create index if not exists Signatures2 on Signatures (MorseGraphIndex, ParameterIndex);");
-  db_ . exec ( "create index if not exists MorseGraphAnnotations3 on MorseGraphAnnotations (Label, MorseGraphIndex);");
-  db_ . exec ( "create index if not exists MorseGraphViz2 on MorseGraphViz (Graphviz, MorseGraphIndex);");
-  db_ . exec ( "create index if not exists MorseGraphVertices1 on MorseGraphVertices (MorseGraphIndex, Vertex);");
-  db_ . exec ( "create index if not exists MorseGraphVertices2 on MorseGraphVertices (Vertex, MorseGraphIndex);");
-  db_ . exec ( "create index if not exists MorseGraphEdges1 on MorseGraphEdges (MorseGraphIndex);");
-  db_ . exec ( "create index if not exists MorseGraphAnnotations1 on MorseGraphAnnotations (MorseGraphIndex);");
+  // Create the indices (deferred until all rows are inserted)
+  for ( std::string const& sql_expr : DatabaseIndexStatements ( index_profile_, compact_ ) ) {
+    db_ . exec ( sql_expr );
+  }
 }
@@ -0,0 +1,25 @@
+#!/bin/bash
+# The views of the compact schema return exactly the rows of the legacy tables
+SRC_ROOT=$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )
+LEGACY=$SRC_ROOT/test2_legacy.db
+COMPACT=$SRC_ROOT/test2_compact.db
+for NETWORK in 2D_Example.txt 3D_Cycle.txt; do
+  rm -f $LEGACY $COMPACT
+  $SRC_ROOT/../build/bin/DSGRN-Database $SRC_ROOT/../../../networks/$NETWORK $LEGACY || exit 1
+  $SRC_ROOT/../build/bin/DSGRN-Database $SRC_ROOT/../../../networks/$NETWORK $COMPACT --compact || exit 1
+  for QUERY in \
+    "select MorseGraphIndex, Vertex from MorseGraphVertices order by 1, 2;" \
+    "select MorseGraphIndex, Source, Target from MorseGraphEdges order by 1, 2, 3;" \
+    "select MorseGraphIndex, Vertex, Label from MorseGraphAnnotations order by 1, 2, 3;" \
+    "select MorseGraphIndex, Graphviz from MorseGraphViz order by 1;" \
+    "select ParameterIndex, MorseGraphIndex from Signatures order by 1;"; do
+    X=`sqlite3 $LEGACY "$QUERY"` || exit 1
+    Y=`sqlite3 $COMPACT "$QUERY"` || exit 1
+    if [[ "$X" != "$Y" ]]; then
+      echo "$NETWORK: compact rows differ for $QUERY"
+      exit 1
+    fi
+  done
+done
+rm -f $LEGACY $COMPACT
+exit 0
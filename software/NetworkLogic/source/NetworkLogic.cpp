@@ -4,9 +4,12 @@
 #include <string>
 #include <algorithm>
 #include <sstream>
+#include <fstream>
+#include <thread>
+#include <atomic>
 
-#include "FactorGraph.h"
-#include "MonotonicMap.h"
+#include "Parameter/FactorGraph.h"
+#include "Parameter/MonotonicMap.h"
 
 //#define ESSENTIAL
 
@@ -47,7 +50,8 @@ list_components ( int N ) {
     for ( int m = 1; m < 8; ++ m ) {
       if ( n == 3 && m > 5 ) continue;
       if ( n == 4 && m > 2 ) continue;
-      if ( n == 5 && m > 1 ) continue;
+      if ( n == 5 && m > 2 ) continue;
+      if ( n == 6 && m > 1 ) continue;
       std::vector<Partition> partitions = compute_partitions ( n );
       Component c;
       for ( Partition const& logic : partitions ) {
@@ -62,27 +66,30 @@ list_components ( int N ) {
   return result;
 }
 
-FactorGraph parametergraph ( int n, int m, Partition const& logic ) {
+FactorGraph parametergraph ( int n, int m, Partition const& logic, 
+                             std::function<int64_t(void)> const& num_threads ) {
   MonotonicMap start ( n, m, logic );
   FactorGraph graph;
-  graph . construct ( start );
+  graph . construct ( start, num_threads );
   return graph;
 }
 
-void compute_code ( int n, int m, Partition const& logic ) {
+void compute_code ( int n, int m, Partition const& logic, 
+                    std::function<int64_t(void)> const& num_threads ) {
  try {
     //std::cout << n << " " << m << " " << logic << "\n";
 
-    FactorGraph graph = parametergraph ( n, m, logic );
+    FactorGraph graph = parametergraph ( n, m, logic, num_threads );
     uint64_t N = graph . size ();
     std::vector<std::string> codes;
     std::vector<std::string> essentialcodes;
 
     for ( uint64_t i = 0; i < N; ++ i ) { 
-      if ( graph . vertices [ i ] . essential () ) { 
-        essentialcodes . push_back ( graph . vertices [ i ] . hex () );
+      MonotonicMap vertex = graph . vertex ( i );
+      if ( vertex . essential () ) { 
+        essentialcodes . push_back ( vertex . hex () );
       }
-      codes . push_back ( graph . vertices [ i ] . hex () );
+      codes . push_back ( vertex . hex () );
     }
     std::sort ( codes.begin(), codes.end() );
     std::sort ( essentialcodes.begin(), essentialcodes.end() );
@@ -116,28 +123,56 @@ void compute_code ( int n, int m, Partition const& logic ) {
 
 }
 
-void compute_code ( Component const& c ) {
-  compute_code ( c.n, c.m, c.logic );
+void compute_code ( Component const& c, std::function<int64_t(void)> const& num_threads ) {
+  compute_code ( c.n, c.m, c.logic, num_threads );
 }
 
-void compute_all_codes ( int N ) {
+/// compute_all_codes
+///   Compute the components with a pool of num_threads threads, largest
+///   first. The threads of the pool which are out of components are
+///   shared among the factor graph searches still running.
+void compute_all_codes ( int N, int64_t num_threads ) {
   std::vector<Component> components = list_components ( N );
-  for ( Component const& c : components ) {
-    compute_code ( c );
-  }
+  std::stable_sort ( components.begin(), components.end(), [](Component const& a, Component const& b) {
+    return (a.m+1) * (1 << a.n) > (b.m+1) * (1 << b.n); } );
+  std::atomic<uint64_t> next ( 0 );
+  std::atomic<int64_t> running ( 0 );
+  auto share = [&] () { return std::max<int64_t> ( 1, num_threads / std::max<int64_t> ( 1, running ) ); };
+  auto work = [&] () {
+    for ( uint64_t i = next ++; i < components . size (); i = next ++ ) {
+      ++ running;
+      compute_code ( components [ i ], share );
+      -- running;
+    }
+  };
+  std::vector<std::thread> threads;
+  for ( int64_t t = 1; t < num_threads; ++ t ) threads . emplace_back ( work );
+  work ();
+  for ( auto & thread : threads ) thread . join ();
 }
 
 int main ( int argc, char * argv [] ) {
   uint64_t N = 6;
+  // Number of threads (option "--threads T", default one per core)
+  int64_t num_threads = std::max<int64_t> ( 1, std::thread::hardware_concurrency () );
+  std::vector<char *> args;
+  for ( int i = 0; i < argc; ++ i ) {
+    if ( std::string ( argv[i] ) == "--threads" && i + 1 < argc ) {
+      num_threads = std::max<int64_t> ( 1, std::stoll(argv[++i]) );
+      continue;
+    }
+    args . push_back ( argv[i] );
+  }
+  argc = args . size ();
   if ( argc == 3 ) {
     Component c;
-    c . n = std::stoll(argv[1]);
-    c . m = std::stoll(argv[2]);
+    c . n = std::stoll(args[1]);
+    c . m = std::stoll(args[2]);
     c . logic = std::vector<int64_t> ( c.n, 1 );
-    compute_code ( c );
+    compute_code ( c, [num_threads] () { return num_threads; } );
     return 0;
   }
-  if ( argc == 2 ) N = std::stoll(argv[1]);
-  compute_all_codes ( N );
+  if ( argc == 2 ) N = std::stoll(args[1]);
+  compute_all_codes ( N, num_threads );
   return 0;
 }
@@ -6,19 +6,54 @@
 #define DSGRN_NUMERICALSIMULATIONPATTERNMATCH_H
 
 #include "common.h"
+#ifndef PATTERNMATCH_NO_MPI
 #include "cluster-delegator.hpp"
+#endif
 #include "Tools/sqlambda.h"
 #include "DSGRN.h"
+#include "ThreadedExecutor.h"
+#include "SimulationSummaryFile.h"
 
-class NumericalSimulationPatternMatch : public Coordinator_Worker_Process {
+class NumericalSimulationPatternMatch
+#ifndef PATTERNMATCH_NO_MPI
+  : public Coordinator_Worker_Process
+#endif
+{
  public:
   void command_line ( int argc, char * argv [] );
+#ifndef PATTERNMATCH_NO_MPI
   void initialize ( void );
   int  prepare ( Message & job );
   void work ( Message & result, const Message & job ) const;
   void accept ( const Message &result );
   void finalize ( void ); 
+#endif
+  /// run
+  ///   Process the analysis file with a pool of threads (see ThreadedExecutor)
+  void run ( uint64_t num_threads ) const;
  private:
+  void load_patterns ( void );
+  /// matching_patterns
+  ///   Return the indices of the patterns matched by a simulation summary
+  ///   of "length" labels (0 when a single pattern is given and it matches)
+  std::vector<uint64_t> matching_patterns ( uint64_t const* labels,
+                                            uint64_t length,
+                                            PatternMatchWorkspace & workspace ) const;
+  /// matches
+  ///   Return the output lines for the analysis file line at the given
+  ///   byte offset (see output)
+  std::vector<std::string> matches ( std::string const& line,
+                                     uint64_t offset,
+                                     PatternMatchWorkspace & workspace ) const;
+  /// matches
+  ///   Return the output lines for a record of a binary analysis file
+  std::vector<std::string> matches ( uint64_t record,
+                                     PatternMatchWorkspace & workspace ) const;
+  /// output
+  ///   Return the output line for a match of pattern k: the byte offset
+  ///   of the input line or record if offsets were requested, and the
+  ///   input line otherwise, with the pattern index when several are given
+  std::string output ( uint64_t k, uint64_t offset, std::string const& line ) const;
   std::string network_spec_filename_;
   std::string pattern_spec_filename_;
   std::string input_filename_;
@@ -27,8 +62,19 @@ class NumericalSimulationPatternMatch : public Coordinator_Worker_Process {
   ParameterGraph parametergraph_;
   Pattern pattern_;
   PatternGraph patterngraph_;
+  bool multiple_;
+  std::vector<PatternGraph> patterngraphs_;
+  MultiPatternGraph multipatterngraph_;
+  LinearPathMatcher matcher_;
+  bool binary_;
+  bool offsets_;
+  std::shared_ptr<SimulationSummaryFile> summaries_;
+#ifndef PATTERNMATCH_NO_MPI
   std::ifstream input_file_;
   std::ofstream output_file_;
   uint64_t jobs_submitted_;
+  uint64_t input_offset_;
+  uint64_t next_record_;
+#endif
 };
 #endif
@@ -0,0 +1,55 @@
+/// ParameterAnalysisCache.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#ifndef DSGRN_PARAMETERANALYSISCACHE_H
+#define DSGRN_PARAMETERANALYSISCACHE_H
+
+#include "common.h"
+#include "DSGRN.h"
+
+#include <list>
+
+/// ParameterAnalysisCache
+///   Least recently used cache of the domain graph and Morse
+///   decomposition of recently analysed parameters. Input files
+///   list a parameter once per Morse set of interest, so a worker
+///   keeps the last few analyses around instead of recomputing
+///   the strong components and Morse poset for each Morse set.
+class ParameterAnalysisCache {
+public:
+  typedef std::pair<DomainGraph, MorseDecomposition> Analysis;
+
+  /// ParameterAnalysisCache
+  ///   Keep at most "capacity" analyses
+  ParameterAnalysisCache ( uint64_t capacity = 16 ) : capacity_ ( capacity ) {}
+
+  /// analysis
+  ///   Return the domain graph and Morse decomposition of the
+  ///   parameter with the given index, computing them if absent
+  Analysis const&
+  analysis ( ParameterGraph const& parametergraph, uint64_t parameter_index ) {
+    auto it = index_ . find ( parameter_index );
+    if ( it != index_ . end () ) {
+      // Move the entry to the front of the recency list
+      entries_ . splice ( entries_ . begin (), entries_, it -> second );
+      return entries_ . front () . second;
+    }
+    DomainGraph domaingraph ( parametergraph . parameter ( parameter_index ) );
+    MorseDecomposition morsedecomposition ( domaingraph . digraph () );
+    entries_ . push_front ( { parameter_index, { domaingraph, morsedecomposition } } );
+    index_ [ parameter_index ] = entries_ . begin ();
+    if ( entries_ . size () > capacity_ ) {
+      index_ . erase ( entries_ . back () . first );
+      entries_ . pop_back ();
+    }
+    return entries_ . front () . second;
+  }
+
+private:
+  uint64_t capacity_;
+  std::list<std::pair<uint64_t, Analysis>> entries_;
+  std::unordered_map<uint64_t, std::list<std::pair<uint64_t, Analysis>>::iterator> index_;
+};
+
+#endif
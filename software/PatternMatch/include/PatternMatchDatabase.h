@@ -6,19 +6,43 @@
 #define DSGRN_PATTERNMATCHDATABASE_H
 
 #include "common.h"
+#ifndef PATTERNMATCH_NO_MPI
 #include "cluster-delegator.hpp"
+#endif
 #include "Tools/sqlambda.h"
 #include "DSGRN.h"
+#include "ParameterAnalysisCache.h"
+#include "ThreadedExecutor.h"
 
-class PatternMatchDatabase : public Coordinator_Worker_Process {
+class PatternMatchDatabase
+#ifndef PATTERNMATCH_NO_MPI
+  : public Coordinator_Worker_Process
+#endif
+{
  public:
   void command_line ( int argc, char * argv [] );
+#ifndef PATTERNMATCH_NO_MPI
   void initialize ( void );
   int  prepare ( Message & job );
   void work ( Message & result, const Message & job ) const;
   void accept ( const Message &result );
   void finalize ( void ); 
+#endif
+  /// run
+  ///   Process the analysis file with a pool of threads (see ThreadedExecutor)
+  void run ( uint64_t num_threads ) const;
  private:
+  void load_patterns ( void );
+  /// read_grouped_jobs
+  ///   Return the pairs of the analysis file, stably sorted by parameter
+  std::vector<std::pair<uint64_t,uint64_t>> read_grouped_jobs ( void ) const;
+  /// matches
+  ///   Return the indices of the patterns matched by a Morse set
+  ///   (0 when a single pattern is given and it matches)
+  std::vector<uint64_t> matches ( uint64_t parameter_index, 
+                                  uint64_t morse_set_index,
+                                  PatternMatchWorkspace & workspace,
+                                  ParameterAnalysisCache & cache ) const;
   std::string network_spec_filename_;
   std::string pattern_spec_filename_;
   std::string input_filename_;
@@ -27,8 +51,17 @@ class PatternMatchDatabase : public Coordinator_Worker_Process {
   ParameterGraph parametergraph_;
   Pattern pattern_;
   PatternGraph patterngraph_;
+  bool multiple_;
+  std::vector<PatternGraph> patterngraphs_;
+  MultiPatternGraph multipatterngraph_;
+  bool group_by_parameter_;
+#ifndef PATTERNMATCH_NO_MPI
   std::ifstream input_file_;
   std::ofstream output_file_;
   uint64_t jobs_submitted_;
+  std::vector<std::pair<uint64_t,uint64_t>> grouped_jobs_;
+  uint64_t next_job_;
+  mutable ParameterAnalysisCache cache_;
+#endif
 };
 #endif
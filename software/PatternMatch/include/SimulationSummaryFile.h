@@ -0,0 +1,186 @@
+/// SimulationSummaryFile.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#ifndef DSGRN_SIMULATIONSUMMARYFILE_H
+#define DSGRN_SIMULATIONSUMMARYFILE_H
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "ThreadedExecutor.h"
+
+/// Binary simulation summary format
+///   A compact alternative to the JSON lines
+///     {"ParameterIndex":...,"SimulationSummary":[...],...}
+///   read by NumericalSimulationPatternMatch. The file is the 8 byte
+///   magic string "DSGRNSS1" followed by one record per simulation:
+///     uint64 parameter index
+///     uint64 number of labels n
+///     uint64 labels [ n ]
+///   in native byte order. Every field is a uint64, so the labels of a
+///   memory-mapped file can be used in place without parsing.
+static char const SimulationSummaryMagic [ 8 ] = { 'D', 'S', 'G', 'R', 'N', 'S', 'S', '1' };
+
+/// SimulationSummaryWriter
+///   Write simulation summaries in the binary format
+class SimulationSummaryWriter {
+public:
+  SimulationSummaryWriter ( std::string const& filename ) : filename_ ( filename ), file_ ( filename, std::ios::binary ) {
+    if ( not file_ . good () ) throw std::runtime_error ( "Could not open " + filename );
+    file_ . write ( SimulationSummaryMagic, sizeof(SimulationSummaryMagic) );
+    check ();
+  }
+
+  /// write
+  ///   Append the record of a simulation. Throws if the file cannot be written.
+  void
+  write ( uint64_t parameter_index, std::vector<uint64_t> const& labels ) {
+    uint64_t length = labels . size ();
+    file_ . write ( reinterpret_cast<char const*> ( &parameter_index ), sizeof(uint64_t) );
+    file_ . write ( reinterpret_cast<char const*> ( &length ), sizeof(uint64_t) );
+    file_ . write ( reinterpret_cast<char const*> ( labels . data () ), length * sizeof(uint64_t) );
+    check ();
+  }
+
+  /// close
+  ///   Flush and close the file. Throws if it cannot be written.
+  void
+  close ( void ) {
+    file_ . close ();
+    check ();
+  }
+
+private:
+  void
+  check ( void ) const {
+    if ( not file_ ) throw std::runtime_error ( "Could not write to " + filename_ );
+  }
+
+  std::string filename_;
+  std::ofstream file_;
+};
+
+/// SimulationSummaryConvert
+///   Convert the JSON lines {"ParameterIndex":...,"SimulationSummary":[...],...}
+///   of input_filename to the binary format in output_filename and return
+///   the number of records. Throws std::runtime_error naming the line of
+///   a malformed record, or if the output file cannot be written.
+inline uint64_t
+SimulationSummaryConvert ( std::string const& input_filename, std::string const& output_filename ) {
+  std::ifstream input_file ( input_filename );
+  if ( not input_file . good () ) throw std::runtime_error ( "Problem loading analysis file " + input_filename );
+  SimulationSummaryWriter writer ( output_filename );
+  uint64_t records = 0;
+  uint64_t line_number = 0;
+  std::string line;
+  std::vector<uint64_t> labels;
+  while ( std::getline ( input_file, line ) ) {
+    ++ line_number;
+    if ( line . empty () ) continue;
+    uint64_t parameter_index;
+    try {
+      json const j = json::parse ( line );
+      parameter_index = j . at ( "ParameterIndex" );
+      labels . clear ();
+      for ( uint64_t label : j . at ( "SimulationSummary" ) ) labels . push_back ( label );
+    } catch ( std::logic_error const& e ) {
+      throw std::runtime_error ( input_filename + ":" + std::to_string ( line_number ) + ": " + e . what () );
+    }
+    writer . write ( parameter_index, labels );
+    ++ records;
+  }
+  if ( input_file . bad () ) throw std::runtime_error ( "Could not read " + input_filename );
+  writer . close ();
+  return records;
+}
+
+class SimulationSummaryFile {
+public:
+  /// is_binary
+  ///   Return true if the file starts with the binary format magic string
+  static bool
+  is_binary ( std::string const& filename ) {
+    std::ifstream file ( filename, std::ios::binary );
+    char magic [ sizeof(SimulationSummaryMagic) ];
+    if ( not file . read ( magic, sizeof(magic) ) ) return false;
+    return std::memcmp ( magic, SimulationSummaryMagic, sizeof(magic) ) == 0;
+  }
+
+  SimulationSummaryFile ( std::string const& filename ) : file_ ( filename ) {
+    if ( file_ . size () < sizeof(SimulationSummaryMagic) ||
+         std::memcmp ( file_ . data (), SimulationSummaryMagic, sizeof(SimulationSummaryMagic) ) != 0 ) {
+      throw std::runtime_error ( filename + " is not a binary simulation summary file" );
+    }
+    if ( file_ . size () % sizeof(uint64_t) != 0 ) {
+      throw std::runtime_error ( filename + " is truncated" );
+    }
+    uint64_t const* words = reinterpret_cast<uint64_t const*> ( file_ . data () );
+    uint64_t num_words = file_ . size () / sizeof(uint64_t);
+    uint64_t position = 1;
+    while ( position < num_words ) {
+      if ( position + 2 > num_words || words [ position + 1 ] > num_words - position - 2 ) {
+        throw std::runtime_error ( filename + " is truncated" );
+      }
+      offsets_ . push_back ( position );
+      position += 2 + words [ position + 1 ];
+    }
+  }
+
+  /// size
+  ///   Return the number of records
+  uint64_t
+  size ( void ) const {
+    return offsets_ . size ();
+  }
+
+  /// offset
+  ///   Return the byte offset of record i in the file
+  uint64_t
+  offset ( uint64_t i ) const {
+    return offsets_ [ i ] * sizeof(uint64_t);
+  }
+
+  /// parameter_index
+  ///   Return the parameter index of record i
+  uint64_t
+  parameter_index ( uint64_t i ) const {
+    return words () [ offsets_ [ i ] ];
+  }
+
+  /// length
+  ///   Return the number of labels of record i
+  uint64_t
+  length ( uint64_t i ) const {
+    return words () [ offsets_ [ i ] + 1 ];
+  }
+
+  /// labels
+  ///   Return a pointer to the length(i) labels of record i
+  uint64_t const*
+  labels ( uint64_t i ) const {
+    return words () + offsets_ [ i ] + 2;
+  }
+
+  /// summary
+  ///   Return a copy of the labels of record i
+  std::vector<uint64_t>
+  summary ( uint64_t i ) const {
+    return std::vector<uint64_t> ( labels ( i ), labels ( i ) + length ( i ) );
+  }
+
+private:
+  uint64_t const*
+  words ( void ) const {
+    return reinterpret_cast<uint64_t const*> ( file_ . data () );
+  }
+
+  MappedFile file_;
+  std::vector<uint64_t> offsets_;
+};
+
+#endif
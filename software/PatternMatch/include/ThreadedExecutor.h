@@ -0,0 +1,203 @@
+/// ThreadedExecutor.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#ifndef DSGRN_THREADEDEXECUTOR_H
+#define DSGRN_THREADEDEXECUTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// MappedFile
+///   Read-only memory mapping of a file
+class MappedFile {
+public:
+  MappedFile ( std::string const& filename ) : data_ ( nullptr ), size_ ( 0 ) {
+    int fd = open ( filename . c_str (), O_RDONLY );
+    if ( fd < 0 ) throw std::runtime_error ( "Could not open " + filename );
+    struct stat st;
+    if ( fstat ( fd, &st ) != 0 ) {
+      close ( fd );
+      throw std::runtime_error ( "Could not stat " + filename );
+    }
+    size_ = st . st_size;
+    if ( size_ > 0 ) {
+      void * data = mmap ( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( data == MAP_FAILED ) {
+        close ( fd );
+        throw std::runtime_error ( "Could not map " + filename );
+      }
+      data_ = static_cast<char const*> ( data );
+    }
+    close ( fd );
+  }
+
+  ~MappedFile ( void ) {
+    if ( data_ ) munmap ( const_cast<char*> ( data_ ), size_ );
+  }
+
+  MappedFile ( MappedFile const& ) = delete;
+  MappedFile & operator = ( MappedFile const& ) = delete;
+
+  char const* data ( void ) const { return data_; }
+  uint64_t size ( void ) const { return size_; }
+
+private:
+  char const* data_;
+  uint64_t size_;
+};
+
+/// line_boundaries
+///   Return the (offset, length) of each non-empty line of a mapped file
+inline std::vector<std::pair<uint64_t,uint64_t>>
+line_boundaries ( MappedFile const& file ) {
+  std::vector<std::pair<uint64_t,uint64_t>> result;
+  char const* begin = file . data ();
+  char const* end = begin + file . size ();
+  char const* position = begin;
+  while ( position < end ) {
+    char const* newline = static_cast<char const*> ( std::memchr ( position, '\n', end - position ) );
+    char const* stop = newline ? newline : end;
+    if ( stop > position ) result . push_back ( { position - begin, stop - position } );
+    position = stop + 1;
+  }
+  return result;
+}
+
+/// threads_option
+///   Return true if "--threads N" is given among the options following
+///   the four positional arguments (or MPI is not compiled in), setting
+///   num_threads to N (0, for one thread per core, by default)
+inline bool
+threads_option ( int argc, char * argv [], uint64_t & num_threads ) {
+  num_threads = 0;
+  bool threaded = false;
+#ifdef PATTERNMATCH_NO_MPI
+  threaded = true;
+#endif
+  for ( int i = 5; i + 1 < argc; ++ i ) {
+    if ( std::string(argv[i]) == "--threads" ) {
+      threaded = true;
+      num_threads = std::stoull ( argv[i+1] );
+    }
+  }
+  return threaded;
+}
+
+/// ThreadedExecutor
+///   Shared-memory alternative to the cluster-delegator
+///   Coordinator_Worker_Process: items are processed by a pool of
+///   threads in cohorts, cohort c holding the items cohort_begin[c],
+///   ..., cohort_begin[c+1]-1. Cohorts are handed out through an
+///   atomic counter; each cohort writes to its own output buffer,
+///   which only the thread processing it touches until the cohort is
+///   complete. Completed cohorts are then written to the output file
+///   in cohort order as soon as all earlier cohorts are written, and
+///   their buffers freed, so only the cohorts ahead of the slowest one
+///   are held in memory.
+///
+///   State is default constructed once per thread (e.g. a pattern
+///   match workspace) and process is called as
+///     process ( state, item, output )
+///   with the output buffer of the cohort of the item. If process
+///   throws, or the output file cannot be opened or written, the
+///   remaining cohorts are abandoned (the file then holds the cohorts
+///   written so far) and the first exception is rethrown once all
+///   threads are joined.
+template < typename State, typename Process > void
+ThreadedExecutor ( std::vector<uint64_t> const& cohort_begin,
+                   std::string const& output_filename,
+                   uint64_t num_threads,
+                   Process const& process ) {
+  uint64_t num_cohorts = cohort_begin . empty () ? 0 : cohort_begin . size () - 1;
+  std::ofstream output_file ( output_filename );
+  if ( not output_file ) throw std::runtime_error ( "Could not open " + output_filename );
+  std::vector<std::string> outputs ( num_cohorts );
+  std::vector<bool> complete ( num_cohorts, false );
+  uint64_t written = 0;
+  std::mutex output_mutex;
+  if ( num_threads == 0 ) num_threads = std::max<uint64_t> ( 1, std::thread::hardware_concurrency () );
+  std::atomic<uint64_t> next ( 0 );
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&]() {
+    try {
+      State state;
+      while ( true ) {
+        uint64_t cohort = next . fetch_add ( 1 );
+        if ( cohort >= num_cohorts ) break;
+        for ( uint64_t i = cohort_begin [ cohort ]; i < cohort_begin [ cohort + 1 ]; ++ i ) {
+          process ( state, i, outputs [ cohort ] );
+        }
+        // Write out the completed cohorts which follow those already written
+        std::lock_guard<std::mutex> lock ( output_mutex );
+        complete [ cohort ] = true;
+        while ( written < num_cohorts && complete [ written ] ) {
+          output_file << outputs [ written ];
+          std::string () . swap ( outputs [ written ] );
+          ++ written;
+        }
+        if ( not output_file ) throw std::runtime_error ( "Could not write to " + output_filename );
+      }
+    } catch ( ... ) {
+      std::lock_guard<std::mutex> lock ( error_mutex );
+      if ( not error ) error = std::current_exception ();
+      next . store ( num_cohorts );
+    }
+  };
+  std::vector<std::thread> threads;
+  for ( uint64_t i = 1; i < num_threads; ++ i ) threads . emplace_back ( worker );
+  worker ();
+  for ( auto & thread : threads ) thread . join ();
+  if ( error ) std::rethrow_exception ( error );
+  output_file . close ();
+  if ( not output_file ) throw std::runtime_error ( "Could not write to " + output_filename );
+}
+
+/// ThreadedExecutor
+///   Process items 0, 1, ..., num_items-1 in cohorts of cohort_size
+///   items, as above
+template < typename State, typename Process > void
+ThreadedExecutor ( uint64_t num_items,
+                   std::string const& output_filename,
+                   uint64_t num_threads,
+                   uint64_t cohort_size,
+                   Process const& process ) {
+  std::vector<uint64_t> cohort_begin;
+  for ( uint64_t i = 0; i < num_items; i += cohort_size ) cohort_begin . push_back ( i );
+  cohort_begin . push_back ( num_items );
+  ThreadedExecutor<State> ( cohort_begin, output_filename, num_threads, process );
+}
+
+/// ThreadedExecutor
+///   Process the lines of a memory-mapped input file, calling
+///     process ( state, line, output )
+///   with each non-empty line (without its newline)
+template < typename State, typename Process > void
+ThreadedExecutor ( std::string const& input_filename,
+                   std::string const& output_filename,
+                   uint64_t num_threads,
+                   uint64_t cohort_size,
+                   Process const& process ) {
+  MappedFile input ( input_filename );
+  auto lines = line_boundaries ( input );
+  ThreadedExecutor<State> ( lines . size (), output_filename, num_threads, cohort_size,
+    [&](State & state, uint64_t i, std::string & output) {
+      process ( state, std::string ( input . data () + lines [ i ] . first, lines [ i ] . second ), output );
+    } );
+}
+
+#endif
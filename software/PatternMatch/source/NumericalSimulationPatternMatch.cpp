@@ -11,19 +11,42 @@ using namespace sqlite;
 std::string help_string = 
   "Please supply the following arguments:\n" 
   " --> network specification file \n"
-  " --> pattern specification file \n"
+  " --> pattern specification file (a pattern object, or a JSON array of them)\n"
   " --> analysis file: contains on each line a JSON string encoding an object\n"
   "                    {\"ParameterIndex\":...,\"SimulationSummary\":[...],...any other fields...}\n"
-  " --> output file (into which will be stored lines from analysis file which match pattern)\n";
+  "                    or is a binary file written by SimulationSummaryConvert\n"
+  " --> output file (into which will be stored lines from analysis file which match pattern;\n"
+  "                  when several patterns are given, each line is prefixed by the index\n"
+  "                  of the matching pattern)\n"
+  " --> (optional) --offsets: store the byte offset in the analysis file of each\n"
+  "                  matching line or record instead of the line itself (followed by\n"
+  "                  the index of the matching pattern when several are given)\n"
+  " --> (optional) --threads N: run on this machine with N threads (0 for one\n"
+  "                  per core) instead of MPI; the output keeps the input order\n";
 
 int main ( int argc, char * argv [] ) {
-  if ( argc < 3 ) {
+  if ( argc < 5 ) {
     std::cout << help_string;
     return 1;
   }
+  // Run with threads on this machine
+  uint64_t num_threads;
+  if ( threads_option ( argc, argv, num_threads ) ) {
+    try {
+      NumericalSimulationPatternMatch process;
+      process . command_line ( argc, argv );
+      process . run ( num_threads );
+    } catch ( std::exception const& e ) {
+      std::cerr << e . what () << "\n";
+      return 1;
+    }
+    return 0;
+  }
+#ifndef PATTERNMATCH_NO_MPI
   delegator::Start ();
   delegator::Run < NumericalSimulationPatternMatch > (argc, argv);
   delegator::Stop ();
+#endif
   return 0;
 }
 
@@ -33,35 +56,176 @@ command_line ( int argc, char * argv [] ) {
   pattern_spec_filename_ = argv[2];
   input_filename_ = argv[3];
   output_filename_ = argv[4];
+  offsets_ = false;
+  for ( int i = 5; i < argc; ++ i ) {
+    if ( std::string(argv[i]) == "--offsets" ) offsets_ = true;
+  }
+  // Binary analysis files are memory-mapped by every process
+  binary_ = SimulationSummaryFile::is_binary ( input_filename_ );
+  if ( binary_ ) summaries_ . reset ( new SimulationSummaryFile ( input_filename_ ) );
   // Load the network file and initialize the parameter graph
   network_ . load ( network_spec_filename_ );
-  pattern_ . load ( pattern_spec_filename_ );
-  patterngraph_ . assign ( pattern_ );
+  load_patterns ();
   parametergraph_ . assign ( network_ );
   std::cout << "Parameter Graph size = " << parametergraph_ . size () << "\n";
 }
 
+void NumericalSimulationPatternMatch::
+load_patterns ( void ) {
+  // A pattern specification file holds either a single pattern object
+  // or a JSON array of them; several patterns are merged so that each
+  // search graph is built and traversed once for all of them
+  std::ifstream infile ( pattern_spec_filename_ );
+  if ( not infile . good () ) {
+    throw std::runtime_error ( "Problem loading pattern specification file " + pattern_spec_filename_ );
+  }
+  std::stringstream buffer;
+  buffer << infile.rdbuf();
+  json spec = json::parse ( buffer . str () );
+  multiple_ = spec . is_array ();
+  if ( multiple_ ) {
+    for ( auto const& item : spec ) {
+      Pattern pattern;
+      pattern . parse ( item . dump () );
+      patterngraphs_ . push_back ( PatternGraph ( pattern ) );
+    }
+    multipatterngraph_ . assign ( patterngraphs_ );
+    matcher_ . assign ( multipatterngraph_ );
+    std::cout << "Merged " << patterngraphs_ . size () << " patterns.\n";
+  } else {
+    pattern_ . parse ( buffer . str () );
+    patterngraph_ . assign ( pattern_ );
+    matcher_ . assign ( patterngraph_ );
+  }
+}
+
+std::vector<uint64_t> NumericalSimulationPatternMatch::
+matching_patterns ( uint64_t const* labels,
+                    uint64_t length,
+                    PatternMatchWorkspace & workspace ) const {
+  // The search graph of a simulation summary is a chain, so the patterns
+  // are run over the labels directly (see LinearPathMatcher) rather than
+  // building a SearchGraph and searching its matching graph
+  std::vector<uint64_t> result;
+  std::vector<bool> matched = matcher_ . matches ( labels, length, workspace );
+  for ( uint64_t k = 0; k < matched . size (); ++ k ) {
+    if ( matched [ k ] ) result . push_back ( k );
+  }
+  return result;
+}
+
+std::string NumericalSimulationPatternMatch::
+output ( uint64_t k, uint64_t offset, std::string const& line ) const {
+  if ( offsets_ ) {
+    return multiple_ ? std::to_string ( offset ) + " " + std::to_string ( k ) : std::to_string ( offset );
+  }
+  // Prefix the line with the index of each matching pattern
+  return multiple_ ? std::to_string ( k ) + " " + line : line;
+}
+
+std::vector<std::string> NumericalSimulationPatternMatch::
+matches ( std::string const& line,
+          uint64_t offset,
+          PatternMatchWorkspace & workspace ) const {
+  std::vector<std::string> result;
+  json j = json::parse(line);
+  std::vector<uint64_t> labels;
+  for ( uint64_t label : j["SimulationSummary"] ) labels . push_back ( label );
+  for ( uint64_t k : matching_patterns ( labels . data (), labels . size (), workspace ) ) {
+    result . push_back ( output ( k, offset, line ) );
+  }
+  return result;
+}
+
+std::vector<std::string> NumericalSimulationPatternMatch::
+matches ( uint64_t record,
+          PatternMatchWorkspace & workspace ) const {
+  std::vector<std::string> result;
+  // The labels are matched in place in the mapped file
+  std::vector<uint64_t> patterns = matching_patterns ( summaries_ -> labels ( record ),
+                                                       summaries_ -> length ( record ),
+                                                       workspace );
+  if ( patterns . empty () ) return result;
+  // Write matching records back as JSON lines unless offsets were requested
+  std::string line;
+  if ( not offsets_ ) {
+    json j;
+    j["ParameterIndex"] = summaries_ -> parameter_index ( record );
+    j["SimulationSummary"] = summaries_ -> summary ( record );
+    line = j . dump ();
+  }
+  for ( uint64_t k : patterns ) {
+    result . push_back ( output ( k, summaries_ -> offset ( record ), line ) );
+  }
+  return result;
+}
+
+void NumericalSimulationPatternMatch::
+run ( uint64_t num_threads ) const {
+  struct State {
+    PatternMatchWorkspace workspace;
+  };
+  if ( binary_ ) {
+    ThreadedExecutor<State> ( summaries_ -> size (), output_filename_, num_threads, COHORT_SIZE,
+      [&](State & state, uint64_t record, std::string & output) {
+        for ( auto const& matched : matches ( record, state . workspace ) ) {
+          output += matched + "\n";
+        }
+      } );
+  } else {
+    MappedFile input ( input_filename_ );
+    auto lines = line_boundaries ( input );
+    ThreadedExecutor<State> ( lines . size (), output_filename_, num_threads, COHORT_SIZE,
+      [&](State & state, uint64_t i, std::string & output) {
+        std::string line ( input . data () + lines [ i ] . first, lines [ i ] . second );
+        for ( auto const& matched : matches ( line, lines [ i ] . first, state . workspace ) ) {
+          output += matched + "\n";
+        }
+      } );
+  }
+  std::cout << "Finished.\n";
+}
+
+#ifndef PATTERNMATCH_NO_MPI
 void NumericalSimulationPatternMatch::
 initialize ( void ) {
   // Initialize input and output streams
   input_file_ . open ( input_filename_ );
   output_file_ . open ( output_filename_ );
   jobs_submitted_ = 0;
+  input_offset_ = 0;
+  next_record_ = 0;
 }
 
 int NumericalSimulationPatternMatch::
 prepare ( Message & job ) {
   // Prepare a job
-  //   The job is a list of parameter index, morse set index pairs
+  //   The job is a list of analysis file lines, with the byte offset
+  //   of the first one, or for a binary analysis file a range of
+  //   records, which the workers read from their own mapping
   //   (They are submitted in groups rather than one at a time to
   //    reduce communication overhead)
+  if ( binary_ ) {
+    uint64_t first = next_record_;
+    uint64_t last = std::min<uint64_t> ( summaries_ -> size (), first + COHORT_SIZE );
+    if ( first == last ) return 1; // All done!
+    job << first;
+    job << last;
+    next_record_ = last;
+    jobs_submitted_ += last - first;
+    std::cout << "Submitted " << jobs_submitted_ << " jobs so far.\n";
+    return 0; // Job sent!
+  }
   std::vector<std::string> job_cohort;
+  uint64_t offset = input_offset_;
   while ( job_cohort . size () < COHORT_SIZE ) {
     std::string line;
     if ( not std::getline(input_file_, line) ) break;
+    input_offset_ += line . size () + 1;
     job_cohort . push_back ( line );
   }
   if ( job_cohort . empty () ) return 1; // All done!
+  job << offset;
   job << job_cohort;
   jobs_submitted_ += job_cohort . size ();
   std::cout << "Submitted " << jobs_submitted_ << " jobs so far.\n";
@@ -70,19 +234,28 @@ prepare ( Message & job ) {
 
 void NumericalSimulationPatternMatch::
 work ( Message & result, const Message & job ) const {
+  std::vector<std::string> result_data;
+  PatternMatchWorkspace workspace;
+  if ( binary_ ) {
+    uint64_t first;
+    uint64_t last;
+    job >> first;
+    job >> last;
+    for ( uint64_t record = first; record < last; ++ record ) {
+      for ( auto const& matched : matches ( record, workspace ) ) result_data . push_back ( matched );
+    }
+    result << result_data;
+    return;
+  }
+  uint64_t offset;
   std::vector<std::string> job_cohort;
+  job >> offset;
   job >> job_cohort;
-  std::vector<std::string> result_data;
-  // Loop through (parameter_index, morse_set_index) pairs and 
-  // filter out those for which there is no match
+  // Loop through the lines and filter out those for which there is no match
   for ( auto const& line : job_cohort ) {
     //std::cout << "Processing " << line << "\n";
-    json j = json::parse(line);
-    std::vector<uint64_t> labels;
-    for ( uint64_t label : j["SimulationSummary"] ) labels . push_back ( label );
-    SearchGraph searchgraph ( labels, network_ . size () );
-    MatchingGraph matchinggraph ( searchgraph, patterngraph_ );
-    if ( QueryPathMatch ( matchinggraph ) ) result_data . push_back ( line );
+    for ( auto const& matched : matches ( line, offset, workspace ) ) result_data . push_back ( matched );
+    offset += line . size () + 1;
   }
   result << result_data;
 }
@@ -102,3 +275,4 @@ finalize ( void ) {
   output_file_ . close ();
   std::cout << "Finished.\n";
 }
+#endif
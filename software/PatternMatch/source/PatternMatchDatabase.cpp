@@ -11,17 +11,26 @@ using namespace sqlite;
 std::string help_string = 
   "Please supply the following arguments:\n" 
   " --> network specification file \n"
-  " --> pattern specification file \n"
+  " --> pattern specification file (a pattern object, or a JSON array of them)\n"
   " --> analysis file: contains on each line parameter node index, morse set index, e.g.\n"
   "                    12 3\n"
   "                    12 4\n"
   "                    288 1\n"
   "                    ...\n"
-  " --> output file \n";
+  " --> output file: the matching lines of the analysis file; when several\n"
+  "                  patterns are given, each matching line is followed by\n"
+  "                  the index of the matching pattern, e.g. \"12 3 0\"\n"
+  " --> (optional) --group-by-parameter: read the whole analysis file and\n"
+  "                  send all Morse sets of a parameter in the same MPI job (or\n"
+  "                  thread cohort), so each parameter is analysed once; the\n"
+  "                  output is then ordered by parameter\n"
+  " --> (optional) --threads N: run on this machine with N threads (0 for one\n"
+  "                  per core) instead of MPI; the output keeps the input order\n"
+  "                  unless --group-by-parameter is given\n";
 
 int main ( int argc, char * argv [] ) {
   // Check for proper number of files
-  if ( argc < 3 ) {
+  if ( argc < 5 ) {
     std::cerr << help_string;
     return 1;
   }
@@ -42,10 +51,26 @@ int main ( int argc, char * argv [] ) {
     return 1;
   }
 
+  // Run with threads on this machine
+  uint64_t num_threads;
+  if ( threads_option ( argc, argv, num_threads ) ) {
+    try {
+      PatternMatchDatabase process;
+      process . command_line ( argc, argv );
+      process . run ( num_threads );
+    } catch ( std::exception const& e ) {
+      std::cerr << e . what () << "\n";
+      return 1;
+    }
+    return 0;
+  }
+
+#ifndef PATTERNMATCH_NO_MPI
   // Start MPI process
   delegator::Start ();
   delegator::Run < PatternMatchDatabase > (argc, argv);
   delegator::Stop ();
+#endif
   return 0;
 }
 
@@ -55,20 +80,131 @@ command_line ( int argc, char * argv [] ) {
   pattern_spec_filename_ = argv[2];
   input_filename_ = argv[3];
   output_filename_ = argv[4];
+  group_by_parameter_ = false;
+  for ( int i = 5; i < argc; ++ i ) {
+    if ( std::string(argv[i]) == "--group-by-parameter" ) group_by_parameter_ = true;
+  }
   // Load the network file and initialize the parameter graph
   network_ . load ( network_spec_filename_ );
-  pattern_ . load ( pattern_spec_filename_ );
-  patterngraph_ . assign ( pattern_ );
+  load_patterns ();
   parametergraph_ . assign ( network_ );
   std::cout << "Parameter Graph size = " << parametergraph_ . size () << "\n";
 }
 
+void PatternMatchDatabase::
+load_patterns ( void ) {
+  // A pattern specification file holds either a single pattern object
+  // or a JSON array of them; several patterns are merged so that each
+  // search graph is built and traversed once for all of them
+  std::ifstream infile ( pattern_spec_filename_ );
+  if ( not infile . good () ) {
+    throw std::runtime_error ( "Problem loading pattern specification file " + pattern_spec_filename_ );
+  }
+  std::stringstream buffer;
+  buffer << infile.rdbuf();
+  json spec = json::parse ( buffer . str () );
+  multiple_ = spec . is_array ();
+  if ( multiple_ ) {
+    for ( auto const& item : spec ) {
+      Pattern pattern;
+      pattern . parse ( item . dump () );
+      patterngraphs_ . push_back ( PatternGraph ( pattern ) );
+    }
+    multipatterngraph_ . assign ( patterngraphs_ );
+    std::cout << "Merged " << patterngraphs_ . size () << " patterns.\n";
+  } else {
+    pattern_ . parse ( buffer . str () );
+    patterngraph_ . assign ( pattern_ );
+  }
+}
+
+std::vector<uint64_t> PatternMatchDatabase::
+matches ( uint64_t parameter_index, 
+          uint64_t morse_set_index,
+          PatternMatchWorkspace & workspace,
+          ParameterAnalysisCache & cache ) const {
+  std::vector<uint64_t> result;
+  // Reuse the domain graph and Morse decomposition of recently seen parameters
+  auto const& analysis = cache . analysis ( parametergraph_, parameter_index );
+  SearchGraph searchgraph ( analysis.first, analysis.second, morse_set_index );
+  if ( multiple_ ) {
+    std::vector<bool> matched = QueryCycleMatches ( searchgraph, multipatterngraph_, workspace );
+    for ( uint64_t k = 0; k < matched . size (); ++ k ) {
+      if ( matched [ k ] ) result . push_back ( k );
+    }
+  } else {
+    MatchingGraph matchinggraph ( searchgraph, patterngraph_ );
+    if ( QueryCycleMatch ( matchinggraph, workspace ) ) result . push_back ( 0 );
+  }
+  return result;
+}
+
+std::vector<std::pair<uint64_t,uint64_t>> PatternMatchDatabase::
+read_grouped_jobs ( void ) const {
+  // Read all pairs and bring those of the same parameter together
+  std::vector<std::pair<uint64_t,uint64_t>> result;
+  std::ifstream input_file ( input_filename_ );
+  uint64_t parameter_index;
+  uint64_t morse_set_index;
+  while ( input_file >> parameter_index >> morse_set_index ) {
+    result . push_back ( {parameter_index, morse_set_index} );
+  }
+  std::stable_sort ( result . begin (), result . end (),
+    [](std::pair<uint64_t,uint64_t> const& lhs, std::pair<uint64_t,uint64_t> const& rhs ) {
+      return lhs.first < rhs.first; } );
+  return result;
+}
+
+void PatternMatchDatabase::
+run ( uint64_t num_threads ) const {
+  struct State {
+    PatternMatchWorkspace workspace;
+    ParameterAnalysisCache cache;
+  };
+  auto process = [&](State & state, uint64_t parameter_index, uint64_t morse_set_index, std::string & output) {
+    for ( uint64_t k : matches ( parameter_index, morse_set_index, state . workspace, state . cache ) ) {
+      output += std::to_string ( parameter_index ) + " " + std::to_string ( morse_set_index );
+      if ( multiple_ ) output += " " + std::to_string ( k );
+      output += "\n";
+    }
+  };
+  if ( group_by_parameter_ ) {
+    // Cohorts are filled, then extended to the end of the last parameter's
+    // group (as in prepare), so that no parameter is split between threads
+    auto jobs = read_grouped_jobs ();
+    std::vector<uint64_t> cohort_begin ( 1, 0 );
+    for ( uint64_t i = 1; i < jobs . size (); ++ i ) {
+      if ( i - cohort_begin . back () >= COHORT_SIZE && jobs [ i ] . first != jobs [ i - 1 ] . first ) {
+        cohort_begin . push_back ( i );
+      }
+    }
+    cohort_begin . push_back ( jobs . size () );
+    ThreadedExecutor<State> ( cohort_begin, output_filename_, num_threads,
+      [&](State & state, uint64_t i, std::string & output) {
+        process ( state, jobs [ i ] . first, jobs [ i ] . second, output );
+      } );
+  } else {
+    ThreadedExecutor<State> ( input_filename_, output_filename_, num_threads, COHORT_SIZE,
+      [&](State & state, std::string const& line, std::string & output) {
+        std::istringstream ss ( line );
+        uint64_t parameter_index;
+        uint64_t morse_set_index;
+        if ( not ( ss >> parameter_index >> morse_set_index ) ) return;
+        process ( state, parameter_index, morse_set_index, output );
+      } );
+  }
+  std::cout << "Finished.\n";
+}
+
+#ifndef PATTERNMATCH_NO_MPI
 void PatternMatchDatabase::
 initialize ( void ) {
   // Initialize input and output streams
   input_file_ . open ( input_filename_ );
   output_file_ . open ( output_filename_ );
   jobs_submitted_ = 0;
+  next_job_ = 0;
+  if ( group_by_parameter_ ) grouped_jobs_ = read_grouped_jobs ();
 }
 
 int  PatternMatchDatabase::
@@ -78,7 +214,17 @@ prepare ( Message & job ) {
   //   (They are submitted in groups rather than one at a time to
   //    reduce communication overhead)
   std::vector<std::pair<uint64_t,uint64_t>> job_cohort;
-  while ( job_cohort . size () < COHORT_SIZE ) {
+  if ( group_by_parameter_ ) {
+    // Fill the cohort, then extend it to the end of the last parameter's
+    // group so that no parameter is split between workers
+    while ( next_job_ < grouped_jobs_ . size () ) {
+      auto const& pair = grouped_jobs_ [ next_job_ ];
+      if ( job_cohort . size () >= COHORT_SIZE && pair.first != job_cohort . back () . first ) break;
+      job_cohort . push_back ( pair );
+      ++ next_job_;
+    }
+  }
+  while ( not group_by_parameter_ && job_cohort . size () < COHORT_SIZE ) {
     uint64_t parameter_index;
     uint64_t morse_set_index;
     input_file_ >> parameter_index >> morse_set_index;
@@ -97,26 +243,32 @@ work ( Message & result, const Message & job ) const {
   std::vector<std::pair<uint64_t,uint64_t>> job_cohort;
   job >> job_cohort;
   std::vector<std::pair<uint64_t,uint64_t>> result_data;
+  std::vector<uint64_t> matched_patterns;
+  PatternMatchWorkspace workspace;
   // Loop through (parameter_index, morse_set_index) pairs and 
   // filter out those for which there is no match
   for ( auto const& pair : job_cohort ) {
-    uint64_t parameter_index = pair.first;
-    uint64_t morse_set_index = pair.second;
-    Parameter p = parametergraph_ . parameter ( parameter_index );
-    DomainGraph domaingraph ( p );
-    SearchGraph searchgraph ( domaingraph, morse_set_index );
-    MatchingGraph matchinggraph ( searchgraph, patterngraph_ );
-    if ( QueryCycleMatch ( matchinggraph ) ) result_data . push_back ( pair );
+    // Record one (pair, pattern index) entry per matching pattern
+    for ( uint64_t k : matches ( pair.first, pair.second, workspace, cache_ ) ) {
+      result_data . push_back ( pair );
+      matched_patterns . push_back ( k );
+    }
   }
   result << result_data;
+  result << matched_patterns;
 }
 
 void PatternMatchDatabase::
 accept ( const Message &result ) {
   std::vector<std::pair<uint64_t,uint64_t>> result_data;
+  std::vector<uint64_t> matched_patterns;
   result >> result_data;
-  for ( auto const& pair : result_data ) {
-    output_file_ << pair.first << " " << pair.second << "\n";
+  result >> matched_patterns;
+  for ( uint64_t i = 0; i < result_data . size (); ++ i ) {
+    auto const& pair = result_data [ i ];
+    output_file_ << pair.first << " " << pair.second;
+    if ( multiple_ ) output_file_ << " " << matched_patterns [ i ];
+    output_file_ << "\n";
   }
 }
 
@@ -126,3 +278,4 @@ finalize ( void ) {
   output_file_ . close ();
   std::cout << "Finished.\n";
 }
+#endif
@@ -0,0 +1,28 @@
+/// SimulationSummaryConvert.cpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#include "common.h"
+#include "SimulationSummaryFile.h"
+
+std::string help_string =
+  "Please supply the following arguments:\n"
+  " --> analysis file: contains on each line a JSON string encoding an object\n"
+  "                    {\"ParameterIndex\":...,\"SimulationSummary\":[...],...any other fields...}\n"
+  " --> output file (into which will be stored the parameter indices and simulation\n"
+  "                  summaries in the binary format read by NumericalSimulationPatternMatch)\n";
+
+int main ( int argc, char * argv [] ) {
+  if ( argc < 3 ) {
+    std::cout << help_string;
+    return 1;
+  }
+  try {
+    uint64_t records = SimulationSummaryConvert ( argv[1], argv[2] );
+    std::cout << "Converted " << records << " simulation summaries.\n";
+  } catch ( std::exception & e ) {
+    std::cerr << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,80 @@
+/// TestSimulationSummaryFile.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "SimulationSummaryFile.h"
+
+#include <cstdio>
+
+/// write_file
+///   Replace the contents of a file
+void
+write_file ( std::string const& filename, std::string const& contents ) {
+  std::ofstream outfile ( filename );
+  outfile << contents;
+}
+
+int main ( int argc, char * argv [] ) {
+  std::string const json_filename = "TestSimulationSummaryFile.json";
+  std::string const binary_filename = "TestSimulationSummaryFile.bin";
+  int status = 0;
+  try {
+    // JSON -> SimulationSummaryFile -> JSON keeps the parameter indices
+    // and summaries, in order, and skips empty lines
+    std::vector<std::string> lines = {
+      "{\"ParameterIndex\":7,\"SimulationSummary\":[3,6,12,9,3],\"Other\":\"ignored\"}",
+      "{\"SimulationSummary\":[],\"ParameterIndex\":0}",
+      "",
+      "{\"ParameterIndex\":9223372036854775807,\"SimulationSummary\":[9223372036854775807,0,1]}",
+      "{\"ParameterIndex\":7,\"SimulationSummary\":[5]}" };
+    std::string contents;
+    for ( auto const& line : lines ) contents += line + "\n";
+    write_file ( json_filename, contents );
+    if ( SimulationSummaryConvert ( json_filename, binary_filename ) != 4 ) throw std::logic_error ( "Wrong number of records converted" );
+    if ( not SimulationSummaryFile::is_binary ( binary_filename ) ) throw std::logic_error ( "Converted file is not binary" );
+    SimulationSummaryFile file ( binary_filename );
+    std::vector<json> expected, round_trip;
+    for ( auto const& line : lines ) {
+      if ( line . empty () ) continue;
+      json j = json::parse ( line );
+      expected . push_back ( { { "ParameterIndex", j [ "ParameterIndex" ] }, { "SimulationSummary", j [ "SimulationSummary" ] } } );
+    }
+    for ( uint64_t i = 0; i < file . size (); ++ i ) {
+      round_trip . push_back ( { { "ParameterIndex", file . parameter_index ( i ) }, { "SimulationSummary", file . summary ( i ) } } );
+    }
+    if ( round_trip != expected ) throw std::logic_error ( "Round trip changed the simulation summaries" );
+    // A malformed record is reported with its line
+    for ( std::string bad : { "{\"ParameterIndex\":1,\"SimulationSummary\":[1,2", 
+                                     "{\"ParameterIndex\":1}",
+                                     "{\"ParameterIndex\":1,\"SimulationSummary\":[\"a\"]}" } ) {
+      write_file ( json_filename, lines [ 0 ] + "\n\n" + bad + "\n" );
+      std::string message;
+      try {
+        SimulationSummaryConvert ( json_filename, binary_filename );
+      } catch ( std::runtime_error const& e ) {
+        message = e . what ();
+      }
+      if ( message . find ( json_filename + ":3:" ) != 0 ) throw std::logic_error ( "Malformed record not reported with its line: " + bad );
+    }
+    // Output which cannot be written is reported
+    write_file ( json_filename, contents );
+    for ( std::string const& output : { std::string ( "no/such/directory/output.bin" ), std::string ( "/dev/full" ) } ) {
+      if ( output == "/dev/full" && not std::ifstream ( output ) . good () ) continue;
+      bool thrown = false;
+      try {
+        SimulationSummaryConvert ( json_filename, output );
+      } catch ( std::runtime_error const& ) {
+        thrown = true;
+      }
+      if ( not thrown ) throw std::logic_error ( "Unwritable output " + output + " not reported" );
+    }
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    status = 1;
+  }
+  std::remove ( json_filename . c_str () );
+  std::remove ( binary_filename . c_str () );
+  return status;
+}
@@ -0,0 +1,89 @@
+/// TestThreadedExecutor.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "ThreadedExecutor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+struct State {};
+
+/// read_file
+///   Return the contents of a file
+std::string
+read_file ( std::string const& filename ) {
+  std::ifstream infile ( filename );
+  std::stringstream ss;
+  ss << infile . rdbuf ();
+  return ss . str ();
+}
+
+int main ( int argc, char * argv [] ) {
+  std::string const output_filename = "TestThreadedExecutor.txt";
+  try {
+    // Cohorts of uneven sizes, processed at uneven speeds, are written in order
+    uint64_t const num_items = 1000;
+    std::vector<uint64_t> cohort_begin { 0 };
+    for ( uint64_t c = 1; cohort_begin . back () < num_items; ++ c ) {
+      cohort_begin . push_back ( std::min ( num_items, cohort_begin . back () + c % 7 + 1 ) );
+    }
+    std::string expected;
+    for ( uint64_t i = 0; i < num_items; ++ i ) expected += std::to_string ( i ) + "\n";
+    auto process = [](State &, uint64_t i, std::string & output) {
+      if ( i % 97 == 0 ) std::this_thread::sleep_for ( std::chrono::milliseconds ( 2 ) );
+      output += std::to_string ( i ) + "\n";
+    };
+    for ( uint64_t num_threads : { 1, 3, 8 } ) {
+      ThreadedExecutor<State> ( cohort_begin, output_filename, num_threads, process );
+      if ( read_file ( output_filename ) != expected ) throw std::logic_error ( "Cohorts written out of order" );
+      ThreadedExecutor<State> ( num_items, output_filename, num_threads, 16, process );
+      if ( read_file ( output_filename ) != expected ) throw std::logic_error ( "Items written out of order" );
+    }
+    // Lines of an input file
+    {
+      std::ofstream input ( output_filename + ".in" );
+      input << "a\nbb\n\nccc\n";
+    }
+    ThreadedExecutor<State> ( output_filename + ".in", output_filename, 2, 1,
+      [](State &, std::string const& line, std::string & output) { output += std::to_string ( line . size () ) + ","; } );
+    std::remove ( ( output_filename + ".in" ) . c_str () );
+    if ( read_file ( output_filename ) != "1,2,3," ) throw std::logic_error ( "Lines processed out of order or empty lines kept" );
+    // An exception thrown by a worker reaches the caller, and the file
+    // holds a prefix of whole cohorts
+    for ( uint64_t num_threads : { 1, 4 } ) {
+      bool thrown = false;
+      try {
+        ThreadedExecutor<State> ( num_items, output_filename, num_threads, 10,
+          [&](State & state, uint64_t i, std::string & output) {
+            if ( i == 537 ) throw std::runtime_error ( "item 537" );
+            process ( state, i, output );
+          } );
+      } catch ( std::runtime_error const& e ) {
+        thrown = ( std::string ( e . what () ) == "item 537" );
+      }
+      if ( not thrown ) throw std::logic_error ( "Exception of a worker was not propagated" );
+      std::string written = read_file ( output_filename );
+      if ( expected . compare ( 0, written . size (), written ) != 0 || written . size () > expected . find ( "530\n" ) ) {
+        throw std::logic_error ( "Output after an exception is not a prefix of completed cohorts" );
+      }
+    }
+    // An output file which cannot be opened is reported
+    bool thrown = false;
+    try {
+      ThreadedExecutor<State> ( num_items, "no/such/directory/output.txt", 2, 10, process );
+    } catch ( std::runtime_error const& ) {
+      thrown = true;
+    }
+    if ( not thrown ) throw std::logic_error ( "Unopenable output file was not reported" );
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    std::remove ( output_filename . c_str () );
+    return 1;
+  }
+  std::remove ( output_filename . c_str () );
+  return 0;
+}
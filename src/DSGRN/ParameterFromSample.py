@@ -189,3 +189,15 @@ def par_index_from_sample(parameter_graph, L, U, T):
         partial_orders.append(node_region)
     par_index = index_from_partial_orders(parameter_graph, partial_orders)
     return par_index
+
+def par_indices_from_samples(parameter_graph, L, U, T, num_threads=0):
+    """Returns the parameter index of each sample (-1 if invalid)
+    L, U and T are arrays of shape (num_samples, D, D) (or (D, D) for a
+    single sample), with L[k, s, d], U[k, s, d] the values of the edge s -> d
+    and T[k, d, s] the threshold of the edge d -> s, in the sample k. The
+    inputs of a node are taken in the order of network.inputs(d). Computed
+    in C++ by ParameterGraph.index_from_samples.
+    """
+    D = parameter_graph.dimension()
+    L, U, T = [np.ascontiguousarray(np.asarray(A, dtype=float).reshape(-1, D, D)) for A in (L, U, T)]
+    return parameter_graph.index_from_samples(L, U, T, num_threads)
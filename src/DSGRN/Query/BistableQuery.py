@@ -8,7 +8,10 @@ class BistableQuery:
     self.database = database
     if not hasattr(database, 'BistableQuery'):
       c = database.conn.cursor()
-      sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphVertices except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount=2;"
+      if database.has_features:
+        sqlexpression = "select MorseGraphIndex from MorseGraphFeatures where MinimalCount=2;"
+      else:
+        sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphVertices except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount=2;"
       database.BistableQuery = frozenset([ row[0] for row in c.execute(sqlexpression) ])
 
   def matches(self):
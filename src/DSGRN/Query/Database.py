@@ -30,6 +30,10 @@ class Database:
     # each node. We call these "bases" (as in number base) and we compute the place value for each digit.
     self.indexing_place_bases = [self.parametergraph.logicsize(i) for i in range(0,self.D)] + [self.parametergraph.ordersize(i) for i in range(0,self.D)]
     self.indexing_place_values = reduce ( lambda x, y : x + [x[-1]*y], self.indexing_place_bases[:-1], [1])
+    # Databases built by recent versions of DSGRN-Database/Signatures.py carry a MorseGraphFeatures
+    # table summarizing the minimal Morse nodes of each Morse graph; queries use it when present.
+    self.cursor.execute("select count(*) from sqlite_master where name='MorseGraphFeatures'")
+    self.has_features = self.cursor.fetchone()[0] > 0
 
   def execute(self, expression, parameters = None):
     """
@@ -7,6 +7,7 @@
 #   DoubleFixedPointQuery.py
 # in order to create SQL tables to support their queries.
 
+from DSGRN._dsgrn import FixedPointTable
 from DSGRN.Query.Logging import LogToSTDOUT
 
 def FPString(i, j, database):
@@ -15,8 +16,11 @@ def FPString(i, j, database):
   expression = "Label like 'FP { " + ', '.join(terms) + "%'";
   return expression
 
-def buildQueryExpression(bounds, database):
-  expressions = []
+def buildBounds(bounds, database):
+  """
+  Return a list of (lowerbound, upperbound) pairs, one per network node
+  """
+  result = []
   for i in range(0,database.D):
     networknodename = database.names[i]
     lowerbound = 0
@@ -29,27 +33,44 @@ def buildQueryExpression(bounds, database):
       else:
         lowerbound = varbounds[0]
         upperbound = varbounds[1]
+    result.append((lowerbound, upperbound))
+  return result
+
+def buildQueryExpression(bounds, database):
+  expressions = []
+  for i, (lowerbound, upperbound) in enumerate(buildBounds(bounds, database)):
     expression = " or ".join([ FPString(i,j,database) for j in range(lowerbound, upperbound+1)])
     expressions.append(expression)
   return expressions
 
+def LoadFixedPointTable(database):
+  """
+  Return the FixedPointTable (a C++ coordinate matrix of all FP annotations)
+  of the database, parsing the annotations on first use
+  """
+  if not hasattr(database, 'FixedPointTable'):
+    LogToSTDOUT("LoadFixedPointTable :: parsing FP annotations")
+    c = database.conn.cursor()
+    rows = c.execute("select MorseGraphIndex, Vertex, Label from MorseGraphAnnotations where Label like 'FP%';").fetchall()
+    database.FixedPointTable = FixedPointTable(database.D, [ row[0] for row in rows ], [ row[1] for row in rows ], [ row[2] for row in rows ])
+  return database.FixedPointTable
+
+def MatchFixedPoints(bounds, database):
+  """
+  Return a numpy array of the Morse graph indices with a fixed point within bounds
+  """
+  return LoadFixedPointTable(database).matches(buildBounds(bounds, database))
+
 def MatchQuery(bounds, outputtablename, database):
-  # Parse the command line
+  """
+  Create the temp table outputtablename holding the rows of MorseGraphAnnotations
+  with a fixed point within bounds
+  """
   LogToSTDOUT("MatchQuery(" + str(bounds) + ", " + str(outputtablename) + ")")
+  table = LoadFixedPointTable(database)
+  labels = lambda row : "FP { " + ", ".join([ str(x) for x in table.coordinates(row) ]) + " }"
   c = database.conn.cursor()
-  expressions = buildQueryExpression(bounds, database)
-  LogToSTDOUT("MatchQuery :: built expressions " + str(expressions) )
-  N = len(expressions)
-  for i, expression in enumerate(expressions):
-    oldtable = 'tmpMatches' + str(i)
-    if i == 0: oldtable = "MorseGraphAnnotations"
-    newtable = 'tmpMatches' + str(i+1)
-    if i == N-1: newtable = outputtablename
-    sql_string = 'create temp table ' + newtable + ' as select * from ' + oldtable + ' where ' + expression + ';'
-    LogToSTDOUT("MatchQuery :: " + sql_string)
-    c.execute(sql_string)
-    if i > 0: c.execute('drop table ' + oldtable);
+  c.execute('create temp table ' + outputtablename + ' (MorseGraphIndex INTEGER, Vertex INTEGER, Label TEXT);')
+  c.executemany('insert into ' + outputtablename + ' (MorseGraphIndex, Vertex, Label) values (?, ?, ?);',
+    ( (table.morsegraphindex(row), table.vertex(row), labels(row)) for row in table.rows(buildBounds(bounds, database)).tolist() ))
   LogToSTDOUT("MatchQuery :: constructed")
-
-
-
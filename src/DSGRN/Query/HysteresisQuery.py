@@ -9,6 +9,7 @@ from DSGRN.Query.SingleFixedPointQuery import *
 from DSGRN.Query.DoubleFixedPointQuery import *
 from DSGRN.Query.SingleGeneQuery import *
 from DSGRN.Query.Logging import LogToSTDOUT
+from DSGRN._dsgrn import SingleGeneQuerySweep, CompileRegexToNFA
 
 class HysteresisQuery:
   """
@@ -83,4 +84,19 @@ class HysteresisQuery:
       self.memoization_cache[searchgraphstring] = is_reachable
     LogToSTDOUT("HysteresisQuery: Returning." ) # DEBUG
     return self.memoization_cache[searchgraphstring]
-    
+
+  def sweep(self, num_threads = 0):
+    """
+    Return a numpy boolean array whose entry rpi equals self(rpi), for every reduced
+    parameter index rpi. The reduced parameters are processed in parallel in C++
+    (SingleGeneQuerySweep) by matching the regular expression Q(Q|q)*B+(p|P)*P,
+    memoized by the string of labels as in __call__.
+    """
+    LogToSTDOUT("HysteresisQuery :: sweep")
+    c = self.database.conn.cursor()
+    morsegraphindices = [ row[0] for row in c.execute("select MorseGraphIndex from Signatures order by ParameterIndex;") ]
+    labels = [ self.matching_label(mgi) for mgi in range(0, max(morsegraphindices)+1) ]
+    sweep = SingleGeneQuerySweep(self.database.network, self.gene, morsegraphindices, labels)
+    result = sweep(CompileRegexToNFA("Q(Q|q)*B+(p|P)*P"), num_threads)
+    LogToSTDOUT("HysteresisQuery :: sweep complete")
+    return result
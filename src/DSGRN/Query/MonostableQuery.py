@@ -14,8 +14,11 @@ class MonostableQuery:
     self.database = database
     if not hasattr(database, 'MonostableQuery'):
       c = database.conn.cursor()
-      LogToSTDOUT("MonostableQuery :: select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphVertices except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount=1;")
-      sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphVertices except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount=1;"
+      if database.has_features:
+        sqlexpression = "select MorseGraphIndex from MorseGraphFeatures where MinimalCount=1;"
+      else:
+        sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphVertices except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount=1;"
+      LogToSTDOUT("MonostableQuery :: " + sqlexpression)
       database.MonostableQuery = frozenset([ row[0] for row in c.execute(sqlexpression) ])
     LogToSTDOUT("MonostableQuery :: constructed")
 
@@ -11,7 +11,10 @@ class MultistableQuery:
     self.database = database
     if not hasattr(database, 'MultistableQuery'):
       c = database.conn.cursor()
-      sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphVertices except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount>1;"
+      if database.has_features:
+        sqlexpression = "select MorseGraphIndex from MorseGraphFeatures where MinimalCount>1;"
+      else:
+        sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphVertices except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount>1;"
       database.MultistableQuery = frozenset([ row[0] for row in c.execute(sqlexpression) ])
 
   def matches(self):
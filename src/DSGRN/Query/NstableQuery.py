@@ -13,7 +13,10 @@ class NstableQuery:
   def __init__ (self, database, N ):
     self.database = database
     c = database.conn.cursor()
-    sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphAnnotations where Label like 'FP%' except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount>{};".format(N-1)
+    if database.has_features:
+      sqlexpression = "select MorseGraphIndex from MorseGraphFeatures where MinimalFP>{};".format(N-1)
+    else:
+      sqlexpression = "select MorseGraphIndex from (select MorseGraphIndex, count(*) as StableCount from (select MorseGraphIndex,Vertex from MorseGraphAnnotations where Label like 'FP%' except select MorseGraphIndex,Source from MorseGraphEdges) group by MorseGraphIndex) where StableCount>{};".format(N-1)
     database.NQuery = frozenset([ row[0] for row in c.execute(sqlexpression) ])
 
   def matches(self):
@@ -3,12 +3,16 @@
 # Shaun Harker
 
 from collections import defaultdict
+import json
 
 class StableFCQuery:
   def __init__ (self, database):
     self.database = database
     c = database.conn.cursor()
-    query_result = [ row for row in c.execute('select ParameterIndex, Vertex from Signatures natural join (select MorseGraphIndex,Vertex from (select MorseGraphIndex,Vertex from MorseGraphAnnotations where Label="FC" except select MorseGraphIndex,Source from MorseGraphEdges));')]
+    if database.has_features:
+      query_result = [ (row[0], v) for row in c.execute('select ParameterIndex, MinimalFCVertices from Signatures natural join (select MorseGraphIndex, MinimalFCVertices from MorseGraphFeatures where MinimalFC > 0);') for v in json.loads(row[1]) ]
+    else:
+      query_result = [ row for row in c.execute('select ParameterIndex, Vertex from Signatures natural join (select MorseGraphIndex,Vertex from (select MorseGraphIndex,Vertex from MorseGraphAnnotations where Label="FC" except select MorseGraphIndex,Source from MorseGraphEdges));')]
     self.query_data = defaultdict(set)
     for parameter_index, morse_node in query_result:
       self.query_data[parameter_index].add(morse_node)
@@ -3,13 +3,25 @@
 from mpi4py import MPI
 from mpi4py.futures import MPICommExecutor
 from DSGRN import *
-import sqlite3, sys, time
+import sqlite3, sys, time, json
 import progressbar # pip install progressbar2
 
-def SaveDatabase(filename, data, pg):
+# Indices created after all rows are inserted, by profile ("full", "query"
+# or "none"); the statements are shared with DSGRN-Database
+IndexProfiles = { name : "\n".join(statements) for (name, statements) in DatabaseIndexProfiles() }
+
+def SaveDatabase(filename, data, pg, indices="full"):
     print("Save Database")
     N = pg.size()
     conn = sqlite3.connect(filename)
+    # Bulk-load pragmas: the file is written in one pass, so journaling and syncing are not needed
+    conn.executescript("""
+      pragma locking_mode = EXCLUSIVE;
+      pragma journal_mode = OFF;
+      pragma synchronous = OFF;
+      pragma cache_size = -1048576;
+      pragma temp_store = MEMORY;
+      """)
     conn.executescript("""
       create table if not exists Signatures (ParameterIndex INTEGER PRIMARY KEY, MorseGraphIndex INTEGER);
       create table if not exists MorseGraphViz (MorseGraphIndex INTEGER PRIMARY KEY, Graphviz TEXT);
@@ -17,6 +29,7 @@ def SaveDatabase(filename, data, pg):
       create table if not exists MorseGraphEdges (MorseGraphIndex INTEGER, Source INTEGER, Target INTEGER);
       create table if not exists MorseGraphAnnotations (MorseGraphIndex INTEGER, Vertex INTEGER, Label TEXT);
       create table if not exists Network ( Name TEXT, Dimension INTEGER, Specification TEXT, Graphviz TEXT);
+      create table if not exists MorseGraphFeatures (MorseGraphIndex INTEGER PRIMARY KEY, MinimalCount INTEGER, MinimalFP INTEGER, MinimalFC INTEGER, MinimalXC INTEGER, MinimalFPCoordinates TEXT, MinimalFCVertices TEXT);
       """)
 
     # Postprocessing to give Morse Graphs indices
@@ -38,6 +51,16 @@ def SaveDatabase(filename, data, pg):
     def MG(mgi):
         return MorseGraph().parse(morsegraphs[mgi])
 
+    def features(mgi):
+        # Summary of the minimal Morse nodes (see DSGRN.Query.Database.has_features)
+        mg = MG(mgi)
+        minimal = [ v for v in range(0,mg.poset().size()) if len(mg.poset().children(v)) == 0 ]
+        labels = [ (v, label) for v in minimal for label in mg.annotation(v) ]
+        fp = [ [ int(x) for x in label[2:].strip(' {}').split(',') ] for (v, label) in labels if label.startswith('FP') ]
+        fc = [ v for (v, label) in labels if label == 'FC' ]
+        xc = [ v for (v, label) in labels if label.startswith('XC') ]
+        return (mgi, len(minimal), len(fp), len(fc), len(xc), json.dumps(fp, separators=(',',':')), json.dumps(fc, separators=(',',':')))
+
     name = filename
     if filename[-3:] == '.db':
         name = filename[:-3]
@@ -64,16 +87,12 @@ def SaveDatabase(filename, data, pg):
     conn.executemany("insert into MorseGraphAnnotations (MorseGraphIndex, Vertex, Label) values (?, ?, ?);",
       ( (mgi, v, label) for mgi in progressbar.ProgressBar()(range(0, len(morsegraphs))) for v in range(0,MG(mgi).poset().size()) for label in MG(mgi).annotation(v) ))
 
+    print("Inserting MorseGraphFeatures table into Database", flush=True)
+    conn.executemany("insert into MorseGraphFeatures (MorseGraphIndex, MinimalCount, MinimalFP, MinimalFC, MinimalXC, MinimalFPCoordinates, MinimalFCVertices) values (?, ?, ?, ?, ?, ?, ?);",
+      ( features(mgi) for mgi in progressbar.ProgressBar()(range(0, len(morsegraphs))) ))
+
     print("Indexing Database.", flush=True)
-    conn.executescript("""
-      create index if not exists Signatures2 on Signatures (MorseGraphIndex, ParameterIndex);
-      create index if not exists MorseGraphAnnotations3 on MorseGraphAnnotations (Label, MorseGraphIndex);
-      create index if not exists MorseGraphViz2 on MorseGraphViz (Graphviz, MorseGraphIndex);
-      create index if not exists MorseGraphVertices1 on MorseGraphVertices (MorseGraphIndex, Vertex);
-      create index if not exists MorseGraphVertices2 on MorseGraphVertices (Vertex, MorseGraphIndex);
-      create index if not exists MorseGraphEdges1 on MorseGraphEdges (MorseGraphIndex);
-      create index if not exists MorseGraphAnnotations1 on MorseGraphAnnotations (MorseGraphIndex);
-      """)
+    conn.executescript(IndexProfiles[indices])
     conn.commit()
     conn.close()
 
@@ -86,8 +105,13 @@ Signatures
       Signatures $netspecfile $outputfile
     where $netspecfile is the path to a network specification file
       and $outputfile  is the path to write the SQL database output to.
+    An optional third argument --indices=full|query|none selects which
+      indices are built (default full; query builds only those used by DSGRN.Query).
 """
-if len(sys.argv) != 3:
+indices = "full"
+if len(sys.argv) == 4 and sys.argv[3].startswith("--indices="):
+    indices = sys.argv[3][len("--indices="):]
+if len(sys.argv) not in (3, 4) or indices not in IndexProfiles:
     print(helpstring)
     exit(1)
 specfile = sys.argv[1]
@@ -104,4 +128,4 @@ def main():
             bar = progressbar.ProgressBar(max_value=gpg.size())
             print("Computing Morse Graphs")
             results = list(bar(executor.map(work, range(0,gpg.size()),chunksize=65536)))
-            SaveDatabase(outfile, results, gpg)
+            SaveDatabase(outfile, results, gpg, indices)
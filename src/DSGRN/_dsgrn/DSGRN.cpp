@@ -26,21 +26,31 @@ PYBIND11_MODULE( _dsgrn, m) {
   NetworkBinding(m);
   OrderParameterBinding(m);
   ParameterBinding(m);
+  LogicGeneratorBinding(m);
   ParameterGraphBinding(m);
   ConfigurationBinding(m);
+  CADTableBinding(m);
   ParameterSamplerBinding(m);
   // Phase
   DomainBinding(m);
   DomainGraphBinding(m);
+  LazyDomainGraphBinding(m);
   // Pattern
   MatchingGraphBinding(m);
   MatchingRelationBinding(m);
   PatternBinding(m);
   PatternGraphBinding(m);
   PatternMatchBinding(m);
+  MatchEnumeratorBinding(m);
+  MultiPatternGraphBinding(m);
+  MultiPatternMatchBinding(m);
+  LinearPathMatcherBinding(m);
   SearchGraphBinding(m);
   // Query
   NFABinding(m);
   ComputeSingleGeneQueryBinding(m);
+  DatabaseIndicesBinding(m);
+  FixedPointTableBinding(m);
+  SingleGeneQuerySweepBinding(m);
   ThompsonsConstructionBinding(m);
 }
@@ -6,12 +6,16 @@
 
 #include "Parameter/Network.h"
 #include "Parameter/Parameter.h"
+#include "Parameter/LogicGenerator.h"
 #include "Parameter/ParameterGraph.h"
 #include "Parameter/OrderParameter.h"
 #include "Parameter/LogicParameter.h"
+#include "Parameter/CADTable.h"
 #include "Parameter/ParameterSampler.h"
 #include "Phase/Domain.h"
+#include "Phase/DomainLabel.h"
 #include "Phase/DomainGraph.h"
+#include "Phase/LazyDomainGraph.h"
 #include "Phase/Wall.h"
 #include "Phase/WallGraph.h"
 #include "Dynamics/Annotation.h"
@@ -27,7 +31,14 @@
 #include "Pattern/Pattern.h"
 #include "Pattern/PatternGraph.h"
 #include "Pattern/PatternMatch.h"
+#include "Pattern/MatchEnumerator.h"
+#include "Pattern/MultiPatternGraph.h"
+#include "Pattern/MultiPatternMatch.h"
+#include "Pattern/LinearPathMatcher.h"
 #include "Pattern/SearchGraph.h"
 #include "Query/ComputeSingleGeneQuery.h"
+#include "Query/DatabaseIndices.h"
+#include "Query/FixedPointTable.h"
+#include "Query/SingleGeneQuerySweep.h"
 #include "Query/NFA.h"
 #include "Query/ThompsonsConstruction.h"
@@ -20,11 +20,14 @@
 #include "Parameter/LogicParameter.hpp"
 #include "Parameter/OrderParameter.hpp"
 #include "Parameter/Parameter.hpp"
+#include "Parameter/LogicGenerator.hpp"
 #include "Parameter/ParameterGraph.hpp"
 #include "Parameter/Configuration.h"
+#include "Parameter/CADTable.hpp"
 #include "Parameter/ParameterSampler.hpp"
 #include "Phase/Domain.hpp"
 #include "Phase/DomainGraph.hpp"
+#include "Phase/LazyDomainGraph.hpp"
 #include "Phase/Wall.hpp"
 #include "Phase/WallGraph.hpp"
 #include "Pattern/MatchingGraph.hpp"
@@ -32,7 +35,14 @@
 #include "Pattern/Pattern.hpp"
 #include "Pattern/PatternGraph.hpp"
 #include "Pattern/PatternMatch.hpp"
+#include "Pattern/MatchEnumerator.hpp"
+#include "Pattern/MultiPatternGraph.hpp"
+#include "Pattern/MultiPatternMatch.hpp"
+#include "Pattern/LinearPathMatcher.hpp"
 #include "Pattern/SearchGraph.hpp"
 #include "Query/ComputeSingleGeneQuery.hpp"
+#include "Query/DatabaseIndices.hpp"
+#include "Query/FixedPointTable.hpp"
+#include "Query/SingleGeneQuerySweep.hpp"
 #include "Query/NFA.hpp"
 #include "Query/ThompsonsConstruction.hpp"
@@ -0,0 +1,134 @@
+/// CADTable.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Parameter/Configuration.h"
+
+struct CADTable_;
+
+/// CADTable
+///   The CAD database of a network node type (see ParameterSampler): for
+///   each logic parameter of the factor graph, an instance of the L, U and
+///   T variables satisfying its inequalities. The rows are aligned with the
+///   hex codes of the logic resource of the node type (row i holds the
+///   instance of the ith hex code, i.e. of factor index i) and the columns
+///   are L[1] ... L[n], U[1] ... U[n], T[1] ... T[m].
+///
+///   A table is read from the precompiled binary file "name.cad" when there
+///   is one, memory-mapped, and from the JSON database "name.json"
+///   otherwise. Tables are shared: every CADTable assigned the same name
+///   in the process refers to the same data.
+///
+///   Binary file layout (native byte order):
+///     char[8] "DSGRNCAD", uint32_t version, uint32_t 0x01020304,
+///     uint64_t n, m, rows, hex_bytes, rows x (2n+m) doubles, then
+///     hex_bytes bytes holding the hex code of each row, each followed
+///     by a newline
+///   A binary file of another version or byte order is ignored. The
+///   binary files are not kept in the sources: setup.py compiles them
+///   next to the JSON databases when the package is built.
+class CADTable {
+public:
+  /// CADTable
+  ///   Default constructor
+  CADTable ( void );
+
+  /// CADTable
+  ///   Load the table "name" (a path without extension)
+  CADTable ( std::string const& name );
+
+  /// assign
+  ///   Load the table "name" (a path without extension)
+  void
+  assign ( std::string const& name );
+
+  /// inputs
+  ///   Return the number n of inputs of the node type
+  uint64_t
+  inputs ( void ) const;
+
+  /// outputs
+  ///   Return the number m of thresholds of the node type
+  uint64_t
+  outputs ( void ) const;
+
+  /// size
+  ///   Return the number of rows
+  uint64_t
+  size ( void ) const;
+
+  /// columns
+  ///   Return the number 2n+m of columns
+  uint64_t
+  columns ( void ) const;
+
+  /// index
+  ///   Return the row of a hex code, or -1 if it is not in the table
+  uint64_t
+  index ( std::string const& hex ) const;
+
+  /// hex
+  ///   Return the hex code of row i
+  std::string const&
+  hex ( uint64_t i ) const;
+
+  /// instance
+  ///   Return the row of factor index i
+  double const*
+  instance ( uint64_t i ) const;
+
+  /// compile
+  ///   Write the binary file of the JSON database "json_filename"
+  static void
+  compile ( std::string const& json_filename, std::string const& cad_filename );
+
+private:
+  std::shared_ptr<CADTable_> data_;
+};
+
+struct CADTable_ {
+  uint64_t n_;
+  uint64_t m_;
+  uint64_t rows_;
+  uint64_t columns_;
+  /// rows_ x columns_ values, in mapping_ or storage_
+  double const* values_;
+  std::vector<double> storage_;
+  void * mapping_;
+  uint64_t mapping_size_;
+  std::vector<std::string> hexes_;
+  std::unordered_map<std::string,uint64_t> index_;
+  ~CADTable_ ( void );
+};
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+inline void
+CADTableBinding (py::module &m) {
+  py::class_<CADTable, std::shared_ptr<CADTable>>(m, "CADTable")
+    .def(py::init<>())
+    .def(py::init<std::string const&>())
+    .def("inputs", &CADTable::inputs)
+    .def("outputs", &CADTable::outputs)
+    .def("size", &CADTable::size)
+    .def("columns", &CADTable::columns)
+    .def("index", &CADTable::index)
+    .def("hex", [](CADTable const& self, uint64_t i) {
+        if ( i >= self . size () ) throw std::out_of_range ( "CADTable::hex: index out of range" );
+        return self . hex ( i );
+      })
+    .def("instance", [](CADTable const& self, uint64_t i) {
+        if ( i >= self . size () ) throw std::out_of_range ( "CADTable::instance: index out of range" );
+        double const* row = self . instance ( i );
+        return std::vector<double> ( row, row + self . columns () );
+      })
+    .def_static("compile", &CADTable::compile);
+}
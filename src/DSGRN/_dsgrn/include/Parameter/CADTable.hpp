@@ -0,0 +1,256 @@
+/// CADTable.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#ifndef INLINE_IF_HEADER_ONLY
+#define INLINE_IF_HEADER_ONLY
+#endif
+
+#include "CADTable.h"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CADTableDetail {
+
+  static char const magic [ 8 ] = { 'D', 'S', 'G', 'R', 'N', 'C', 'A', 'D' };
+
+  /// version
+  ///   Version of the binary layout; bump it whenever the layout changes
+  static uint32_t const version = 2;
+
+  /// byte_order
+  ///   Written in native byte order, so it reads back differently on a
+  ///   machine of the other endianness
+  static uint32_t const byte_order = 0x01020304;
+
+  /// Header
+  ///   Leading fields of a binary CAD file
+  struct Header {
+    char magic [ 8 ];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t n;
+    uint64_t m;
+    uint64_t rows;
+    uint64_t hex_bytes;
+  };
+
+  /// read_json
+  ///   Read the JSON database "filename" into rows of values and hex codes
+  inline void
+  read_json ( std::string const& filename,
+              uint64_t & n,
+              uint64_t & m,
+              std::vector<double> & values,
+              std::vector<std::string> & hexes ) {
+    std::ifstream infile ( filename );
+    if ( not infile . good () ) {
+      throw std::runtime_error ( "Missing CAD database " + filename );
+    }
+    json J;
+    infile >> J;
+    n = m = 0;
+    if ( not J . empty () ) {
+      for ( auto it = J[0]["Instance"] . begin (); it != J[0]["Instance"] . end (); ++ it ) {
+        if ( it . key () [ 0 ] == 'L' ) ++ n;
+        if ( it . key () [ 0 ] == 'T' ) ++ m;
+      }
+    }
+    uint64_t columns = 2 * n + m;
+    values . assign ( J . size () * columns, 0.0 );
+    hexes . clear ();
+    for ( uint64_t row = 0; row < J . size (); ++ row ) {
+      hexes . push_back ( J[row]["Hex"] );
+      auto const& instance = J[row]["Instance"];
+      for ( auto it = instance . begin (); it != instance . end (); ++ it ) {
+        std::string const& key = it . key ();
+        uint64_t i = std::stoll ( key . substr ( 2, key . size () - 3 ) ) - 1;
+        uint64_t column;
+        switch ( key [ 0 ] ) {
+          case 'L': column = i; break;
+          case 'U': column = n + i; break;
+          case 'T': column = 2 * n + i; break;
+          default: continue;
+        }
+        if ( i >= ( key [ 0 ] == 'T' ? m : n ) ) {
+          throw std::runtime_error ( "Invalid variable " + key + " in CAD database " + filename );
+        }
+        values [ row * columns + column ] = it . value ();
+      }
+    }
+  }
+
+  /// Registry
+  ///   Tables in use, by name
+  struct Registry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<CADTable_>> tables;
+  };
+
+  inline Registry &
+  registry ( void ) {
+    static Registry result;
+    return result;
+  }
+}
+
+INLINE_IF_HEADER_ONLY CADTable_::
+~CADTable_ ( void ) {
+#ifndef _WIN32
+  if ( mapping_ != nullptr ) munmap ( mapping_, mapping_size_ );
+#endif
+}
+
+INLINE_IF_HEADER_ONLY CADTable::
+CADTable ( void ) {
+  data_ . reset ( new CADTable_ );
+  data_ -> n_ = data_ -> m_ = data_ -> rows_ = data_ -> columns_ = 0;
+  data_ -> values_ = nullptr;
+  data_ -> mapping_ = nullptr;
+  data_ -> mapping_size_ = 0;
+}
+
+INLINE_IF_HEADER_ONLY CADTable::
+CADTable ( std::string const& name ) {
+  assign ( name );
+}
+
+INLINE_IF_HEADER_ONLY void CADTable::
+assign ( std::string const& name ) {
+  using namespace CADTableDetail;
+  Registry & tables_in_use = registry ();
+  std::lock_guard<std::mutex> lock ( tables_in_use . mutex );
+  auto & tables = tables_in_use . tables;
+  data_ = tables [ name ] . lock ();
+  if ( data_ ) return;
+  data_ . reset ( new CADTable_ );
+  data_ -> values_ = nullptr;
+  data_ -> mapping_ = nullptr;
+  data_ -> mapping_size_ = 0;
+  std::vector<std::string> hexes;
+  bool loaded = false;
+#ifndef _WIN32
+  // Map the binary file, if there is a valid one written by this
+  // version in this byte order; otherwise fall back to the JSON database
+  int fd = open ( ( name + ".cad" ) . c_str (), O_RDONLY );
+  if ( fd != -1 ) {
+    struct stat st;
+    if ( fstat ( fd, &st ) == 0 && st . st_size >= (off_t) sizeof ( Header ) ) {
+      void * mapping = mmap ( nullptr, st . st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( mapping != MAP_FAILED ) {
+        Header header;
+        std::memcpy ( &header, mapping, sizeof ( Header ) );
+        uint64_t columns = 2 * header . n + header . m;
+        uint64_t values_bytes = header . rows * columns * sizeof ( double );
+        if ( std::equal ( magic, magic + 8, header . magic ) &&
+             header . version == version &&
+             header . byte_order == byte_order &&
+             sizeof ( Header ) + values_bytes + header . hex_bytes == (uint64_t) st . st_size ) {
+          data_ -> mapping_ = mapping;
+          data_ -> mapping_size_ = st . st_size;
+          data_ -> n_ = header . n;
+          data_ -> m_ = header . m;
+          data_ -> rows_ = header . rows;
+          data_ -> values_ = (double const*) ( (char const*) mapping + sizeof ( Header ) );
+          char const* text = (char const*) mapping + sizeof ( Header ) + values_bytes;
+          char const* end = text + header . hex_bytes;
+          while ( text < end ) {
+            char const* newline = std::find ( text, end, '\n' );
+            hexes . push_back ( std::string ( text, newline ) );
+            text = newline + 1;
+          }
+          loaded = ( hexes . size () == header . rows );
+          if ( not loaded ) {
+            hexes . clear ();
+            data_ -> mapping_ = nullptr;
+            data_ -> values_ = nullptr;
+          }
+        }
+        if ( not loaded ) munmap ( mapping, st . st_size );
+      }
+    }
+    close ( fd );
+  }
+#endif
+  if ( not loaded ) {
+    read_json ( name + ".json", data_ -> n_, data_ -> m_, data_ -> storage_, hexes );
+    data_ -> rows_ = hexes . size ();
+    data_ -> values_ = data_ -> storage_ . data ();
+  }
+  data_ -> columns_ = 2 * data_ -> n_ + data_ -> m_;
+  for ( uint64_t i = 0; i < hexes . size (); ++ i ) data_ -> index_ [ hexes [ i ] ] = i;
+  data_ -> hexes_ = std::move ( hexes );
+  tables [ name ] = data_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t CADTable::
+inputs ( void ) const {
+  return data_ -> n_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t CADTable::
+outputs ( void ) const {
+  return data_ -> m_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t CADTable::
+size ( void ) const {
+  return data_ -> rows_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t CADTable::
+columns ( void ) const {
+  return data_ -> columns_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t CADTable::
+index ( std::string const& hex ) const {
+  auto it = data_ -> index_ . find ( hex );
+  return ( it == data_ -> index_ . end () ) ? -1 : it -> second;
+}
+
+INLINE_IF_HEADER_ONLY std::string const& CADTable::
+hex ( uint64_t i ) const {
+  return data_ -> hexes_ [ i ];
+}
+
+INLINE_IF_HEADER_ONLY double const* CADTable::
+instance ( uint64_t i ) const {
+  return data_ -> values_ + i * data_ -> columns_;
+}
+
+INLINE_IF_HEADER_ONLY void CADTable::
+compile ( std::string const& json_filename, std::string const& cad_filename ) {
+  using namespace CADTableDetail;
+  Header header;
+  std::copy ( magic, magic + 8, header . magic );
+  header . version = version;
+  header . byte_order = byte_order;
+  std::vector<double> values;
+  std::vector<std::string> hexes;
+  read_json ( json_filename, header . n, header . m, values, hexes );
+  header . rows = hexes . size ();
+  std::string text;
+  for ( auto const& hex : hexes ) text += hex + "\n";
+  header . hex_bytes = text . size ();
+  std::ofstream outfile ( cad_filename, std::ios::binary );
+  if ( not outfile . good () ) {
+    throw std::runtime_error ( "Could not write CAD table " + cad_filename );
+  }
+  outfile . write ( (char const*) &header, sizeof ( Header ) );
+  outfile . write ( (char const*) values . data (), values . size () * sizeof ( double ) );
+  outfile . write ( text . data (), text . size () );
+  outfile . close ();
+  if ( outfile . fail () ) {
+    throw std::runtime_error ( "Could not write CAD table " + cad_filename );
+  }
+}
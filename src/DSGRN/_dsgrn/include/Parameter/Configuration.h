@@ -3,7 +3,9 @@
 /// 2018-01-31
 
 // Contains "Singleton" class with system-configuration information
-// At this point, this consists of information about where the logic files are stored
+// At this point, this consists of information about where the logic files are stored,
+// whether the missing ones may be generated on demand (see LogicGenerator),
+// and where the generated logic files are cached
 // The python import module 
 
 #pragma once
@@ -14,6 +16,17 @@ struct Configuration {
 public:
   Configuration ( void ) {
     path_ = "/usr/local/share/DSGRN/logic";
+    generate_logic_ = false;
+    char const* cache = std::getenv ( "DSGRN_CACHE" );
+    char const* xdg = std::getenv ( "XDG_CACHE_HOME" );
+    char const* home = std::getenv ( "HOME" );
+    if ( cache != nullptr && *cache ) {
+      cache_path_ = cache;
+    } else if ( xdg != nullptr && *xdg ) {
+      cache_path_ = std::string ( xdg ) + "/DSGRN";
+    } else if ( home != nullptr && *home ) {
+      cache_path_ = std::string ( home ) + "/.cache/DSGRN";
+    }
   }
   void set_path ( std::string const& path ) {
     path_ = path;
@@ -22,9 +35,33 @@ public:
   get_path ( void ) const {
     return path_;
   }
+  /// set_cache_path
+  ///   Set the directory of generated logic files ("" to not cache them).
+  ///   The default is $DSGRN_CACHE, else $XDG_CACHE_HOME/DSGRN, else
+  ///   $HOME/.cache/DSGRN
+  void set_cache_path ( std::string const& path ) {
+    cache_path_ = path;
+  }
+  std::string
+  get_cache_path ( void ) const {
+    return cache_path_;
+  }
+  /// set_generate_logic
+  ///   Allow ParameterGraph to generate the logic files which are neither
+  ///   shipped nor cached (see LogicGenerator::resource). Generation can
+  ///   take hours for large node types, so it is off by default.
+  void set_generate_logic ( bool generate_logic ) {
+    generate_logic_ = generate_logic;
+  }
+  bool
+  get_generate_logic ( void ) const {
+    return generate_logic_;
+  }
 
 private:
   std::string path_;
+  std::string cache_path_;
+  bool generate_logic_;
 };
 
 std::shared_ptr<Configuration>
@@ -44,6 +81,10 @@ ConfigurationBinding (py::module &m) {
   py::class_<Configuration, std::shared_ptr<Configuration>>(m, "Configuration")
     .def(py::init<>())
     .def("set_path", &Configuration::set_path)
-    .def("get_path", &Configuration::get_path);
+    .def("get_path", &Configuration::get_path)
+    .def("set_cache_path", &Configuration::set_cache_path)
+    .def("get_cache_path", &Configuration::get_cache_path)
+    .def("set_generate_logic", &Configuration::set_generate_logic)
+    .def("get_generate_logic", &Configuration::get_generate_logic);
   m.def("configuration", &configuration);
 }
@@ -0,0 +1,217 @@
+/// FactorGraph.h
+/// Author: Shaun Harker
+
+#ifndef BOOLEANSWITCHINGFACTORGRAPH_H
+#define BOOLEANSWITCHINGFACTORGRAPH_H
+
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <stdexcept>
+#include <memory>
+
+#include "MonotonicMap.h"
+
+/// class FactorGraph
+///   The connected graph of monotonic and realizable maps of a network
+///   node, adjacent when they differ by one in one value (see
+///   MonotonicMap::neighbors). Vertices are stored as packed keys (see
+///   MonotonicMap::key), of a single word when the maps are packable and
+///   of MonotonicMap::key_size words otherwise (see MonotonicMap::WideKey).
+///   The graph is built breadth first: the neighbors of the vertices of a
+///   level are computed in parallel, then numbered in order. A candidate
+///   neighbor which is already a vertex, or was already rejected, is not
+///   checked again, and the neighbor lists of the search are kept as the
+///   adjacencies. Since a candidate differs from a vertex in one value,
+///   only the conditions involving that value are checked (see
+///   MonotonicMap::realizable_at).
+class FactorGraph {
+public:
+  /// FactorGraph
+  ///   Construct an empty graph. If wide_keys is true, keys of several
+  ///   words are used even for packable maps (to check them against the
+  ///   single-word keys).
+  FactorGraph ( bool wide_keys = false ) : wide_keys_ ( wide_keys ) {}
+
+  size_t size ( void ) const {
+    return adjacencies_ . size ();
+  }
+
+  /// construct
+  ///   Build the graph of the maps connected to "start", expanding
+  ///   each level with num_threads() threads, and calling
+  ///   progress(size()) after each level if given
+  void construct ( MonotonicMap const& start, 
+                   std::function<int64_t(void)> const& num_threads,
+                   std::function<void(int64_t)> const& progress = nullptr ) {
+    start_ = start;
+    key_size_ = start . key_size ();
+    if ( start . packable () && not wide_keys_ ) {
+      build<uint64_t, std::hash<uint64_t>> ( num_threads, progress );
+    } else {
+      build<MonotonicMap::WideKey, MonotonicMap::WideKeyHash> ( num_threads, progress );
+    }
+  }
+
+  /// construct
+  ///   Build the graph of the maps connected to "start" with a
+  ///   fixed number of threads
+  void construct ( MonotonicMap const& start, int64_t num_threads = 1 ) {
+    construct ( start, [num_threads] () { return num_threads; } );
+  }
+
+  /// vertex
+  ///   Return the map of vertex v
+  MonotonicMap vertex ( int64_t v ) const {
+    MonotonicMap result = start_;
+    if ( key_size_ == 1 ) {
+      result . assign_key ( keys_ [ v ] );
+    } else {
+      result . assign_key ( MonotonicMap::WideKey ( keys_ . begin () + v * key_size_,
+                                                    keys_ . begin () + ( v + 1 ) * key_size_ ) );
+    }
+    return result;
+  }
+
+  const std::vector<int64_t> & adjacencies ( int64_t v ) const {
+    return adjacencies_ [ v ];
+  }
+
+  void saveToFile ( void ) const {
+    std::ofstream outfile ( "graph.gv" );
+    outfile << "graph factorgraph {\n";
+    for ( int64_t v = 0; v < (int64_t) size (); ++ v ) {
+      for ( int64_t u : adjacencies_ [ v ] ) {
+        if ( v < u ) {
+          outfile << v << " -- " << u << "\n";
+        }
+      }
+    }
+    outfile << "}\n\n";
+  }
+
+private:
+  bool wide_keys_;
+  MonotonicMap start_;
+  // number of words of a packed key
+  int64_t key_size_ = 1;
+  // packed key of each vertex, key_size_ words each
+  std::vector<uint64_t> keys_;
+  std::vector<std::vector< int64_t > > adjacencies_;
+
+  /// build
+  ///   Build the graph of the maps connected to start_ over packed keys
+  ///   of type Key (see construct)
+  template < class Key, class Hash >
+  void build ( std::function<int64_t(void)> const& num_threads,
+               std::function<void(int64_t)> const& progress ) {
+    std::vector<Key> keys;
+    // gives indexing
+    std::unordered_map<Key, int64_t, Hash> preorder;
+    std::unordered_set<Key, Hash> rejected;
+    adjacencies_ . clear ();
+    keys . push_back ( Key () );
+    pack ( start_, keys . back () );
+    preorder [ keys . back () ] = 0;
+    adjacencies_ . resize ( 1 );
+    std::vector<int64_t> frontier ( 1, 0 );
+    while ( not frontier . empty () ) {
+      // Find the neighbors of the frontier. Only the lists of the
+      // frontier are written, so the tables may be read concurrently.
+      int64_t F = frontier . size ();
+      std::vector<std::vector<Key>> neighbors ( F );
+      std::vector<std::vector<Key>> rejections ( F );
+      auto expand = [&] ( int64_t first, int64_t step ) {
+        MonotonicMap candidate = start_;
+        MonotonicMap map = start_;
+        std::vector<Key> adjacent;
+        std::vector<int64_t> changed;
+        for ( int64_t i = first; i < F; i += step ) {
+          candidate . assign_key ( keys [ frontier [ i ] ] );
+          adjacent_keys ( candidate, adjacent, changed );
+          for ( uint64_t k = 0; k < adjacent . size (); ++ k ) {
+            Key const& key = adjacent [ k ];
+            if ( preorder . count ( key ) ) {
+              neighbors [ i ] . push_back ( key );
+              continue;
+            }
+            if ( rejected . count ( key ) ) continue;
+            map . assign_key ( key );
+            if ( map . monotonic_at ( changed [ k ] ) && map . realizable_at ( changed [ k ] ) ) {
+              neighbors [ i ] . push_back ( key );
+            } else {
+              rejections [ i ] . push_back ( key );
+            }
+          }
+        }
+      };
+      int64_t T = std::max<int64_t> ( 1, std::min<int64_t> ( num_threads (), F / 16 ) );
+      std::vector<std::thread> threads;
+      std::exception_ptr error;
+      std::mutex error_mutex;
+      auto work = [&] ( int64_t t ) {
+        try {
+          expand ( t, T );
+        } catch ( ... ) {
+          std::lock_guard<std::mutex> lock ( error_mutex );
+          error = std::current_exception ();
+        }
+      };
+      for ( int64_t t = 1; t < T; ++ t ) threads . emplace_back ( work, t );
+      work ( 0 );
+      for ( auto & thread : threads ) thread . join ();
+      if ( error ) std::rethrow_exception ( error );
+      // Number the new vertices, in order
+      std::vector<int64_t> next;
+      for ( int64_t i = 0; i < F; ++ i ) {
+        int64_t v = frontier [ i ];
+        for ( Key const& key : neighbors [ i ] ) {
+          auto it = preorder . find ( key );
+          if ( it == preorder . end () ) {
+            it = preorder . insert ( { key, (int64_t) keys . size () } ) . first;
+            keys . push_back ( key );
+            adjacencies_ . emplace_back ();
+            next . push_back ( it -> second );
+          }
+          adjacencies_ [ v ] . push_back ( it -> second );
+        }
+        rejected . insert ( rejections [ i ] . begin (), rejections [ i ] . end () );
+      }
+      frontier . swap ( next );
+      if ( progress ) progress ( size () );
+    }
+    store ( keys );
+  }
+
+  /// pack, adjacent_keys, store
+  ///   The operations of build on either type of packed key
+  static void pack ( MonotonicMap const& map, uint64_t & key ) {
+    key = map . key ();
+  }
+  static void pack ( MonotonicMap const& map, MonotonicMap::WideKey & key ) {
+    key = map . wide_key ();
+  }
+  static void adjacent_keys ( MonotonicMap const& map, std::vector<uint64_t> & keys,
+                              std::vector<int64_t> & changed ) {
+    keys = map . adjacent_keys ( &changed );
+  }
+  static void adjacent_keys ( MonotonicMap const& map, std::vector<MonotonicMap::WideKey> & keys,
+                              std::vector<int64_t> & changed ) {
+    keys = map . adjacent_wide_keys ( &changed );
+  }
+  void store ( std::vector<uint64_t> & keys ) {
+    keys_ . swap ( keys );
+  }
+  void store ( std::vector<MonotonicMap::WideKey> & keys ) {
+    keys_ . clear ();
+    for ( auto const& key : keys ) keys_ . insert ( keys_ . end (), key . begin (), key . end () );
+  }
+};
+
+#endif
@@ -0,0 +1,141 @@
+/// LogicGenerator.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Parameter/Network.h"
+#include "Parameter/Configuration.h"
+#include "Parameter/MonotonicMap.h"
+#include "Parameter/FactorGraph.h"
+
+struct LogicGenerator_;
+
+/// LogicGenerator
+///   Generator of the logic resource of a network node type, i.e. of the
+///   sorted hex codes of the monotonic and realizable maps (see
+///   MonotonicMap and LogicParameter) of a node with n inputs combined by
+///   "logic" (the number of summands of each factor) and m out edges, as
+///   computed by software/NetworkLogic. It is used by ParameterGraph when
+///   the logic resource "n_m_logic[_E].dat" of a node is not shipped and
+///   configuration() -> get_generate_logic () is set, and the generated
+///   resources are cached in configuration() -> get_cache_path () under
+///   "logic/".
+///
+///   The generator enumerates the connected factor graph of the node type
+///   (see FactorGraph), so it is limited to the logics for which
+///   MonotonicMap::realizable is exact: sums, products, and (a)(b+c).
+class LogicGenerator {
+public:
+  /// LogicGenerator
+  ///   Default constructor
+  LogicGenerator ( void );
+
+  /// LogicGenerator
+  ///   Construct the generator of n inputs, m outputs and the given logic
+  LogicGenerator ( uint64_t n, uint64_t m, std::vector<uint64_t> const& logic );
+
+  /// assign
+  ///   Assign n inputs, m outputs and the given logic
+  void
+  assign ( uint64_t n, uint64_t m, std::vector<uint64_t> const& logic );
+
+  /// name
+  ///   Return the resource name "n_m_logic", with "_E" appended for the
+  ///   resource of essential parameters
+  std::string
+  name ( bool essential = false ) const;
+
+  /// estimate
+  ///   Return an estimate of the number of hex codes of the resource,
+  ///   without generating it: the hex codes of "samples" random instances
+  ///   of the L, U and T variables are computed, and the number of
+  ///   distinct codes is extrapolated with the Chao1 estimator. Rare codes
+  ///   may be missed, so this is a lower estimate; it is meant to tell
+  ///   in advance if generation is practical.
+  double
+  estimate ( uint64_t samples = 100000, uint64_t seed = 0 ) const;
+
+  /// generate
+  ///   Generate the resource with "num_threads" threads (0 for one per
+  ///   core), calling progress(k) as the search of the factor graph has
+  ///   found k hex codes if "progress" is given. Throws if the node type
+  ///   is not supported (see LogicGenerator).
+  void
+  generate ( uint64_t num_threads = 0,
+             std::function<void(uint64_t)> const& progress = nullptr );
+
+  /// codes
+  ///   Return the sorted hex codes of the resource, or of the resource of
+  ///   essential parameters (requires generate)
+  std::vector<std::string> const&
+  codes ( bool essential = false ) const;
+
+  /// save
+  ///   Write the resource and the resource of essential parameters to
+  ///   "directory" (created if need be) as name().dat and name(true).dat
+  ///   (requires generate)
+  void
+  save ( std::string const& directory ) const;
+
+  /// resource
+  ///   Return the hex codes of the logic resource of n inputs, m outputs
+  ///   and the given logic which is missing from configuration() -> get_path (),
+  ///   reading it from the cache or generating it (and caching it if
+  ///   possible). Throws std::runtime_error if it cannot be generated, or
+  ///   if it is not cached and configuration() -> get_generate_logic () is
+  ///   not set (with the estimate of its size in the message).
+  static std::vector<std::string>
+  resource ( uint64_t n, uint64_t m, std::vector<uint64_t> const& logic, bool essential );
+
+  /// missing
+  ///   Return the names of the logic resources of the nodes of "network"
+  ///   which are neither shipped nor cached, i.e. which ParameterGraph
+  ///   will generate (see Configuration::set_generate_logic)
+  static std::vector<std::string>
+  missing ( Network const& network );
+
+private:
+  std::shared_ptr<LogicGenerator_> data_;
+};
+
+struct LogicGenerator_ {
+  uint64_t n_;
+  uint64_t m_;
+  std::vector<uint64_t> logic_;
+  bool generated_;
+  std::vector<std::string> codes_;
+  std::vector<std::string> essential_codes_;
+};
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+inline void
+LogicGeneratorBinding (py::module &m) {
+  py::class_<LogicGenerator, std::shared_ptr<LogicGenerator>>(m, "LogicGenerator")
+    .def(py::init<>())
+    .def(py::init<uint64_t, uint64_t, std::vector<uint64_t> const&>())
+    .def("name", &LogicGenerator::name, py::arg("essential") = false)
+    .def("estimate", &LogicGenerator::estimate, py::arg("samples") = 100000, py::arg("seed") = 0)
+    .def("generate", [](LogicGenerator & self, uint64_t num_threads, py::object progress) {
+        // progress is called on this thread, between levels of the search
+        std::function<void(uint64_t)> report;
+        if ( not progress . is_none () ) {
+          report = [&progress] ( uint64_t k ) {
+            py::gil_scoped_acquire acquire;
+            progress ( k );
+          };
+        }
+        py::gil_scoped_release release;
+        self . generate ( num_threads, report );
+      }, py::arg("num_threads") = 0, py::arg("progress") = py::none())
+    .def("codes", &LogicGenerator::codes, py::arg("essential") = false)
+    .def("save", &LogicGenerator::save)
+    .def_static("missing", &LogicGenerator::missing);
+}
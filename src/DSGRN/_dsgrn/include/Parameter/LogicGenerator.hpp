@@ -0,0 +1,314 @@
+/// LogicGenerator.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#ifndef INLINE_IF_HEADER_ONLY
+#define INLINE_IF_HEADER_ONLY
+#endif
+
+#include "LogicGenerator.h"
+#include "Tools/Philox.h"
+
+#include <random>
+#include <cerrno>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace LogicGeneratorDetail {
+
+  /// make_directories
+  ///   Create "path" and its missing parents (as mkdir -p)
+  inline void
+  make_directories ( std::string const& path ) {
+    for ( uint64_t i = 1; i <= path . size (); ++ i ) {
+      if ( i < path . size () && path [ i ] != '/' ) continue;
+      std::string prefix = path . substr ( 0, i );
+#ifdef _WIN32
+      int status = _mkdir ( prefix . c_str () );
+#else
+      int status = mkdir ( prefix . c_str (), 0755 );
+#endif
+      if ( status != 0 && errno != EEXIST ) {
+        throw std::runtime_error ( "Could not create directory " + prefix );
+      }
+    }
+  }
+
+  /// read_codes
+  ///   Read the hex codes of the file "filename" into "codes", and return
+  ///   false if it cannot be opened
+  inline bool
+  read_codes ( std::string const& filename, std::vector<std::string> & codes ) {
+    std::ifstream infile ( filename );
+    if ( not infile . good () ) return false;
+    codes . clear ();
+    std::string line;
+    while ( std::getline ( infile, line ) ) codes . push_back ( line );
+    return true;
+  }
+
+  /// Registry
+  ///   Resources generated by the process, by name, so that each one is
+  ///   generated once even if it cannot be cached. "mutex" only guards the
+  ///   maps; a resource is read or generated holding the mutex of its
+  ///   node type (the resource name without "_E"), so that different node
+  ///   types are generated concurrently.
+  struct Registry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::vector<std::string>> resources;
+    std::unordered_map<std::string, std::shared_ptr<std::mutex>> generating;
+  };
+
+  inline Registry &
+  registry ( void ) {
+    static Registry result;
+    return result;
+  }
+}
+
+INLINE_IF_HEADER_ONLY LogicGenerator::
+LogicGenerator ( void ) {
+  data_ . reset ( new LogicGenerator_ );
+  data_ -> n_ = data_ -> m_ = 0;
+  data_ -> generated_ = false;
+}
+
+INLINE_IF_HEADER_ONLY LogicGenerator::
+LogicGenerator ( uint64_t n, uint64_t m, std::vector<uint64_t> const& logic ) {
+  assign ( n, m, logic );
+}
+
+INLINE_IF_HEADER_ONLY void LogicGenerator::
+assign ( uint64_t n, uint64_t m, std::vector<uint64_t> const& logic ) {
+  uint64_t total = 0;
+  for ( uint64_t k : logic ) total += k;
+  if ( total != n || std::count ( logic . begin (), logic . end (), 0 ) ) {
+    throw std::invalid_argument ( "LogicGenerator: the logic is not a partition of the inputs" );
+  }
+  if ( m == 0 ) {
+    throw std::invalid_argument ( "LogicGenerator: a node type has at least one output" );
+  }
+  data_ . reset ( new LogicGenerator_ );
+  data_ -> n_ = n;
+  data_ -> m_ = m;
+  data_ -> logic_ = logic;
+  data_ -> generated_ = false;
+}
+
+INLINE_IF_HEADER_ONLY std::string LogicGenerator::
+name ( bool essential ) const {
+  std::stringstream ss;
+  ss << data_ -> n_ << "_" << data_ -> m_;
+  for ( uint64_t k : data_ -> logic_ ) ss << "_" << k;
+  if ( essential ) ss << "_E";
+  return ss . str ();
+}
+
+INLINE_IF_HEADER_ONLY double LogicGenerator::
+estimate ( uint64_t samples, uint64_t seed ) const {
+  int64_t n = data_ -> n_;
+  int64_t m = data_ -> m_;
+  if ( n == 0 ) return m + 1;
+  int64_t N = 1LL << n;
+  std::vector<int64_t> logic ( data_ -> logic_ . begin (), data_ -> logic_ . end () );
+  MonotonicMap map ( n, m, logic );
+  PhiloxStream uniform ( seed, 0, 0 );
+  std::vector<double> L ( n ), U ( n ), T ( m ), values ( N );
+  std::unordered_map<std::string, uint64_t> frequency;
+  for ( uint64_t s = 0; s < samples; ++ s ) {
+    for ( int64_t k = 0; k < n; ++ k ) {
+      L [ k ] = uniform ();
+      U [ k ] = uniform ();
+      if ( L [ k ] > U [ k ] ) std::swap ( L [ k ], U [ k ] );
+    }
+    // Input k of the logic is bit n-1-k of the domain (see MonotonicMap)
+    for ( int64_t i = 0; i < N; ++ i ) {
+      double product = 1.0;
+      int64_t k = 0;
+      for ( int64_t summands : logic ) {
+        double sum = 0.0;
+        for ( int64_t t = 0; t < summands; ++ t, ++ k ) {
+          sum += ( i & ( 1LL << ( n - 1 - k ) ) ) ? U [ k ] : L [ k ];
+        }
+        product *= sum;
+      }
+      values [ i ] = product;
+    }
+    // Thresholds from slightly below the least to slightly above the
+    // greatest value
+    double low = values [ 0 ];
+    double high = values [ N - 1 ];
+    for ( int64_t j = 0; j < m; ++ j ) {
+      T [ j ] = low + ( high - low ) * ( 1.2 * uniform () - 0.1 );
+    }
+    for ( int64_t i = 0; i < N; ++ i ) {
+      map . bin_ [ i ] = std::count_if ( T . begin (), T . end (), [&] ( double t ) { return t < values [ i ]; } );
+    }
+    ++ frequency [ map . hex () ];
+  }
+  // Chao1 (bias-corrected)
+  double f1 = 0, f2 = 0;
+  for ( auto const& item : frequency ) {
+    if ( item . second == 1 ) ++ f1;
+    if ( item . second == 2 ) ++ f2;
+  }
+  return frequency . size () + f1 * ( f1 - 1 ) / ( 2 * ( f2 + 1 ) );
+}
+
+INLINE_IF_HEADER_ONLY void LogicGenerator::
+generate ( uint64_t num_threads, std::function<void(uint64_t)> const& progress ) {
+  int64_t n = data_ -> n_;
+  int64_t m = data_ -> m_;
+  std::vector<std::string> & codes = data_ -> codes_;
+  std::vector<std::string> & essential_codes = data_ -> essential_codes_;
+  codes . clear ();
+  essential_codes . clear ();
+  if ( num_threads == 0 ) num_threads = std::max<uint64_t> ( 1, std::thread::hardware_concurrency () );
+  std::vector<int64_t> logic ( data_ -> logic_ . begin (), data_ -> logic_ . end () );
+  // MonotonicMap::realizable is exact for the sums, the products, and the
+  // products of a variable and a sum of two variables, only
+  int64_t largest = logic . empty () ? 0 : *std::max_element ( logic . begin (), logic . end () );
+  bool exact = logic . size () <= 1 || largest == 1 ||
+               ( logic . size () == 2 && std::min ( logic [ 0 ], logic [ 1 ] ) == 1 && largest == 2 );
+  if ( not exact ) {
+    throw std::logic_error ( "LogicGenerator: no exact realizability test for the logic of " + name () );
+  }
+  if ( n == 0 ) {
+    // The constant maps, all considered essential
+    MonotonicMap map ( 0, m, logic );
+    for ( int64_t k = 0; k <= m; ++ k ) {
+      map . bin_ [ 0 ] = k;
+      codes . push_back ( map . hex () );
+    }
+    essential_codes = codes;
+  } else {
+    FactorGraph graph;
+    std::function<void(int64_t)> report;
+    if ( progress ) report = [&] ( int64_t size ) { progress ( size ); };
+    graph . construct ( MonotonicMap ( n, m, logic ),
+                        [num_threads] () { return (int64_t) num_threads; },
+                        report );
+    for ( uint64_t v = 0; v < graph . size (); ++ v ) {
+      MonotonicMap vertex = graph . vertex ( v );
+      if ( vertex . essential () ) essential_codes . push_back ( vertex . hex () );
+      codes . push_back ( vertex . hex () );
+    }
+  }
+  std::sort ( codes . begin (), codes . end () );
+  std::sort ( essential_codes . begin (), essential_codes . end () );
+  data_ -> generated_ = true;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<std::string> const& LogicGenerator::
+codes ( bool essential ) const {
+  if ( not data_ -> generated_ ) {
+    throw std::logic_error ( "LogicGenerator: resource " + name () + " not generated" );
+  }
+  return essential ? data_ -> essential_codes_ : data_ -> codes_;
+}
+
+INLINE_IF_HEADER_ONLY void LogicGenerator::
+save ( std::string const& directory ) const {
+  LogicGeneratorDetail::make_directories ( directory );
+  std::random_device device;
+  for ( bool essential : { false, true } ) {
+    // Write to a temporary file first, so that readers never see a
+    // partially written resource
+    std::string filename = directory + "/" + name ( essential ) + ".dat";
+    std::string temporary = filename + "." + std::to_string ( device () ) + ".tmp";
+    {
+      std::ofstream outfile ( temporary );
+      for ( auto const& code : codes ( essential ) ) outfile << code << "\n";
+      if ( not outfile . good () ) {
+        std::remove ( temporary . c_str () );
+        throw std::runtime_error ( "Could not write logic resource " + filename );
+      }
+    }
+    if ( std::rename ( temporary . c_str (), filename . c_str () ) != 0 ) {
+      std::remove ( temporary . c_str () );
+      throw std::runtime_error ( "Could not write logic resource " + filename );
+    }
+  }
+}
+
+INLINE_IF_HEADER_ONLY std::vector<std::string> LogicGenerator::
+resource ( uint64_t n, uint64_t m, std::vector<uint64_t> const& logic, bool essential ) {
+  using namespace LogicGeneratorDetail;
+  std::string resource_name = std::to_string ( n ) + "_" + std::to_string ( m );
+  for ( uint64_t k : logic ) resource_name += "_" + std::to_string ( k );
+  if ( essential ) resource_name += "_E";
+  try {
+    LogicGenerator generator ( n, m, logic );
+    Registry & generated = registry ();
+    std::shared_ptr<std::mutex> node_type_mutex;
+    {
+      std::lock_guard<std::mutex> lock ( generated . mutex );
+      auto it = generated . resources . find ( resource_name );
+      if ( it != generated . resources . end () ) return it -> second;
+      auto & entry = generated . generating [ generator . name ( false ) ];
+      if ( not entry ) entry . reset ( new std::mutex );
+      node_type_mutex = entry;
+    }
+    std::lock_guard<std::mutex> node_type_lock ( * node_type_mutex );
+    {
+      // Another thread may have read or generated it in the meantime
+      std::lock_guard<std::mutex> lock ( generated . mutex );
+      auto it = generated . resources . find ( resource_name );
+      if ( it != generated . resources . end () ) return it -> second;
+    }
+    std::string cache = configuration () -> get_cache_path ();
+    std::vector<std::string> result;
+    if ( not cache . empty () && read_codes ( cache + "/logic/" + resource_name + ".dat", result ) ) {
+      std::lock_guard<std::mutex> lock ( generated . mutex );
+      return generated . resources [ resource_name ] = result;
+    }
+    if ( not configuration () -> get_generate_logic () ) {
+      std::stringstream ss;
+      ss << "generating logic resources is disabled (see Configuration::set_generate_logic); "
+         << "an estimated " << (uint64_t) generator . estimate () << " hex codes would be generated";
+      throw std::runtime_error ( ss . str () );
+    }
+    generator . generate ();
+    if ( not cache . empty () ) {
+      // Caching is best effort
+      try {
+        generator . save ( cache + "/logic" );
+      } catch ( std::exception const& ) {}
+    }
+    {
+      std::lock_guard<std::mutex> lock ( generated . mutex );
+      generated . resources [ generator . name ( false ) ] = generator . codes ( false );
+      generated . resources [ generator . name ( true ) ] = generator . codes ( true );
+    }
+    return generator . codes ( essential );
+  } catch ( std::exception const& e ) {
+    throw std::runtime_error ( "Error: Could not find logic resource " + resource_name +
+                               " and could not generate it: " + e . what () + "\n" );
+  }
+}
+
+INLINE_IF_HEADER_ONLY std::vector<std::string> LogicGenerator::
+missing ( Network const& network ) {
+  std::string path = configuration () -> get_path () + "/logic/";
+  std::string cache = configuration () -> get_cache_path ();
+  std::vector<std::string> result;
+  for ( uint64_t d = 0; d < network . size (); ++ d ) {
+    uint64_t n = network . inputs ( d ) . size ();
+    uint64_t m = network . outputs ( d ) . size () ? network . outputs ( d ) . size () : 1;
+    std::vector<uint64_t> logic;
+    for ( auto const& factor : network . logic ( d ) ) logic . push_back ( factor . size () );
+    std::string resource_name = LogicGenerator ( n, m, logic ) . name ( network . essential ( d ) );
+    if ( std::find ( result . begin (), result . end (), resource_name ) != result . end () ) continue;
+    if ( std::ifstream ( path + resource_name + ".dat" ) . good () ) continue;
+    if ( not cache . empty () && std::ifstream ( cache + "/logic/" + resource_name + ".dat" ) . good () ) continue;
+    result . push_back ( resource_name );
+  }
+  return result;
+}
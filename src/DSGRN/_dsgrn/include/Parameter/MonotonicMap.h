@@ -0,0 +1,681 @@
+/// MonotonicMap.h
+/// Author: Shaun Harker
+/// Date: August 20, 2014
+
+#ifndef MONOTONICMAP_H
+#define MONOTONICMAP_H
+
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <memory>
+
+/// class MonotonicMap
+/// a "smart vertex" class representing the dynamics of a node of
+/// a boolean switching network
+class MonotonicMap {
+public:
+  // data
+  int64_t n; // number of in edges  -- domain is {0,1,...,2^n-1}
+  int64_t m; // number of out edges -- codomain is {0,1,...,m}
+
+  /// logic_
+  ///    An expression of the form (a+b+c)(d+e)f(g+h)
+  ///    would be encoded as vector of ints 3,2,1,2 (the number of summands in each
+  ///    factor). Up-regulation and down-regulation are of no concern here (they are
+  ///    treated elsewhere)
+  ///    The entries in logic_ line up to the bits in the domain of bin_
+  ///    in such a way that the last entry of logic_ corresponds to the least
+  ///    significant bit of bin_'s domain.
+  std::vector< int64_t> logic_; // logic
+  
+  /// bin_
+  ///    bin_ is an array storing the values of
+  ///    a map from {0,1,...2^n-1} -> {0,1,...m}
+  std::vector< int64_t > bin_;  // mapping
+
+  /// constraints_
+  ///    constraints_ is an array storing value of the form (m, (x,y)),
+  ///    where m, x, and y are int64_t.
+  ///    The effect of an item in constraints_ is to enforce extra
+  ///    realizability conditions
+  ///    bin_[a] < bin_[b]  whenever (a & ~m ) == (b & ~m)  and (a&m == x) and (b&m == y)
+  std::vector<std::pair<int64_t,std::pair<int64_t, int64_t>>> constraints_;
+
+  // constructors
+  MonotonicMap ( void ) {}
+  MonotonicMap ( int64_t n, int64_t m ) : n(n), m(m) {
+    bin_ . resize ( (1 << n), 0 );
+    logic_ . resize ( 1, n ); // all-sum by default
+  }
+  MonotonicMap ( int64_t n, int64_t m, std::vector<int64_t> const& logic ): n(n), m(m), logic_(logic) {
+    bin_ . resize ( (1 << n), 0 );
+  }
+  MonotonicMap ( int64_t n, int64_t m, 
+                 std::vector<int64_t> const& logic, 
+                 std::vector<std::pair<int64_t,std::pair<int64_t,int64_t>>> const& constraints )
+  : n(n), m(m), logic_(logic), constraints_(constraints) {
+    bin_ . resize ( (1 << n), 0 );
+  }
+  MonotonicMap ( int64_t n, 
+                 int64_t m, 
+                 std::vector<int64_t> const& logic, 
+                 std::vector<std::pair<int64_t,std::pair<int64_t,int64_t>>> const& constraints,
+                 std::vector<int64_t> const& data )
+    : n(n), m(m), logic_(logic), bin_(data), constraints_(constraints) {}
+
+  // Check if monotonic
+  bool monotonic ( void ) const {
+    int64_t N = (1 << n);
+    if ( n <= 6 ) {
+      // Each up-set { i : bin_[i] >= t } is closed under setting a bit
+      std::vector<Bits> upsets = thresholds ();
+      for ( int64_t t = 1; t <= m; ++ t ) {
+        for ( int64_t pos = 0; pos < n; ++ pos ) {
+          Bits set = upsets [ t ];
+          if ( ( ( set & lower ( pos ) ) << ( 1 << pos ) ) & ~ set ) return false;
+        }
+      }
+      return true;
+    }
+    for ( int64_t i = 0; i < N; ++ i ) {
+      for ( int64_t pos = 0; pos < n; ++ pos ) {
+        int64_t bit = 1 << pos;
+        if ( not ( i & bit ) && bin_[i|bit] < bin_[i] ) return false;
+      }
+    }
+    return true;
+  }
+
+  /// monotonic_at
+  ///   Return monotonic(), given that a map which differs from this one
+  ///   only in bin_[i] is monotonic
+  bool monotonic_at ( int64_t i ) const {
+    for ( int64_t pos = 0; pos < n; ++ pos ) {
+      int64_t bit = 1 << pos;
+      if ( i & bit ) {
+        if ( bin_[i^bit] > bin_[i] ) return false;
+      } else {
+        if ( bin_[i|bit] < bin_[i] ) return false;
+      }
+    }
+    return true;
+  }
+
+  bool realizable ( void ) const {
+    return realizable_check ( -1 );
+  }
+
+  /// realizable_at
+  ///   Return realizable(), given that a map which differs from this one
+  ///   only in bin_[i] is realizable: only the conditions which involve
+  ///   bin_[i] are checked
+  bool realizable_at ( int64_t i ) const {
+    return realizable_check ( i );
+  }
+
+bool essential ( void ) const {
+  //std::cout << "essential line " << __LINE__ << "\n";
+  int64_t N = (1 << n);
+  // Check that all 0's give 0
+  if ( bin_[0] > 0 ) return false;
+  // Check that all 1's gives m
+  if ( bin_[N-1] < m ) return false;
+  // Check for each dimension that there is a switch that matters
+  std::vector<bool> checks ( n, false );
+  int64_t mask = N - 1;
+  for ( int d = 0; d < n; ++ d ) {
+    int64_t bit = 1 << d;
+    int64_t maskbit = mask ^ bit;
+    for ( int64_t i = 0; i < N; ++ i ) {
+      if ( bin_[i & maskbit] < bin_[i | bit] ) {
+        //std::cout << "dim " << d << " is essential since \n";
+        //std::cout << "bin_[" << (i & maskbit) << "] = " << bin_[i & maskbit] << "\n";
+        //std::cout << "bin_[" << (i | bit) << "] = " << bin_[i | bit] << "\n";
+        checks[d] = true;
+        break;
+      }
+    }
+    if ( checks[d] == false ) return false;
+  }
+  return true;
+}
+
+  // return adjacent monotonic maps
+  std::vector<std::shared_ptr<MonotonicMap> > neighbors ( void ) const {
+    // DEBUG
+    //std::cout << "Calling neighbors of: \n";
+    //for ( int64_t j = 0; j < (1 << n); ++ j ) {
+    //  std::cout << bin_[j] << " ";
+    //}
+    //std::cout << "\n";
+    // END DEBUG
+
+    std::vector<std::shared_ptr<MonotonicMap> > results;
+
+    // Obtain neighbors via changing the monotone function
+    std::vector<int64_t> copy = bin_;
+    int64_t N = (1 << n);
+    for ( int64_t i = 0; i < N; ++ i ) {
+      if ( copy[i] > 0 ) {
+        -- copy[i];
+        std::shared_ptr<MonotonicMap> new_map ( new MonotonicMap ( n, m, logic_, constraints_, copy ) );
+        if ( new_map -> monotonic () && new_map -> realizable () ) {
+          results . push_back ( new_map );
+          //std::cout << "Found neighbor: ";
+          //for ( int64_t j = 0; j < N; ++ j ) {
+          //  std::cout << copy[j] << " ";
+          //}
+          //std::cout << "\n";
+        }
+        ++ copy[i];
+      }
+      if ( copy[i] < m ) {
+        ++ copy[i];
+        std::shared_ptr<MonotonicMap> new_map ( new MonotonicMap ( n, m, logic_, constraints_, copy ) );
+        if ( new_map -> monotonic () && new_map -> realizable () ) {
+          results . push_back ( new_map );
+          //std::cout << "Found neighbor: ";
+          //for ( int64_t j = 0; j < N; ++ j ) {
+          //  std::cout << copy[j] << " ";
+          //}
+          //std::cout << "\n";          
+        }
+        -- copy[i];
+      }
+    }
+
+    return results;
+  }
+
+  /// bits_per_bin
+  ///   Return the number of bits of a value of bin_ in a packed key
+  int64_t bits_per_bin ( void ) const {
+    int64_t bits = 1;
+    while ( ( 1LL << bits ) <= m ) ++ bits;
+    return bits;
+  }
+
+  /// values_per_word
+  ///   Return the number of values of bin_ in each word of a packed key
+  int64_t values_per_word ( void ) const {
+    return 64 / bits_per_bin ();
+  }
+
+  /// key_size
+  ///   Return the number of 64-bit words of a packed key
+  int64_t key_size ( void ) const {
+    int64_t per_word = values_per_word ();
+    return ( ( 1LL << n ) + per_word - 1 ) / per_word;
+  }
+
+  /// packable
+  ///   Return true if the map fits in a single-word packed key
+  bool packable ( void ) const {
+    return key_size () == 1;
+  }
+
+  /// WideKey
+  ///   A packed key of key_size() words, for the maps which are not
+  ///   packable(): bin_[i] is in word i / values_per_word(), and the
+  ///   words are laid out as single-word keys
+  typedef std::vector<uint64_t> WideKey;
+
+  /// WideKeyHash
+  ///   Hash of a WideKey, for unordered containers
+  struct WideKeyHash {
+    std::size_t operator () ( WideKey const& key ) const {
+      uint64_t result = key . size ();
+      for ( uint64_t word : key ) {
+        result ^= word + 0x9e3779b97f4a7c15ULL + ( result << 6 ) + ( result >> 2 );
+      }
+      return result;
+    }
+  };
+
+  /// key
+  ///   Return the map packed into an integer, bits_per_bin() bits per
+  ///   value of bin_, bin_[0] in the least significant bits
+  ///   (requires packable())
+  uint64_t key ( void ) const {
+    uint64_t result = 0;
+    pack ( result );
+    return result;
+  }
+
+  /// wide_key
+  ///   Return the map packed into key_size() words (see WideKey)
+  WideKey wide_key ( void ) const {
+    WideKey result ( key_size (), 0 );
+    pack ( result );
+    return result;
+  }
+
+  /// assign_key
+  ///   Set bin_ from a packed key (see key)
+  void assign_key ( uint64_t key ) {
+    unpack ( key );
+  }
+
+  /// assign_key
+  ///   Set bin_ from a packed key of several words (see wide_key)
+  void assign_key ( WideKey const& key ) {
+    unpack ( key );
+  }
+
+  /// adjacent_keys
+  ///   Return the keys of the maps obtained by decreasing or increasing
+  ///   one value of bin_, in the order of neighbors (which keeps those
+  ///   that are monotonic and realizable). If "changed" is given, the
+  ///   position in bin_ of the value changed in each key is stored in it.
+  ///   (requires packable())
+  std::vector<uint64_t> adjacent_keys ( std::vector<int64_t> * changed = nullptr ) const {
+    return adjacent ( key (), changed );
+  }
+
+  /// adjacent_wide_keys
+  ///   Return the packed keys of several words of the maps obtained by
+  ///   decreasing or increasing one value of bin_ (see adjacent_keys)
+  std::vector<WideKey> adjacent_wide_keys ( std::vector<int64_t> * changed = nullptr ) const {
+    return adjacent ( wide_key (), changed );
+  }
+
+  bool operator == ( const MonotonicMap & rhs ) const {
+    if ( n != rhs . n ) return false;
+    if ( m != rhs . m ) return false;
+    int64_t N = (1 << n);
+    for ( int64_t i = 0; i < N; ++ i ) {
+      if ( bin_[i] != rhs.bin_[i] ) return false;
+    }
+    return true;
+  }
+
+  /// hex 
+  ///   Return a hex code X which represents the parameter. The 
+  ///   hex code represents a binary string in big-endian fashion. 
+  ///   For 0 <= i < 2^n and 0 <= j < m, let b_{ij} be the
+  ///   the (i*m + j)th binary digit of X (where the 0th digit is
+  ///   the least significant).
+  ///   Then b_{ij} = 1 if input i activates output j
+  ///        b_{ij} = 0    otherwise
+  std::string hex ( void ) const {
+    std::string X;
+    int64_t N = ( 1 << n );
+    char nybble = 0, mask = 1;
+    auto flush_nybble = [&] () { 
+      // Hex digits 0-9
+      if ( nybble < 10 ) X.push_back((char)(nybble + '0'));
+      // Hex digits A-F
+      else X.push_back((char)(nybble - 10 + 'A'));
+      nybble = 0; mask = 1;
+    };
+    for ( int64_t i = 0; i < N; ++ i ) {
+      for ( int64_t j = 0; j < m; ++ j ) {
+        if ( bin_[i] > j ) nybble |= mask;
+        mask <<= 1; if ( mask == 16 ) flush_nybble();
+      }
+    }
+    if ( mask != 1 ) flush_nybble ();
+    // Put into big-endian form.
+    std::reverse( X . begin(), X . end () );
+    return X;
+  }
+
+  /// prettyPrint
+  ///   return string corresponding to monotonic map
+  std::string prettyPrint ( std::string const& symbol,
+                            std::vector<std::string> const& input_symbols,
+                            std::vector<std::string> const& output_symbols ) const {
+    if ( (int64_t) input_symbols . size () != n ) {
+      throw std::logic_error ( "MonotonicMap::prettyPrint: " + std::to_string ( input_symbols . size () ) +
+                               " input symbols for n = " + std::to_string ( n ) + " inputs\n" );
+    }
+    if ( (int64_t) output_symbols . size () != m ) {
+      throw std::logic_error ( "MonotonicMap::prettyPrint: " + std::to_string ( output_symbols . size () ) +
+                               " output symbols for m = " + std::to_string ( m ) + " outputs\n" );
+    }
+    std::stringstream ss;
+    int64_t N = (1 << n);
+    for ( int64_t i = 0; i < N; ++ i ) { 
+      int64_t bin = bin_[i];
+      if ( bin > 0 ) {
+        ss << "THETA(" << symbol << ", " << output_symbols[bin-1] << ") <= "; 
+      }
+      int64_t count = 0;
+      for ( int64_t j = 0; j < (int64_t) logic_ . size (); ++ j ) {
+        ss << "(";
+        for ( int64_t k = 0; k < logic_[j]; ++ k ) {
+          if ( (i & ( 1 << count )) == 0 ) {
+            ss << "L(";
+          } else {
+            ss << "U(";
+          }
+          ss << input_symbols [ count ++ ] << ", " << symbol << ")";
+          if ( k != logic_[j]-1 ) ss << " + ";
+        }
+        ss << ")";
+      }
+      if ( bin < m ) {
+        ss << " <= THETA(" << symbol << ", " << output_symbols[bin] << ")"; 
+      }
+      ss << ";\n";
+    }
+    return ss . str ();
+  }
+
+  friend std::ostream & operator << ( std::ostream & stream, 
+                                      const MonotonicMap & print_me ) {
+    stream << print_me.hex ();
+    /*
+    stream << "{(In,Out)=(" << print_me . n << ", " << print_me . m << "), Logic=(";
+    for ( int64_t i = 0; i < print_me . logic_ . size (); ++ i ) { 
+      if ( i != 0 ) stream << ",";
+      stream << print_me . logic_[i];
+    }
+    stream << "), Data=(";
+    for ( int64_t i = 0; i < print_me . bin_ . size (); ++ i ) { 
+      if ( i != 0 ) stream << ",";
+      stream << print_me . bin_[i];
+    }
+    stream << ")}";
+    */
+    return stream;
+  }
+
+private:
+  /// word
+  ///   Return word w of a packed key
+  static uint64_t & word ( uint64_t & key, int64_t ) { return key; }
+  static uint64_t word ( uint64_t const& key, int64_t ) { return key; }
+  static uint64_t & word ( WideKey & key, int64_t w ) { return key [ w ]; }
+  static uint64_t word ( WideKey const& key, int64_t w ) { return key [ w ]; }
+
+  /// pack
+  ///   Write bin_ into a zeroed packed key
+  template < class Key >
+  void pack ( Key & key ) const {
+    int64_t bits = bits_per_bin ();
+    int64_t per_word = values_per_word ();
+    int64_t N = (1 << n);
+    for ( int64_t i = 0; i < N; ++ i ) {
+      word ( key, i / per_word ) |= (uint64_t) bin_[i] << ( ( i % per_word ) * bits );
+    }
+  }
+
+  /// unpack
+  ///   Set bin_ from a packed key
+  template < class Key >
+  void unpack ( Key const& key ) {
+    int64_t bits = bits_per_bin ();
+    int64_t per_word = values_per_word ();
+    int64_t N = (1 << n);
+    uint64_t mask = ( 1ULL << bits ) - 1;
+    bin_ . resize ( N );
+    for ( int64_t i = 0; i < N; ++ i ) {
+      bin_[i] = ( word ( key, i / per_word ) >> ( ( i % per_word ) * bits ) ) & mask;
+    }
+  }
+
+  /// adjacent
+  ///   Return the keys adjacent to k, the packed key of this map
+  ///   (see adjacent_keys)
+  template < class Key >
+  std::vector<Key> adjacent ( Key const& k, std::vector<int64_t> * changed ) const {
+    std::vector<Key> results;
+    if ( changed ) changed -> clear ();
+    int64_t bits = bits_per_bin ();
+    int64_t per_word = values_per_word ();
+    int64_t N = (1 << n);
+    for ( int64_t i = 0; i < N; ++ i ) {
+      uint64_t unit = 1ULL << ( ( i % per_word ) * bits );
+      if ( bin_[i] > 0 ) {
+        results . push_back ( k );
+        word ( results . back (), i / per_word ) -= unit;
+        if ( changed ) changed -> push_back ( i );
+      }
+      if ( bin_[i] < m ) {
+        results . push_back ( k );
+        word ( results . back (), i / per_word ) += unit;
+        if ( changed ) changed -> push_back ( i );
+      }
+    }
+    return results;
+  }
+
+  /// Bits
+  ///   A subset of the domain {0,1,...,2^n-1}, one bit per element
+  ///   (for n <= 6)
+  typedef uint64_t Bits;
+
+  /// lower
+  ///   Return the elements of the domain whose bit "pos" is off
+  static Bits lower ( int64_t pos ) {
+    static const Bits masks [ 6 ] = { 0x5555555555555555ULL, 0x3333333333333333ULL,
+                                      0x0F0F0F0F0F0F0F0FULL, 0x00FF00FF00FF00FFULL,
+                                      0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL };
+    return masks [ pos ];
+  }
+
+  /// translate
+  ///   Return the set { i ^ c : i in set }
+  Bits translate ( Bits set, int64_t c ) const {
+    for ( int64_t pos = 0; pos < n; ++ pos ) {
+      if ( not ( c & ( 1 << pos ) ) ) continue;
+      int64_t shift = 1 << pos;
+      set = ( ( set & lower ( pos ) ) << shift ) | ( ( set >> shift ) & lower ( pos ) );
+    }
+    return set;
+  }
+
+  /// subsets
+  ///   Return the set of the elements of the domain contained in I
+  Bits subsets ( int64_t I ) const {
+    Bits result = 0;
+    for ( int64_t a = I; ; a = ( a - 1 ) & I ) {
+      result |= 1ULL << a;
+      if ( a == 0 ) break;
+    }
+    return result;
+  }
+
+  /// thresholds
+  ///   Return the up-sets { i : bin_[i] >= t } for t = 0, 1, ..., m+1
+  std::vector<Bits> thresholds ( void ) const {
+    int64_t N = (1 << n);
+    std::vector<Bits> result ( m + 2, 0 );
+    for ( int64_t i = 0; i < N; ++ i ) result [ bin_[i] ] |= 1ULL << i;
+    for ( int64_t t = m; t >= 0; -- t ) result [ t ] |= result [ t + 1 ];
+    return result;
+  }
+
+  /// Rows
+  ///   Comparison matrices of the values of bin_: bit y of greater[x]
+  ///   is set iff bin_[x] > bin_[y], and of less[x] iff bin_[x] < bin_[y]
+  struct Rows {
+    Bits greater [ 64 ];
+    Bits less [ 64 ];
+  };
+
+  void comparisons ( Rows & rows ) const {
+    int64_t N = (1 << n);
+    std::vector<Bits> upsets = thresholds ();
+    for ( int64_t x = 0; x < N; ++ x ) {
+      rows . less [ x ] = upsets [ bin_[x] + 1 ];
+      rows . greater [ x ] = upsets [ 0 ] & ~ upsets [ bin_[x] ];
+    }
+  }
+
+  /// consistent
+  ///   Return true if the restrictions of the map to the elements a and b
+  ///   of the domain contained in I compare consistently, i.e. there is no
+  ///   c in the complement of I with bin_[a|c] < bin_[b|c] and c' with
+  ///   bin_[a|c'] > bin_[b|c']. Only a = "only" is considered if it is not
+  ///   -1. The comparisons of the rows a|c, c in the complement of I, are
+  ///   translated by c and accumulated, which leaves the comparisons with
+  ///   the elements b|c at position b.
+  bool consistent ( Rows const& rows, int64_t I, int64_t only = -1 ) const {
+    int64_t N = (1 << n);
+    int64_t C = ( N - 1 ) & ~ I;
+    Bits domain = subsets ( I );
+    for ( int64_t a = I; ; a = ( a - 1 ) & I ) {
+      if ( only == -1 || a == only ) {
+        Bits less = 0, greater = 0;
+        for ( int64_t c = C; ; c = ( c - 1 ) & C ) {
+          less |= translate ( rows . less [ a | c ], c );
+          greater |= translate ( rows . greater [ a | c ], c );
+          if ( c == 0 ) break;
+        }
+        if ( less & greater & domain ) return false;
+      }
+      if ( a == 0 ) break;
+    }
+    return true;
+  }
+
+  /// realizable_check
+  ///   Check realizability; if i is not -1, only the conditions which
+  ///   involve bin_[i] (see realizable_at)
+  bool realizable_check ( int64_t i ) const {
+    int64_t N = (1 << n);
+    // Step 1. Check constraints: for each r with (r & mask) == 0,
+    // bin_[r|x] <= bin_[r|y]
+    for ( std::pair<int64_t, std::pair<int64_t, int64_t>> const& constraint : constraints_ ) {
+      int64_t const& mask = constraint . first;
+      int64_t const& x = constraint . second . first;
+      int64_t const& y = constraint . second . second;
+      if ( ( x & ~ ( mask & ( N - 1 ) ) ) || ( y & ~ ( mask & ( N - 1 ) ) ) ) continue;
+      int64_t R = ( N - 1 ) & ~ mask;
+      for ( int64_t r = R; ; r = ( r - 1 ) & R ) {
+        bool involved = ( i == -1 ) || ( (r|x) == i ) || ( (r|y) == i );
+        if ( involved && bin_[r|x] > bin_[r|y] ) return false;
+        if ( r == 0 ) break;
+      }
+    }
+    // Step 2. Other realizability conditions
+    int64_t max_terms_in_factor = 0;
+    for ( int64_t k = 0; k < (int64_t) logic_ . size (); ++ k ) {
+      max_terms_in_factor = std::max ( max_terms_in_factor, logic_[k] );
+    }
+
+    if ( (logic_ . size () == 1) || (max_terms_in_factor == 1) ) {
+      // Case (n) (all sum case) or Case (1,1,1,1...,1) (n-times, all product case):
+      // for each subset I of the inputs, the restrictions to I compare consistently
+      if ( n <= 6 ) {
+        Rows rows;
+        comparisons ( rows );
+        for ( int64_t I = 0; I < N; ++ I ) {
+          if ( not consistent ( rows, I, ( i == -1 ) ? -1 : ( i & I ) ) ) return false;
+        }
+        return true;
+      }
+      // Larger domains, directly
+      for ( int64_t I = 0; I < N; ++ I ) {
+        for ( int64_t a = 0; a < N; ++ a ) {
+          if ( (a & I) != a ) continue;
+          for ( int64_t b = 0; b < N; ++ b ) {
+            if ( (b & I) != b ) continue;
+            bool less = false;
+            bool greater = false;
+            for ( int64_t c = 0; c < N; ++ c ) {
+              if ( (c & I ) != 0 ) continue;
+              int64_t x = bin_[a|c];
+              int64_t y = bin_[b|c];
+              if ( x < y ) less = true;
+              if ( x > y ) greater = true;
+              if ( less && greater ) return false;
+            }
+          }
+        }
+      }
+      return true;
+    } else if ( logic_ . size () == 2 ) {
+      if ( logic_[0] == 2 && logic_[1] == 1 ) {
+        // Case (2, 1)  (a+b)c
+        // The a,b,c is encoded bitwise as cba (i.e. "a" is least sig. bit)
+        // In this notation the rules for sum-product are
+        // " 010 < 100 implies 011 <= 101 "  (Rule A)
+        // " 001 < 100 implies 011 <= 110 "  (Rule B)
+        // " 010 > 001 implies 110 >= 101 "  (Rule C)
+        // " 010 < 001 implies 110 <= 101 "  (Rule C, reversed)
+        int64_t D001 = bin_[1];
+        int64_t D010 = bin_[2];
+        int64_t D011 = bin_[3];
+        int64_t D100 = bin_[4];
+        int64_t D101 = bin_[5];
+        int64_t D110 = bin_[6]; 
+
+        if ( (D010 < D100) && not (D011 <= D101) ) return false;
+        if ( (D001 < D100) && not (D011 <= D110) ) return false;
+        if ( (D010 > D001) && not (D110 >= D101) ) return false;
+        if ( (D010 < D001) && not (D110 <= D101) ) return false;
+        return true;
+      }
+      if ( logic_[0] == 1 && logic_[1] == 2 ) {
+        // Case (1,2). Symmetric to case (2,1). (We just rotate the bits)
+        int64_t D001 = bin_[1];
+        int64_t D010 = bin_[2];
+        int64_t D011 = bin_[3];
+        int64_t D100 = bin_[4];
+        int64_t D101 = bin_[5];
+        int64_t D110 = bin_[6]; 
+
+        if ( (D100 < D001) && not (D110 <= D011) ) return false;
+        if ( (D010 < D001) && not (D110 <= D101) ) return false;
+        if ( (D100 > D010) && not (D101 >= D011) ) return false;
+        if ( (D100 < D010) && not (D101 <= D011) ) return false;
+        return true;     
+      }
+      if ( logic_[0] == 2 && logic_[1] == 2 ) {
+        // Case (2,2). "(a+b)(c+d)"
+        Rows rows;
+        comparisons ( rows );
+        // Slice Conditions: bin_[x] < bin_[y] implies bin_[u] <= bin_[v]
+        // where y and u exchange the bits of x and v outside a slice, i.e.
+        // the restrictions to the complement of the slice compare consistently
+        std::vector<int64_t> slices = { 0b1100, 0b0011, 0b1011, 0b0111, 0b1101, 0b1110 };
+        for ( int64_t slice : slices ) {
+          int64_t I = 0b1111 & ~ slice;
+          if ( not consistent ( rows, I, ( i == -1 ) ? -1 : ( i & I ) ) ) return false;
+        }
+        // Promotion Condition: if bin_[x] < bin_[y] and the restrictions of
+        // x and y to a factor slice compare the other way somewhere, setting
+        // a bit of the slice which is off in x and y keeps bin_[x] <= bin_[y]
+        std::vector<int64_t> factorslices = { 0b1100, 0b0011 };
+        for ( int64_t slice : factorslices ) {
+          int64_t Z = 0b1111 & ~ slice;
+          for ( int64_t x = 0; x < 16; ++ x ) {
+            // The y with f_{slice}(x) > f_{slice}(y) somewhere
+            Bits restricted = 0;
+            for ( int64_t z = Z; ; z = ( z - 1 ) & Z ) {
+              restricted |= translate ( rows . greater [ (x & slice) | z ], z );
+              if ( z == 0 ) break;
+            }
+            restricted &= subsets ( slice );
+            Bits candidates = 0;
+            for ( int64_t y = 0; y < 16; ++ y ) {
+              if ( restricted & ( 1ULL << ( y & slice ) ) ) candidates |= 1ULL << y;
+            }
+            candidates &= rows . less [ x ];
+            for ( int64_t pos = 0; pos < 4; ++ pos ) {
+              int64_t bit = 1 << pos;
+              if ( not (slice & bit) ) continue;
+              if ( x & bit ) continue;
+              // The y, with the bit off, such that bin_[x|bit] > bin_[y|bit]
+              if ( candidates & lower ( pos ) & translate ( rows . greater [ x | bit ], bit ) ) return false;
+            }
+          }
+        }
+        return true;
+      }
+    } 
+    throw std::logic_error ( "MonotonicMap:: realizability algorithm cannot handle current situation\n");
+    return false;
+  }
+
+};
+
+#endif
@@ -106,6 +106,19 @@ public:
   std::string
   specification ( void ) const;
 
+  /// serialize
+  ///   Return the network in a compact binary form (the specification
+  ///   and the parsed names, logics and edge types), which deserialize
+  ///   reads back without parsing the specification. Used for pickling.
+  std::string
+  serialize ( void ) const;
+
+  /// deserialize
+  ///   Assign the network serialized by serialize. Throws
+  ///   std::runtime_error if "bytes" is not a serialized network.
+  void
+  deserialize ( std::string const& bytes );
+
   /// graphviz
   ///   Return a graphviz string (dot language)
   std::string
@@ -121,8 +134,8 @@ public:
 private:
   std::shared_ptr<Network_> data_;
 
-  std::vector<std::string> _lines ( void );
-  void _parse ( std::vector<std::string> const& lines );
+  void _parse ( void );
+  void _finalize ( void );
 };
 
 struct Network_ {
@@ -165,16 +178,24 @@ NetworkBinding (py::module &m) {
     .def("order", &Network::order)
     .def("domains", &Network::domains)
     .def("specification", &Network::specification)
+    .def("serialize", [](Network const& network){ return py::bytes(network.serialize());})
+    .def("deserialize", [](Network & network, py::bytes const& bytes){ network.deserialize(bytes);})
     .def("graphviz", [](Network const& network){ return network.graphviz();})
     .def(py::pickle(
     [](Network const& p) { // __getstate__
         /* Return a tuple that fully encodes the state of the object */
-        return py::make_tuple(p.specification());
+        return py::make_tuple(py::bytes(p.serialize()));
     },
     [](py::tuple t) { // __setstate__
         if (t.size() != 1)
             throw std::runtime_error("Unpickling Network object: Invalid state!");
         /* Create a new C++ instance */
+        /* Older pickles hold the specification instead of the serialized network */
+        if (py::isinstance<py::bytes>(t[0])) {
+            Network result;
+            result.deserialize(t[0].cast<std::string>());
+            return result;
+        }
         return Network(t[0].cast<std::string>());
     }));
 }
@@ -13,6 +13,96 @@
 
 #include "Network.h"
 
+namespace NetworkDetail {
+
+  /// is_space
+  ///   Return true for the whitespace characters of the "C" locale
+  inline bool
+  is_space ( char c ) {
+    return c == ' ' || ( c >= '\t' && c <= '\r' );
+  }
+
+  /// is_separator
+  ///   Return true for the characters which end a token of a logic
+  ///   expression
+  inline bool
+  is_separator ( char c ) {
+    return is_space ( c ) || c == '(' || c == ')' || c == '+' || c == '~';
+  }
+
+  static char const magic [ 8 ] = { 'D', 'S', 'G', 'R', 'N', 'N', 'E', 'T' };
+
+  /// write
+  ///   Append x to "bytes" as a variable length integer (7 bits per byte,
+  ///   least significant first)
+  inline void
+  write ( std::string & bytes, uint64_t x ) {
+    while ( x >= 0x80 ) {
+      bytes . push_back ( (char) ( ( x & 0x7F ) | 0x80 ) );
+      x >>= 7;
+    }
+    bytes . push_back ( (char) x );
+  }
+
+  /// write
+  ///   Append the length of s and s to "bytes"
+  inline void
+  write ( std::string & bytes, std::string const& s ) {
+    write ( bytes, (uint64_t) s . size () );
+    bytes . append ( s );
+  }
+
+  /// Reader
+  ///   Read back what write appended, throwing on truncated input
+  class Reader {
+  public:
+    Reader ( std::string const& bytes ) : p_ ( bytes . data () ), end_ ( bytes . data () + bytes . size () ) {}
+
+    uint64_t
+    integer ( void ) {
+      uint64_t result = 0;
+      for ( uint64_t shift = 0; shift < 64; shift += 7 ) {
+        if ( p_ == end_ ) fail ();
+        uint8_t byte = (uint8_t) * p_ ++;
+        result |= (uint64_t) ( byte & 0x7F ) << shift;
+        if ( ( byte & 0x80 ) == 0 ) return result;
+      }
+      fail ();
+      return 0;
+    }
+
+    std::string
+    string ( void ) {
+      uint64_t length = integer ();
+      if ( length > (uint64_t) ( end_ - p_ ) ) fail ();
+      std::string result ( p_, p_ + length );
+      p_ += length;
+      return result;
+    }
+
+    bool
+    magic ( void ) {
+      if ( end_ - p_ < 8 || not std::equal ( NetworkDetail::magic, NetworkDetail::magic + 8, p_ ) ) return false;
+      p_ += 8;
+      return true;
+    }
+
+    bool
+    done ( void ) const {
+      return p_ == end_;
+    }
+
+    [[noreturn]] static void
+    fail ( void ) {
+      throw std::runtime_error ( "Network::deserialize: truncated or invalid serialized network" );
+    }
+
+  private:
+    char const* p_;
+    char const* end_;
+  };
+}
+
 INLINE_IF_HEADER_ONLY Network::
 Network ( void ) { 
   data_ . reset ( new Network_ );
@@ -29,7 +119,7 @@ assign ( std::string const& s ) {
   if ( colon != std::string::npos ) {
     data_ . reset ( new Network_ );
     data_ -> specification_ = s;
-    _parse ( _lines () );
+    _parse ();
   } else {
     load(s);
   }
@@ -47,7 +137,7 @@ load ( std::string const& filename ) {
     data_ -> specification_ += line + '\n';
   }
   infile . close ();
-  _parse ( _lines () );
+  _parse ();
 }
 
 INLINE_IF_HEADER_ONLY uint64_t Network::
@@ -119,6 +209,59 @@ specification ( void ) const {
   return data_ -> specification_;
 }
 
+INLINE_IF_HEADER_ONLY std::string Network::
+serialize ( void ) const {
+  using namespace NetworkDetail;
+  std::string result ( magic, magic + 8 );
+  write ( result, data_ -> specification_ );
+  write ( result, pos_edge_blowup () ? 1 : 0 );
+  write ( result, size () );
+  for ( uint64_t target = 0; target < size (); ++ target ) {
+    write ( result, name ( target ) );
+    write ( result, essential ( target ) ? 1 : 0 );
+    write ( result, logic ( target ) . size () );
+    for ( auto const& factor : logic ( target ) ) {
+      write ( result, factor . size () );
+      for ( uint64_t source : factor ) {
+        write ( result, 2 * source + ( interaction ( source, target ) ? 1 : 0 ) );
+      }
+    }
+  }
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY void Network::
+deserialize ( std::string const& bytes ) {
+  NetworkDetail::Reader reader ( bytes );
+  if ( not reader . magic () ) reader . fail ();
+  data_ . reset ( new Network_ );
+  data_ -> specification_ = reader . string ();
+  data_ -> pos_edge_blowup_ = reader . integer ();
+  uint64_t D = reader . integer ();
+  if ( D > bytes . size () ) reader . fail ();
+  for ( uint64_t target = 0; target < D; ++ target ) {
+    std::string node = reader . string ();
+    data_ -> index_by_name_ [ node ] = target;
+    data_ -> name_by_index_ . push_back ( node );
+    data_ -> essential_ . push_back ( reader . integer () );
+    std::vector<std::vector<uint64_t>> logic_struct ( reader . integer () );
+    if ( logic_struct . size () > D ) reader . fail ();
+    for ( auto & factor : logic_struct ) {
+      factor . resize ( reader . integer () );
+      if ( factor . size () > D ) reader . fail ();
+      for ( uint64_t & source : factor ) {
+        uint64_t code = reader . integer ();
+        source = code >> 1;
+        if ( source >= D ) reader . fail ();
+        data_ -> edge_type_ [ std::make_pair ( source, target ) ] = code & 1;
+      }
+    }
+    data_ -> logic_by_index_ . push_back ( logic_struct );
+  }
+  if ( not reader . done () ) reader . fail ();
+  _finalize ();
+}
+
 INLINE_IF_HEADER_ONLY std::string Network::
 graphviz ( std::vector<std::string> const& theme ) const {
   std::stringstream result;
@@ -149,98 +292,61 @@ graphviz ( std::vector<std::string> const& theme ) const {
   return result . str ();
 }
 
-namespace DSGRN_parse_tools {
-  // http://stackoverflow.com/questions/236129/split-a-string-in-c
-  INLINE_IF_HEADER_ONLY std::vector<std::string> &split(const std::string &s, char delim, std::vector<std::string> &elems) {
-    std::stringstream ss(s);
-    std::string item;
-    while (std::getline(ss, item, delim)) {
-        elems.push_back(item);
-    }
-    return elems;
-  }
-  INLINE_IF_HEADER_ONLY std::vector<std::string> split(const std::string &s, char delim) {
-    std::vector<std::string> elems;
-    split(s, delim, elems);
-    return elems;
-  }
-  INLINE_IF_HEADER_ONLY std::string& removeSpace ( std::string &s ) {
-    s.erase(std::remove_if(s.begin(), s.end(), (uint64_t(*)(uint64_t))isspace), s.end());
-    return s;
-  }
-}
-
-/// _lines
-///   Open the network file and read it line by line
-INLINE_IF_HEADER_ONLY std::vector<std::string> Network::
-_lines ( void ) {
-  // Remove quote marks if they exist, and convert "\n" substrings to newlines
-  std::string & str = data_ -> specification_;
-  const std::regex quote_regex("\"", std::regex::basic);
-  const std::regex newline_regex("\n", std::regex::basic);
-  data_ -> specification_ = std::regex_replace(data_ -> specification_, newline_regex, "\n" );
-  data_ -> specification_ = std::regex_replace(data_ -> specification_, quote_regex, "" );
-
-  // Parse the lines
-  std::vector<std::string> result;
-  std::stringstream spec ( data_ -> specification_ );
-  std::string line;
-  while ( std::getline ( spec, line ) ) {
-    result . push_back ( line );
-  }
-  return result;
-}
-
 /// parse
-///   Iterate through lines and produce data structures
+///   Lex the specification in a single pass over its lines, and produce
+///   data structures
 INLINE_IF_HEADER_ONLY void Network::
-_parse ( std::vector<std::string> const& lines ) {
-  using namespace DSGRN_parse_tools;
-  std::vector<std::string> logic_strings;
-  std::map<std::string, bool> essential_nodes;
-  //std::vector<std::string> constraint_strings;
+_parse ( void ) {
+  using namespace NetworkDetail;
+  // Remove quote marks if they exist
+  std::string & spec = data_ -> specification_;
+  spec . erase ( std::remove ( spec . begin (), spec . end (), '"' ), spec . end () );
   // Learn the node names
-  for ( auto const& line : lines ) {
-    auto splitline = split ( line, ':' );
-    if ( splitline . empty () ) continue;
-    removeSpace(splitline[0]);
-    // Skip if empty string
-    if ( splitline[0] == "" ) continue;
-    // If begins with . or @, skip
-    if ( (splitline[0][0] == '.') || (splitline[0][0] == '@' ) ) continue;
-    data_ ->  name_by_index_ . push_back ( splitline[0] );
-    // If no logic specified, zero inputs.
-    if ( splitline . size () < 2 ) {
-      logic_strings . push_back ( " " );
-    } else {
-      logic_strings . push_back ( splitline[1] );
-    }
-    //std::cout << line << " has " << splitline.size() << " parts.\n";
-    if ( splitline . size () >= 3 ) {
+  // A line is "name : logic : essential"; as in splitting it at ':' with
+  // std::getline, a trailing empty field does not count
+  std::vector<std::pair<char const*, char const*>> logic_strings;
+  std::vector<bool> essential_lines;
+  char const* begin = spec . data ();
+  char const* end = begin + spec . size ();
+  for ( char const* line = begin; line < end; ) {
+    char const* eol = std::find ( line, end, '\n' );
+    char const* colon = std::find ( line, eol, ':' );
+    uint64_t fields = ( line == eol ) ? 0 : std::count ( line, eol, ':' ) + ( eol [ -1 ] == ':' ? 0 : 1 );
+    std::string name;
+    for ( char const* c = line; c < colon; ++ c ) if ( not is_space ( *c ) ) name . push_back ( *c );
+    // Skip if empty string, or if begins with . or @
+    if ( fields > 0 && not name . empty () && name [ 0 ] != '.' && name [ 0 ] != '@' ) {
+      data_ -> name_by_index_ . push_back ( name );
+      // If no logic specified, zero inputs.
+      if ( fields < 2 ) {
+        logic_strings . push_back ( { eol, eol } );
+      } else {
+        logic_strings . push_back ( { colon + 1, std::find ( colon + 1, eol, ':' ) } );
+      }
       // TODO: make it check for keyword "essential"
-      essential_nodes [ splitline[0] ] = true;
-      //std::cout << "Marking " << splitline[0] << " as essential \n";
-    } else {
-      essential_nodes [ splitline[0] ] = false;
+      essential_lines . push_back ( fields >= 3 );
     }
+    line = ( eol == end ) ? end : eol + 1;
   }
   // Index the node names
   uint64_t loop_index = 0;
-  data_ -> essential_ . resize ( essential_nodes . size () );
   for ( auto const& name : data_ ->  name_by_index_ ) { 
     data_ -> index_by_name_ [ name ] = loop_index; 
-    data_ -> essential_ [ loop_index ] = essential_nodes [ name ];
     ++ loop_index;
   }
+  // A name given on several lines is essential as its last line says
+  data_ -> essential_ . resize ( size () );
+  for ( uint64_t i = 0; i < size (); ++ i ) {
+    data_ -> essential_ [ i ] = essential_lines [ data_ -> index_by_name_ [ name ( i ) ] ];
+  }
   // Learn the logics
   // Trick: ignore everything but node names and +'s. 
   // Example: a + ~ b c d + e  corresponds to (a+~b)(c)(d+e)
   uint64_t target = 0;
+  std::string token;
   for ( auto const& logic_string : logic_strings ) {
-    //std::cout << "Processing " << logic_string << "\n";
     std::vector<std::vector<uint64_t>> logic_struct;
     std::vector<uint64_t> factor;
-    std::string token;
     bool parity = true;
     bool appending = true;
 
@@ -249,57 +355,44 @@ _parse ( std::vector<std::string> const& lines ) {
       // Put factor into canonical ordering
       std::sort ( factor.begin(), factor.end() );
       logic_struct . push_back ( factor );
-      //std::cout << "    Flushing factor ";
-      //for ( uint64_t i : factor ) std::cout << name ( i ) << " ";
-      //std::cout << "\n";
       factor . clear ();      
     };
-    auto flush_token = [&] () {
-      if ( token . empty () ) return;
+    auto flush_token = [&] ( char const* token_begin, char const* token_end ) {
+      if ( token_begin == token_end ) return;
       if ( not appending ) flush_factor ();
-      //std::cout << "  Flushing token " << token << "\n";
-      if ( data_ -> index_by_name_ . count ( token ) == 0 ) {
+      token . assign ( token_begin, token_end );
+      auto it = data_ -> index_by_name_ . find ( token );
+      if ( it == data_ -> index_by_name_ . end () ) {
         throw std::runtime_error ( "Problem parsing network specification file: " 
                                    " Invalid input variable " + token );
       }
-      uint64_t source = data_ ->  index_by_name_ [ token ];
+      uint64_t source = it -> second;
       factor . push_back ( source );
       data_ ->  edge_type_[std::make_pair( source, target )] = parity;
-      //std::cout << "Creating edge from " << source << " to " << target << "\n";
-      token . clear ();
       appending = false;
       parity = true;
     };
-    for ( char c : logic_string ) {
-      //std::cout << "Reading character " << c << "\n";
-      if ( ( c == '\t' ) || (c == ' ') || (c == '(') || (c == ')') || (c == '+') || (c == '~') ) {
-        flush_token ();
-      } else {
-        token . push_back ( c );
+    char const* token_begin = logic_string . first;
+    for ( char const* c = logic_string . first; c < logic_string . second; ++ c ) {
+      if ( is_separator ( *c ) ) {
+        flush_token ( token_begin, c );
+        token_begin = c + 1;
       }
-      if ( c == '+' ) { 
-        appending = true;
-        //std::cout << "  Detected +\n";
-      }
-      if ( c == '~' ) parity = false;
+      if ( *c == '+' ) appending = true;
+      if ( *c == '~' ) parity = false;
     }
-    flush_token ();
+    flush_token ( token_begin, logic_string . second );
     flush_factor ();
-    //std::cout << "The logic_struct formed.\n";
     // Ensure logic_struct is acceptable (no repeats!)
     std::unordered_set<uint64_t> inputs;
     for ( auto const& factor : logic_struct ) {
-      //std::cout << "# ";
       for ( auto i : factor ) {
-        //std::cout << i << " ";
         if ( inputs . count ( i ) ) {
           throw std::runtime_error ( "Problem parsing network specification file: Repeated inputs in logic" );
         }
         inputs . insert ( i );
       }
     }
-    //std::cout << "\n";
-    //std::cout << "The logic_struct is acceptable.\n";
     // Compare partitions by (size, max), where size is length and max is maximum index
     auto compare_partition = [](std::vector<uint64_t> const& lhs, std::vector<uint64_t> const& rhs) {
       if ( lhs . size () < rhs . size () ) return true;
@@ -312,9 +405,17 @@ _parse ( std::vector<std::string> const& lines ) {
     // Put the logic struct into a canonical ordering.
     std::sort ( logic_struct.begin(), logic_struct.end(), compare_partition );
     data_ -> logic_by_index_ . push_back ( logic_struct );
-    //std::cout << "The logic_struct has been incorporated into the network.\n";
     ++ target;
   }
+  _finalize ();
+}
+
+/// _finalize
+///   Compute the inputs, outputs, out-edge orders and numbers of
+///   thresholds from the names, logics and edge types
+INLINE_IF_HEADER_ONLY void Network::
+_finalize ( void ) {
+  uint64_t target;
   // Compute inputs and outputs.
   data_ -> inputs_ . resize ( size () );
   data_ -> outputs_ . resize ( size () );
@@ -344,7 +445,6 @@ _parse ( std::vector<std::string> const& lines ) {
     // Each self edge creates an additional threshold
     data_ -> num_thresholds_[d] = m + n_self_edges;
   }
-  //std::cout << "_parse complete.\n";
 }
 
 INLINE_IF_HEADER_ONLY std::ostream& operator << ( std::ostream& stream, Network const& network ) {
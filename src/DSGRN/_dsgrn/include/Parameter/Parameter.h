@@ -88,6 +88,8 @@ public:
   ///     left-0, left-1, left-2, ..., left-(d-1),
   ///     right-0, right-1, ... right(d-1)
   ///   A bit of 0 means entrance and 1 means absorbing.
+  ///   Throws std::length_error for more than 32 nodes; the labels of
+  ///   larger networks are given by LazyDomainGraph::wide_label.
   std::vector<uint64_t>
   labelling ( void ) const;
 
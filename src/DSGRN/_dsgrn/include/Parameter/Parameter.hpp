@@ -150,6 +150,9 @@ INLINE_IF_HEADER_ONLY std::vector<uint64_t> Parameter::
 labelling ( void ) const {
   std::vector<uint64_t> result;
   uint64_t D = network () . size ();
+  if ( D > 32 ) {
+    throw std::length_error ( "Parameter::labelling: the labels of more than 32 nodes do not fit in 64 bits (see LazyDomainGraph::wide_label)" );
+  }
 
   // pre-allocated vectors (for efficiency)
   std::vector<uint64_t> lower_limits ( D );
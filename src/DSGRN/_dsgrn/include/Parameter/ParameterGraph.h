@@ -12,6 +12,7 @@
 #include "Parameter/Network.h"
 #include "Parameter/Parameter.h" 
 #include "Parameter/Configuration.h" 
+#include "Parameter/LogicGenerator.h"
 
 struct ParameterGraph_;
 
@@ -33,9 +34,21 @@ public:
 
   /// size
   ///   Return the number of parameters
+  ///   Throws std::overflow_error if it does not fit in 64 bits (see overflow)
   uint64_t
   size ( void ) const;
 
+  /// overflow
+  ///   Return true if the number of parameters does not fit in 64 bits.
+  ///   The methods which take or return parameter indices (size, parameter,
+  ///   index, adjacencies, index_from_samples, fixedordersize, reorderings,
+  ///   random_indices, strided_indices) then throw std::overflow_error,
+  ///   and parameters are addressed by their coordinates instead (see
+  ///   coordinates, random_parameters); the Python bindings also provide
+  ///   arbitrary precision indices (big_size, big_parameter, big_index).
+  bool
+  overflow ( void ) const;
+
   /// dimension
   ///   Return the number of nodes in the network
   ///   (i.e. the dimension of the phase space)
@@ -74,6 +87,62 @@ public:
   uint64_t
   index ( Parameter const& p ) const;
 
+  /// coordinates
+  ///   Return the digits of the index of a parameter in the mixed radix
+  ///   of the parameter graph: the logic index of each node d (base
+  ///   logicsize(d)) followed by the order index of each node d (base
+  ///   ordersize(d)), least significant first, so that
+  ///     index = sum of digit * place value
+  ///   If the parameter presented is invalid, return an empty vector.
+  ///   Unlike index, it does not depend on size() fitting in 64 bits.
+  std::vector<uint64_t>
+  coordinates ( Parameter const& p ) const;
+
+  /// parameter_from_coordinates
+  ///   Return the parameter with the given coordinates (see coordinates)
+  Parameter
+  parameter_from_coordinates ( std::vector<uint64_t> const& coordinates ) const;
+
+  /// random_indices
+  ///   Return "count" parameter indices drawn uniformly and independently,
+  ///   sample k from the stream keyed by (seed, k) (see PhiloxStream), so
+  ///   the result only depends on the arguments
+  std::vector<uint64_t>
+  random_indices ( uint64_t count, uint64_t seed ) const;
+
+  /// random_parameters
+  ///   Return "count" parameters drawn uniformly and independently, as
+  ///   random_indices, by drawing each coordinate uniformly. Works
+  ///   whether or not size() fits in 64 bits.
+  std::vector<Parameter>
+  random_parameters ( uint64_t count, uint64_t seed ) const;
+
+  /// strided_indices
+  ///   Return the parameter indices start, start + stride, ... of the
+  ///   sub-lattice of stride "stride", at most "count" of them, stopping
+  ///   at size()
+  std::vector<uint64_t>
+  strided_indices ( uint64_t start, uint64_t stride, uint64_t count ) const;
+
+  /// index_from_samples
+  ///   Return the index of the parameter of each of "count" samples of
+  ///   the L, U and T variables, or -1 for samples on a boundary between
+  ///   parameters (or outside of the parameter graph). The samples are
+  ///   row-major count x D x D arrays: L[s][i][j] and U[s][i][j] belong
+  ///   to the edge i -> j and T[s][i][j] to the edge i -> j as an output
+  ///   edge of node i. Rather than building a Parameter per sample, the
+  ///   input polynomials are evaluated and binned against the sorted
+  ///   thresholds, and the bins and threshold order are looked up in
+  ///   tables keyed by integers. The samples are processed by
+  ///   "num_threads" threads (0 for one per core). Every node needs an
+  ///   out edge.
+  std::vector<uint64_t>
+  index_from_samples ( double const* L,
+                       double const* U,
+                       double const* T,
+                       uint64_t count,
+                       uint64_t num_threads = 0 ) const;
+
   /// adjacencies
   ///   Return the adjacent parameter indices of the given type
   ///   to a given parameter index. The default type is used if
@@ -95,6 +164,7 @@ public:
   /// reorderings
   ///   Return of reorderings
   ///   Note: size() = fixedordersize()*reorderings()
+  ///   Both throw std::overflow_error if size() does not fit in 64 bits
   uint64_t
   reorderings ( void ) const;
 
@@ -105,11 +175,17 @@ public:
 private:
   std::shared_ptr<ParameterGraph_> data_;
   uint64_t _factorial ( uint64_t m ) const;
+  /// _check_overflow
+  ///   Throw std::overflow_error if size() does not fit in 64 bits
+  void _check_overflow ( std::string const& method ) const;
 };
 
 struct ParameterGraph_ {
   Network network_;
   uint64_t size_;
+  // size_, reorderings_, fixedordersize_ and the place values are only
+  // valid when overflow_ is false
+  bool overflow_;
   uint64_t reorderings_;
   uint64_t fixedordersize_;
   std::vector<uint64_t> logic_place_values_;
@@ -124,6 +200,7 @@ struct ParameterGraph_ {
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 namespace py = pybind11;
 
 inline void
@@ -132,13 +209,77 @@ ParameterGraphBinding (py::module &m) {
     .def(py::init<>())
     .def(py::init<Network const&>())
     .def("size", &ParameterGraph::size)
+    .def("overflow", &ParameterGraph::overflow)
     .def("dimension", &ParameterGraph::dimension)
     .def("logicsize", &ParameterGraph::logicsize)
     .def("ordersize", &ParameterGraph::ordersize)
     .def("factorgraph", &ParameterGraph::factorgraph)
     .def("parameter", &ParameterGraph::parameter)    
     .def("index", &ParameterGraph::index)
+    .def("coordinates", &ParameterGraph::coordinates)
+    .def("parameter_from_coordinates", &ParameterGraph::parameter_from_coordinates)
+    .def("big_size", [](ParameterGraph const& pg) {
+        // Arbitrary precision, so also when pg.overflow()
+        py::object result = py::int_ ( 1 );
+        for ( uint64_t d = 0; d < pg . dimension (); ++ d ) {
+          result = result . attr("__mul__")( py::int_ ( pg . logicsize ( d ) ) );
+          result = result . attr("__mul__")( py::int_ ( pg . ordersize ( d ) ) );
+        }
+        return result;
+      })
+    .def("big_parameter", [](ParameterGraph const& pg, py::int_ index) {
+        // Digits of the index, in the order of coordinates
+        uint64_t D = pg . dimension ();
+        std::vector<uint64_t> coordinates ( 2 * D );
+        py::object rest = index;
+        if ( rest . attr("__lt__")( 0 ) . cast<bool> () ) {
+          throw std::runtime_error ( "ParameterGraph::parameter Index out of bounds" );
+        }
+        for ( uint64_t i = 0; i < 2 * D; ++ i ) {
+          uint64_t base = ( i < D ) ? pg . logicsize ( i ) : pg . ordersize ( i - D );
+          py::tuple qr = rest . attr("__divmod__")( py::int_ ( base ) );
+          coordinates [ i ] = qr[1] . cast<uint64_t> ();
+          rest = qr[0];
+        }
+        if ( rest . attr("__ne__")( 0 ) . cast<bool> () ) {
+          throw std::runtime_error ( "ParameterGraph::parameter Index out of bounds" );
+        }
+        return pg . parameter_from_coordinates ( coordinates );
+      }, py::arg("index"))
+    .def("big_index", [](ParameterGraph const& pg, Parameter const& p) {
+        uint64_t D = pg . dimension ();
+        std::vector<uint64_t> coordinates = pg . coordinates ( p );
+        py::object result = py::int_ ( coordinates . empty () ? -1 : 0 );
+        if ( coordinates . empty () ) return result;
+        for ( uint64_t i = 2 * D; i -- > 0; ) {
+          uint64_t base = ( i < D ) ? pg . logicsize ( i ) : pg . ordersize ( i - D );
+          result = result . attr("__mul__")( py::int_ ( base ) ) . attr("__add__")( py::int_ ( coordinates [ i ] ) );
+        }
+        return result;
+      }, py::arg("p"))
+    .def("random_indices", &ParameterGraph::random_indices, py::arg("count"), py::arg("seed") = 0)
+    .def("random_parameters", &ParameterGraph::random_parameters, py::arg("count"), py::arg("seed") = 0)
+    .def("strided_indices", &ParameterGraph::strided_indices, py::arg("start"), py::arg("stride"), py::arg("count"))
     .def("adjacencies", &ParameterGraph::adjacencies, py::arg("index"), py::arg("type") = "")
+    .def("index_from_samples", [](ParameterGraph const& pg,
+                                  py::array_t<double, py::array::c_style | py::array::forcecast> L,
+                                  py::array_t<double, py::array::c_style | py::array::forcecast> U,
+                                  py::array_t<double, py::array::c_style | py::array::forcecast> T,
+                                  uint64_t num_threads) {
+        uint64_t D = pg . dimension ();
+        uint64_t count = D ? L . size () / ( D * D ) : 0;
+        if ( L . size () != count * D * D || U . size () != L . size () || T . size () != L . size () ) {
+          throw std::invalid_argument ( "ParameterGraph::index_from_samples: L, U and T must be arrays of D x D samples" );
+        }
+        std::vector<uint64_t> indices;
+        {
+          py::gil_scoped_release release;
+          indices = pg . index_from_samples ( L . data (), U . data (), T . data (), count, num_threads );
+        }
+        py::array_t<int64_t> result ( count );
+        std::copy ( indices . begin (), indices . end (), result . mutable_data () );
+        return result;
+      }, py::arg("L"), py::arg("U"), py::arg("T"), py::arg("num_threads") = 0)
     .def("network", &ParameterGraph::network)
     .def("fixedordersize", &ParameterGraph::fixedordersize)
     .def("reorderings", &ParameterGraph::reorderings)
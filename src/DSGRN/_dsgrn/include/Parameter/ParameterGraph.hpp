@@ -12,10 +12,38 @@
 #endif
 
 #include "ParameterGraph.h"
+#include "Tools/Philox.h"
+
+namespace ParameterGraphDetail {
+
+  /// multiply
+  ///   Set result = a * b and return true if it overflows 64 bits
+  inline bool
+  multiply ( uint64_t a, uint64_t b, uint64_t & result ) {
+    result = a * b;
+    return a != 0 && result / a != b;
+  }
+
+  /// uniform
+  ///   Return a uniform integer in [0, n) from the 64 bit draws of "stream",
+  ///   by rejecting the draws below 2^64 mod n
+  inline uint64_t
+  uniform ( PhiloxStream & stream, uint64_t n ) {
+    uint64_t threshold = ( - n ) % n;
+    while ( true ) {
+      uint64_t r = ( (uint64_t) stream . next () << 32 ) | stream . next ();
+      if ( r >= threshold ) return r % n;
+    }
+  }
+}
 
 INLINE_IF_HEADER_ONLY ParameterGraph::
 ParameterGraph ( void ) {
   data_ . reset ( new ParameterGraph_ );
+  data_ -> size_ = 0;
+  data_ -> reorderings_ = 0;
+  data_ -> fixedordersize_ = 0;
+  data_ -> overflow_ = false;
 }
 
 INLINE_IF_HEADER_ONLY ParameterGraph::
@@ -30,6 +58,7 @@ assign ( Network const& network ) {
   data_ -> network_ = network;
   data_ -> reorderings_ = 1;
   data_ -> fixedordersize_ = 1;
+  data_ -> overflow_ = false;
   // Load the logic files one by one.
   uint64_t D = data_ -> network_ . size ();
   for ( uint64_t d = 0; d < D; ++ d ) {
@@ -37,7 +66,7 @@ assign ( Network const& network ) {
     // Treat the no out edge case as one out edge
     uint64_t m = data_ -> network_ . outputs ( d ) . size () ? data_ -> network_ . outputs ( d ) . size () : 1;
     data_ -> order_place_bases_ . push_back ( _factorial ( m ) );
-    data_ -> reorderings_ *= data_ -> order_place_bases_ . back ();
+    data_ -> overflow_ |= ParameterGraphDetail::multiply ( data_ -> reorderings_, data_ -> order_place_bases_ . back (), data_ -> reorderings_ );
     std::vector<std::vector<uint64_t>> const& logic_struct = data_ -> network_ . logic ( d );
     std::stringstream ss;
     ss << path << "/" << n <<  "_" << m;
@@ -47,25 +76,27 @@ assign ( Network const& network ) {
     //std::cout << "Acquiring logic data in " << ss.str() << "\n";
     std::vector<std::string> hex_codes;
     std::ifstream infile ( ss.str() );
-    if ( not infile . good () ) {
-      throw std::runtime_error ( "Error: Could not find logic resource " + ss.str() + ".\n");
+    if ( infile . good () ) {
+      std::string line;
+      while ( std::getline ( infile, line ) ) hex_codes . push_back ( line );
+      infile . close ();
+    } else {
+      // Not shipped: read it from the cache or generate it
+      std::vector<uint64_t> logic;
+      for ( auto const& p : logic_struct ) logic . push_back ( p.size() );
+      hex_codes = LogicGenerator::resource ( n, m, logic, data_ -> network_ . essential ( d ) );
     }
-    std::string line;
     std::unordered_map<std::string,uint64_t> hx;
-    uint64_t counter = 0;
-    while ( std::getline ( infile, line ) ) {
-      hex_codes . push_back ( line );
-      hx [ line ] = counter;
-      ++counter;
+    for ( uint64_t counter = 0; counter < hex_codes . size (); ++ counter ) {
+      hx [ hex_codes [ counter ] ] = counter;
     }
-    infile . close ();
     data_ -> factors_ . push_back ( hex_codes );
     data_ -> factors_inv_ . push_back ( hx );
     data_ -> logic_place_bases_ . push_back ( hex_codes . size () );
-    data_ -> fixedordersize_ *= hex_codes . size ();
+    data_ -> overflow_ |= ParameterGraphDetail::multiply ( data_ -> fixedordersize_, hex_codes . size (), data_ -> fixedordersize_ );
     //std::cout << d << ": " << hex_codes . size () << " factorial(" << m << ")=" << _factorial ( m ) << "\n";
   }
-  data_ -> size_ = data_ -> fixedordersize_ * data_ -> reorderings_;
+  data_ -> overflow_ |= ParameterGraphDetail::multiply ( data_ -> fixedordersize_, data_ -> reorderings_, data_ -> size_ );
   // construction of place_values_ used in method index
   data_ -> logic_place_values_ . resize ( D, 0 );
   data_ -> order_place_values_ . resize ( D, 0 );
@@ -81,9 +112,15 @@ assign ( Network const& network ) {
 
 INLINE_IF_HEADER_ONLY uint64_t ParameterGraph::
 size ( void ) const {
+  _check_overflow ( "size" );
   return data_ -> size_;
 }
 
+INLINE_IF_HEADER_ONLY bool ParameterGraph::
+overflow ( void ) const {
+  return data_ -> overflow_;
+}
+
 INLINE_IF_HEADER_ONLY uint64_t ParameterGraph::
 dimension ( void ) const {
   return network().size();
@@ -114,28 +151,37 @@ parameter ( uint64_t index ) const {
   uint64_t order_index = index / data_ -> fixedordersize_;
 
   uint64_t D = data_ -> network_ . size ();
-  std::vector<uint64_t> logic_indices;
+  std::vector<uint64_t> coordinates ( 2 * D );
   for ( uint64_t d = 0; d < D; ++ d ) {
-    uint64_t i = logic_index % data_ -> logic_place_bases_ [ d ];
+    coordinates [ d ] = logic_index % data_ -> logic_place_bases_ [ d ];
     logic_index /= data_ -> logic_place_bases_ [ d ];
-    logic_indices . push_back ( i );
   }
-  std::vector<uint64_t> order_indices;
   for ( uint64_t d = 0; d < D; ++ d ) {
-    uint64_t i = order_index % data_ -> order_place_bases_ [ d ];
+    coordinates [ D + d ] = order_index % data_ -> order_place_bases_ [ d ];
     order_index /= data_ -> order_place_bases_ [ d ];
-    order_indices . push_back ( i );
   }
+  return parameter_from_coordinates ( coordinates );
+}
 
+INLINE_IF_HEADER_ONLY Parameter ParameterGraph::
+parameter_from_coordinates ( std::vector<uint64_t> const& coordinates ) const {
+  uint64_t D = data_ -> network_ . size ();
+  if ( coordinates . size () != 2 * D ) {
+    throw std::invalid_argument ( "ParameterGraph::parameter_from_coordinates: expected 2 * dimension() coordinates" );
+  }
   std::vector<LogicParameter> logic;
   std::vector<OrderParameter> order;
   for ( uint64_t d = 0; d < D; ++ d ) {
+    if ( coordinates [ d ] >= data_ -> logic_place_bases_ [ d ] ||
+         coordinates [ D + d ] >= data_ -> order_place_bases_ [ d ] ) {
+      throw std::runtime_error ( "ParameterGraph::parameter Index out of bounds");
+    }
     uint64_t n = data_ -> network_ . inputs ( d ) . size ();
     // Treat the no out edge case as one out edge
     uint64_t m = data_ -> network_ . outputs ( d ) . size () ? data_ -> network_ . outputs ( d ) . size () : 1;
-    std::string hex_code = data_ -> factors_ [ d ] [ logic_indices[d] ];
+    std::string hex_code = data_ -> factors_ [ d ] [ coordinates [ d ] ];
     LogicParameter logic_param ( n, m, hex_code );
-    OrderParameter order_param ( m, order_indices[d] );
+    OrderParameter order_param ( m, coordinates [ D + d ] );
     logic . push_back ( logic_param );
     order . push_back ( order_param );
   }
@@ -145,39 +191,256 @@ parameter ( uint64_t index ) const {
 
 INLINE_IF_HEADER_ONLY uint64_t ParameterGraph::
 index ( Parameter const& p ) const {
+  _check_overflow ( "index" );
+  std::vector<uint64_t> digits = coordinates ( p );
+  if ( digits . empty () ) return -1;
+
+  // Construct index
+  uint64_t D = data_ -> network_ . size ();
+  uint64_t logic_index = 0;
+  uint64_t order_index = 0;
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    logic_index += data_ -> logic_place_values_[d] * digits[d];
+    order_index += data_ -> order_place_values_[d] * digits[D + d];
+  }
+  uint64_t index = order_index * data_ -> fixedordersize_ + logic_index;
+
+  return (index < size()) ? index : -1;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> ParameterGraph::
+coordinates ( Parameter const& p ) const {
   // Obtain logic and order information
   std::vector<LogicParameter> const& logic = p . logic ( );
   std::vector<OrderParameter> const& order = p . order ( );
 
   // Construct Logic indices
-  std::vector<uint64_t> logic_indices;
   uint64_t D = data_ -> network_ . size ();
+  if ( logic . size () != D || order . size () != D ) return std::vector<uint64_t> ();
+  std::vector<uint64_t> result ( 2 * D );
   for ( uint64_t d = 0; d < D; ++d ) {
     std::string hexcode = logic [ d ] . hex ( );
     auto it = data_ -> factors_inv_[d] . find ( hexcode );
     if ( it != data_ -> factors_inv_[d] . end ( )  ) {
-      logic_indices . push_back ( it -> second );
+      result [ d ] = it -> second;
     } else {
-      return -1;
+      return std::vector<uint64_t> ();
     }
   }
 
   // Construct Order indices
-  std::vector<uint64_t> order_indices;
   for ( uint64_t d = 0; d < D; ++ d ) {
-    order_indices . push_back ( order[d].index() );
+    result [ D + d ] = order [ d ] . index ();
+    if ( result [ D + d ] >= data_ -> order_place_bases_ [ d ] ) return std::vector<uint64_t> ();
   }
+  return result;
+}
 
-  // Construct index
-  uint64_t logic_index = 0;
-  uint64_t order_index = 0;
-  for ( uint64_t d = 0; d < D; ++ d ) {
-    logic_index += data_ -> logic_place_values_[d] * logic_indices[d];
-    order_index += data_ -> order_place_values_[d] * order_indices[d];
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> ParameterGraph::
+random_indices ( uint64_t count, uint64_t seed ) const {
+  uint64_t N = size ();
+  if ( N == 0 ) throw std::invalid_argument ( "ParameterGraph::random_indices: empty parameter graph" );
+  std::vector<uint64_t> result ( count );
+  for ( uint64_t k = 0; k < count; ++ k ) {
+    PhiloxStream stream ( seed, k, 0 );
+    result [ k ] = ParameterGraphDetail::uniform ( stream, N );
   }
-  uint64_t index = order_index * data_ -> fixedordersize_ + logic_index;
+  return result;
+}
 
-  return (index < size()) ? index : -1;
+INLINE_IF_HEADER_ONLY std::vector<Parameter> ParameterGraph::
+random_parameters ( uint64_t count, uint64_t seed ) const {
+  uint64_t D = data_ -> network_ . size ();
+  std::vector<Parameter> result;
+  result . reserve ( count );
+  std::vector<uint64_t> digits ( 2 * D );
+  for ( uint64_t k = 0; k < count; ++ k ) {
+    PhiloxStream stream ( seed, k, 0 );
+    for ( uint64_t d = 0; d < D; ++ d ) {
+      digits [ d ] = ParameterGraphDetail::uniform ( stream, data_ -> logic_place_bases_ [ d ] );
+      digits [ D + d ] = ParameterGraphDetail::uniform ( stream, data_ -> order_place_bases_ [ d ] );
+    }
+    result . push_back ( parameter_from_coordinates ( digits ) );
+  }
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> ParameterGraph::
+strided_indices ( uint64_t start, uint64_t stride, uint64_t count ) const {
+  uint64_t N = size ();
+  if ( stride == 0 ) throw std::invalid_argument ( "ParameterGraph::strided_indices: stride must be positive" );
+  std::vector<uint64_t> result;
+  if ( start >= N ) return result;
+  count = std::min ( count, ( N - 1 - start ) / stride + 1 );
+  result . reserve ( count );
+  for ( uint64_t k = 0; k < count; ++ k ) result . push_back ( start + k * stride );
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> ParameterGraph::
+index_from_samples ( double const* L,
+                     double const* U,
+                     double const* T,
+                     uint64_t count,
+                     uint64_t num_threads ) const {
+  _check_overflow ( "index_from_samples" );
+  Network const& network = data_ -> network_;
+  uint64_t D = network . size ();
+  // Lookup tables of each node
+  struct Node {
+    uint64_t n;
+    uint64_t m;
+    std::vector<uint64_t> inputs;
+    std::vector<uint64_t> outputs;
+    // input i of factor k is inputs[begin[k]+i]
+    std::vector<uint64_t> begin;
+    // logic index of the hex code of the bins, as an integer when the
+    // 2^n x m bits fit in 64 bits (see LogicParameter)
+    bool narrow;
+    std::unordered_map<uint64_t,uint64_t> logic_index;
+    // order index of the threshold permutation, packed 4 bits per entry
+    bool tabulated;
+    std::unordered_map<uint64_t,uint64_t> order_index;
+  };
+  std::vector<Node> nodes ( D );
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    Node & node = nodes [ d ];
+    node . inputs = network . inputs ( d );
+    node . outputs = network . outputs ( d );
+    if ( node . outputs . empty () ) {
+      throw std::invalid_argument ( "ParameterGraph::index_from_samples: node " + network . name ( d ) + " has no out edge" );
+    }
+    node . n = node . inputs . size ();
+    node . m = node . outputs . size ();
+    node . begin . push_back ( 0 );
+    for ( auto const& factor : network . logic ( d ) ) node . begin . push_back ( node . begin . back () + factor . size () );
+    node . narrow = ( ( 1ULL << node . n ) * node . m <= 64 );
+    if ( node . narrow ) {
+      std::vector<std::string> const& hex_codes = data_ -> factors_ [ d ];
+      for ( uint64_t i = 0; i < hex_codes . size (); ++ i ) {
+        node . logic_index [ std::stoull ( hex_codes [ i ], nullptr, 16 ) ] = i;
+      }
+    }
+    node . tabulated = ( node . m <= 8 );
+    if ( node . tabulated ) {
+      for ( uint64_t k = 0; k < data_ -> order_place_bases_ [ d ]; ++ k ) {
+        uint64_t key = 0;
+        OrderParameter order ( node . m, k );
+        std::vector<uint64_t> const& perm = order . permutation ();
+        for ( uint64_t i = 0; i < node . m; ++ i ) key |= perm [ i ] << ( 4 * i );
+        node . order_index [ key ] = k;
+      }
+    }
+  }
+  // Classify the samples [first, last)
+  std::vector<uint64_t> result ( count, -1 );
+  auto classify = [&]( uint64_t first, uint64_t last ) {
+    std::vector<uint64_t> perm;
+    std::vector<double> thresholds;
+    std::vector<double> sums;
+    std::vector<uint64_t> bins;
+    for ( uint64_t s = first; s < last; ++ s ) {
+      uint64_t sample = s * D * D;
+      uint64_t logic_index = 0;
+      uint64_t order_index = 0;
+      bool valid = true;
+      for ( uint64_t d = 0; valid && d < D; ++ d ) {
+        Node const& node = nodes [ d ];
+        uint64_t n = node . n;
+        uint64_t m = node . m;
+        uint64_t N = 1ULL << n;
+        // Sort the thresholds: perm[i] is the output edge of the ith smallest
+        perm . resize ( m );
+        thresholds . resize ( m );
+        for ( uint64_t k = 0; k < m; ++ k ) perm [ k ] = k;
+        double const* row = T + sample + d * D;
+        std::sort ( perm . begin (), perm . end (), [&](uint64_t a, uint64_t b) {
+          return row [ node . outputs [ a ] ] < row [ node . outputs [ b ] ]; });
+        for ( uint64_t k = 0; k < m; ++ k ) thresholds [ k ] = row [ node . outputs [ perm [ k ] ] ];
+        for ( uint64_t k = 1; k < m; ++ k ) if ( not ( thresholds [ k - 1 ] < thresholds [ k ] ) ) valid = false;
+        if ( not valid ) break;
+        // Sums of each factor over the combinations of its inputs (bit i
+        // of the combination selects U rather than L for input i)
+        uint64_t K = node . begin . size () - 1;
+        sums . clear ();
+        for ( uint64_t k = 0; k < K; ++ k ) {
+          uint64_t length = node . begin [ k + 1 ] - node . begin [ k ];
+          for ( uint64_t c = 0; c < ( 1ULL << length ); ++ c ) {
+            double sum = 0.0;
+            for ( uint64_t i = 0; i < length; ++ i ) {
+              uint64_t source = node . inputs [ node . begin [ k ] + i ];
+              sum += ( ( c >> i ) & 1 ) ? U [ sample + source * D + d ] : L [ sample + source * D + d ];
+            }
+            sums . push_back ( sum );
+          }
+        }
+        // Bin the input polynomial of each input combination j
+        bins . resize ( N );
+        uint64_t code = 0;
+        for ( uint64_t j = 0; j < N; ++ j ) {
+          double value = 1.0;
+          uint64_t offset = 0;
+          for ( uint64_t k = 0; k < K; ++ k ) {
+            uint64_t length = node . begin [ k + 1 ] - node . begin [ k ];
+            value *= sums [ offset + ( ( j >> node . begin [ k ] ) & ( ( 1ULL << length ) - 1 ) ) ];
+            offset += 1ULL << length;
+          }
+          uint64_t bin = std::lower_bound ( thresholds . begin (), thresholds . end (), value ) - thresholds . begin ();
+          if ( bin < m && thresholds [ bin ] == value ) { valid = false; break; }
+          bins [ j ] = bin;
+          if ( node . narrow ) code |= ( ( 1ULL << bin ) - 1 ) << ( j * m );
+        }
+        if ( not valid ) break;
+        // Logic index
+        uint64_t logic = -1;
+        if ( node . narrow ) {
+          auto it = node . logic_index . find ( code );
+          if ( it != node . logic_index . end () ) logic = it -> second;
+        } else {
+          // Hex code of the bins (see LogicParameter::assign)
+          std::string hex ( ( N * m + 3 ) / 4, '0' );
+          for ( uint64_t j = 0; j < N; ++ j ) {
+            for ( uint64_t t = 0; t < bins [ j ]; ++ t ) {
+              uint64_t bit = j * m + t;
+              char & digit = hex [ hex . size () - 1 - bit / 4 ];
+              uint64_t value = ( ( digit <= '9' ) ? digit - '0' : digit - 'A' + 10 ) | ( 1ULL << ( bit % 4 ) );
+              digit = ( value < 10 ) ? '0' + value : 'A' + value - 10;
+            }
+          }
+          auto it = data_ -> factors_inv_ [ d ] . find ( hex );
+          if ( it != data_ -> factors_inv_ [ d ] . end () ) logic = it -> second;
+        }
+        if ( logic == -1 ) { valid = false; break; }
+        // Order index
+        uint64_t order;
+        if ( node . tabulated ) {
+          uint64_t key = 0;
+          for ( uint64_t i = 0; i < m; ++ i ) key |= perm [ i ] << ( 4 * i );
+          order = node . order_index . at ( key );
+        } else {
+          order = OrderParameter ( perm ) . index ();
+        }
+        logic_index += data_ -> logic_place_values_ [ d ] * logic;
+        order_index += data_ -> order_place_values_ [ d ] * order;
+      }
+      if ( valid ) result [ s ] = order_index * data_ -> fixedordersize_ + logic_index;
+    }
+  };
+  if ( num_threads == 0 ) num_threads = std::max ( 1u, std::thread::hardware_concurrency () );
+  uint64_t chunk = 1024;
+  uint64_t chunks = ( count + chunk - 1 ) / chunk;
+  num_threads = std::min<uint64_t> ( num_threads, std::max<uint64_t> ( 1, chunks ) );
+  std::atomic<uint64_t> next ( 0 );
+  auto work = [&]() {
+    for ( uint64_t c = next ++; c < chunks; c = next ++ ) {
+      classify ( c * chunk, std::min ( count, ( c + 1 ) * chunk ) );
+    }
+  };
+  std::vector<std::thread> threads;
+  for ( uint64_t t = 1; t < num_threads; ++ t ) threads . emplace_back ( work );
+  work ();
+  for ( auto & thread : threads ) thread . join ();
+  return result;
 }
 
 INLINE_IF_HEADER_ONLY std::vector<uint64_t> ParameterGraph::
@@ -276,24 +539,38 @@ network ( void ) const {
 }
 
 INLINE_IF_HEADER_ONLY std::ostream& operator << ( std::ostream& stream, ParameterGraph const& pg ) {
-  stream <<  "(ParameterGraph: "<< pg.size() << " parameters, "
-         << pg.network().size() << " nodes)";
+  stream <<  "(ParameterGraph: ";
+  if ( pg.overflow() ) stream << "over 2^64"; else stream << pg.size();
+  stream << " parameters, " << pg.network().size() << " nodes)";
   return stream;
 }
 
 INLINE_IF_HEADER_ONLY uint64_t ParameterGraph::
 fixedordersize ( void ) const {
+  _check_overflow ( "fixedordersize" );
   return data_ -> fixedordersize_;
 }
 
 INLINE_IF_HEADER_ONLY uint64_t ParameterGraph::
 reorderings ( void ) const {
+  _check_overflow ( "reorderings" );
   return data_ -> reorderings_;
 }
 
 INLINE_IF_HEADER_ONLY uint64_t ParameterGraph::
 _factorial ( uint64_t m ) const {
-  static const std::vector<uint64_t> table =
-    { 1, 1, 2, 6, 24, 120, 720, 5040, 40320, 362880};
-  if ( m < 10 ) return table [ m ]; else return m * _factorial ( m - 1 );
+  // 20! is the largest factorial which fits in 64 bits
+  if ( m > 20 ) {
+    throw std::length_error ( "ParameterGraph: more than 20 out edges of a node are not supported" );
+  }
+  uint64_t result = 1;
+  for ( uint64_t k = 2; k <= m; ++ k ) result *= k;
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY void ParameterGraph::
+_check_overflow ( std::string const& method ) const {
+  if ( data_ -> overflow_ ) {
+    throw std::overflow_error ( "ParameterGraph::" + method + ": the number of parameters does not fit in 64 bits" );
+  }
 }
@@ -11,6 +11,9 @@
 #include "Parameter/Network.h"
 #include "Parameter/Parameter.h" 
 #include "Parameter/Configuration.h" 
+#include "Parameter/ParameterGraph.h"
+#include "Parameter/CADTable.h"
+#include "Tools/Philox.h"
 
 class ParameterSampler {
 public:
@@ -19,29 +22,153 @@ public:
   auto assign(Network) -> void;
   auto sample(Parameter p) const -> std::string;
 
+  /// sample
+  ///   As sample(p), drawing random numbers from the counter-based streams
+  ///   keyed by (seed, index, network node) (see PhiloxStream) instead of
+  ///   the generator of the sampler. The result only depends on the
+  ///   arguments, and the method may be called concurrently; "index" is
+  ///   typically the parameter index of p.
+  auto sample(Parameter p, uint64_t seed, uint64_t index) const -> std::string;
+
+  /// sample_many
+  ///   Return "count" samples of the parameter p as a dense row-major array
+  ///   of count rows and names(p).size() columns. Instead of restarting
+  ///   from the CAD instance and burning in for each sample, the Gibbs
+  ///   chain of each network node is burnt in once and kept running,
+  ///   recording a sample every "thinning" sweeps. The random numbers are
+  ///   drawn from the streams keyed by (seed, index, network node), so the
+  ///   result is reproducible and the method may be called concurrently.
+  auto sample_many(Parameter p, uint64_t count, uint64_t seed, uint64_t thinning = 1, uint64_t index = 0) const -> std::vector<double>;
+
+  /// sample_indices
+  ///   Return, for each parameter index i of "indices" in turn, the rows of
+  ///   sample_many(pg.parameter(i), count, seed, thinning, i), computed by
+  ///   "num_threads" threads (0 for one per core). The result does not
+  ///   depend on the number of threads.
+  auto sample_indices(ParameterGraph const& pg, std::vector<uint64_t> const& indices, uint64_t count, uint64_t seed, uint64_t thinning = 1, uint64_t num_threads = 0) const -> std::vector<double>;
+
+  /// names
+  ///   Return the names of the columns of sample_many (as in sample):
+  ///   for each network node, its L's, U's and T's
+  auto names(Parameter p) const -> std::vector<std::string>;
+
 private:
 
   typedef std::string HexCode;
   typedef std::string Variable;
   typedef std::map<Variable, double> Instance;
-  typedef std::map<HexCode, Instance> InstanceLookup;
 
   Network network;
-  std::vector<InstanceLookup> instancelookups;
+  /// CAD table of each network node, shared with the other nodes and
+  /// samplers of the same node type (see CADTable)
+  std::vector<CADTable> tables;
+  /// generator of sample(p), which is therefore not thread-safe
   mutable std::default_random_engine generator;
   mutable std::uniform_real_distribution<double> distribution;
+  /// number of Gibbs sweeps from the CAD instance before the first sample
+  static constexpr uint64_t burn_in_limit = 10;
+
+  /// GibbsChain
+  ///   State of the Gibbs sampler of a network node, in flat arrays
+  ///   indexed by the 2^n input combinations j (see Gibbs_Initialize)
+  struct GibbsChain {
+    uint64_t n;
+    uint64_t m;
+    uint64_t N;
+    uint64_t K;
+    std::vector<double> L;
+    std::vector<double> U;
+    std::vector<double> T;
+    std::vector<uint64_t> which_factor;
+    std::vector<double> sums;
+    std::vector<double> products;
+    std::vector<uint64_t> lower;
+    std::vector<uint64_t> upper;
+    std::vector<double> lower_threshold;
+    std::vector<double> upper_threshold;
+    std::vector<double> cofactor;
+    std::vector<double> cosum;
+  };
+
+  /// Gibbs_Initialize
+  ///   Set up the chain of a node with the given logic parameter hex code
+  ///   at the instance "initial" (L's, U's and T's, see CADTable)
+  auto
+  Gibbs_Initialize(
+    HexCode const& hex,
+    uint64_t n,
+    uint64_t m,
+    std::vector<std::vector<uint64_t>> const& logic,
+    double const* initial) const
+    ->
+    GibbsChain;
+
+  /// Initial_Instance
+  ///   Return the CAD instance of the logic parameter of node d. Rows of
+  ///   the CAD table are aligned with the factor indices of the parameter
+  ///   graph, so the row "factor" (its logic coordinate, see
+  ///   ParameterGraph::coordinates) is used when it holds the hex code;
+  ///   otherwise, e.g. for factor -1, the hex code is looked up.
+  auto
+  Initial_Instance(
+    uint64_t d,
+    HexCode const& hex,
+    uint64_t factor = -1) const
+    ->
+    double const*;
+
+  /// Gibbs_Sweep
+  ///   Update each variable of the chain once, drawing uniform
+  ///   numbers in [0,1) from "uniform"
+  template < typename Uniform >
+  auto
+  Gibbs_Sweep(
+    GibbsChain & chain,
+    Uniform & uniform) const
+    ->
+    void;
 
   /// Gibbs_Sampler
+  template < typename Uniform >
   auto
   Gibbs_Sampler(
     HexCode const& hex, 
     uint64_t n, 
     uint64_t m,
     std::vector<std::vector<uint64_t>> logic,
-    Instance const& initial) const
+    double const* initial,
+    Uniform & uniform) const
     ->
     Instance;
 
+  /// Sample_String
+  ///   Sample p, node d drawing uniform numbers from uniform(d), and
+  ///   return the named parameters as a string (see sample)
+  template < typename UniformOfNode >
+  auto
+  Sample_String(
+    Parameter const& p,
+    UniformOfNode const& uniform) const
+    ->
+    std::string;
+
+  /// Sample_Rows
+  ///   Write the samples of sample_many to rows "columns" apart. When
+  ///   "factors" is not null, it holds the logic coordinate of each node
+  ///   (see Initial_Instance).
+  auto
+  Sample_Rows(
+    Parameter const& p,
+    uint64_t count,
+    uint64_t seed,
+    uint64_t thinning,
+    uint64_t index,
+    double * rows,
+    uint64_t columns,
+    uint64_t const* factors = nullptr) const
+    ->
+    void;
+
   /// Name_Parameters
   ///   Given a parameter node and chosen instances for each network node
   ///   determine the parameter names corresponding to each parameter in the instances
@@ -66,6 +193,7 @@ private:
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 namespace py = pybind11;
 
 inline void
@@ -73,5 +201,28 @@ ParameterSamplerBinding (py::module &m) {
   py::class_<ParameterSampler, std::shared_ptr<ParameterSampler>>(m, "ParameterSampler")
     .def(py::init<>())
     .def(py::init<Network>())
-    .def("sample", &ParameterSampler::sample);
+    .def("sample", (std::string(ParameterSampler::*)(Parameter)const)&ParameterSampler::sample)
+    .def("sample", (std::string(ParameterSampler::*)(Parameter,uint64_t,uint64_t)const)&ParameterSampler::sample,
+      py::arg("p"), py::arg("seed"), py::arg("index"))
+    .def("sample_many", [](ParameterSampler const& self, Parameter p, uint64_t count, uint64_t seed, uint64_t thinning, uint64_t index) {
+        uint64_t columns = self . names ( p ) . size ();
+        std::vector<double> samples = self . sample_many ( p, count, seed, thinning, index );
+        py::array_t<double> result ( { count, columns } );
+        std::copy ( samples . begin (), samples . end (), result . mutable_data () );
+        return result;
+      }, py::arg("p"), py::arg("count"), py::arg("seed"), py::arg("thinning") = 1, py::arg("index") = 0)
+    .def("sample_indices", [](ParameterSampler const& self, ParameterGraph const& pg, std::vector<uint64_t> const& indices,
+                              uint64_t count, uint64_t seed, uint64_t thinning, uint64_t num_threads) {
+        std::vector<double> samples;
+        {
+          py::gil_scoped_release release;
+          samples = self . sample_indices ( pg, indices, count, seed, thinning, num_threads );
+        }
+        uint64_t rows = indices . size () * count;
+        uint64_t columns = rows ? samples . size () / rows : 0;
+        py::array_t<double> result ( { rows, columns } );
+        std::copy ( samples . begin (), samples . end (), result . mutable_data () );
+        return result;
+      }, py::arg("pg"), py::arg("indices"), py::arg("count"), py::arg("seed"), py::arg("thinning") = 1, py::arg("num_threads") = 0)
+    .def("names", &ParameterSampler::names);
 }
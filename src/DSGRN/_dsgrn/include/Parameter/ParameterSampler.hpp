@@ -31,15 +31,14 @@ ParameterSampler::assign
   network = network_arg;
   distribution = std::uniform_real_distribution<double>(0.0,1.0);
 
-  //std::cout << "Loading databases.\n";
-  std::vector<json> CAD_Databases;
   // Obtain folder path containing CAD databases
   std::string path = configuration() -> get_path() + "/CAD";
 
-  // Load the CAD databases one by one
+  // Open the CAD table of each network node (see CADTable)
   uint64_t D = network . size ();
+  tables . clear ();
   for ( uint64_t d = 0; d < D; ++ d ) {
-    // Construct CAD database file name for network node
+    // Construct CAD database name for network node
     uint64_t n = network . inputs ( d ) . size ();
     // Treat the no out edge case as one out edge
     uint64_t m = network . outputs ( d ) . size () ? network . outputs ( d ) . size () : 1;
@@ -47,51 +46,41 @@ ParameterSampler::assign
     std::stringstream ss;
     ss << path << "/" << n <<  "_" << m;
     for ( auto const& p : logic_struct ) ss <<  "_" << p.size();
-    ss << ".json";
-    // Make a new json object to store the file into
-    CAD_Databases . push_back ( json () );
-    json & J = CAD_Databases . back ();
-    // Load the file into the json object
-    // std::cout << "Reading " << ss.str () << "\n";
-    std::ifstream infile (ss.str());
-    if ( not infile.good() ) {
-      throw std::runtime_error("Missing CAD database " + ss.str() );
+    tables . push_back ( CADTable ( ss.str() ) );
+    if ( tables . back () . size () > 0 &&
+         ( tables . back () . inputs () != n || tables . back () . outputs () != m ) ) {
+      throw std::runtime_error("Inconsistent CAD database " + ss.str() );
     }
-    infile >> J;
-    infile.close();
-    //std::cout << "File read.\n";
   }
-  //std::cout << "Databases loaded.\n";
+}
 
-  instancelookups.resize(D);
-  for ( uint64_t d = 0; d < D; ++ d ) {
-    for ( auto const& entry : CAD_Databases[d] ) {
-      // Obtain hex code from database entry
-      std::string hex = entry["Hex"];
-      // Obtain instance from database entry
-      Instance instance;
-      auto json_instance = entry["Instance"];
-      for (json::iterator it = json_instance.begin();
-           it != json_instance.end(); 
-           ++it) 
-      {
-        instance[it.key()] = it.value();
-      }
-      // Enter instance lookup table entry
-      instancelookups[d][hex] = instance;
-    }
+inline auto
+ParameterSampler::Initial_Instance
+  (uint64_t d,
+   ParameterSampler::HexCode const& hex,
+   uint64_t factor) const
+  ->
+  double const*
+{
+  if ( factor < tables[d] . size () && tables[d] . hex ( factor ) == hex ) {
+    return tables[d] . instance ( factor );
+  }
+  uint64_t i = tables[d] . index ( hex );
+  if ( i == (uint64_t) -1 ) {
+    throw std::runtime_error("No CAD instance for logic parameter " + hex );
   }
+  return tables[d] . instance ( i );
 }
 
 inline auto
-ParameterSampler::Gibbs_Sampler
-  (ParameterSampler::HexCode const& hex, 
-   uint64_t n, 
+ParameterSampler::Gibbs_Initialize
+  (ParameterSampler::HexCode const& hex,
+   uint64_t n,
    uint64_t m,
-   std::vector<std::vector<uint64_t>> logic,
-   ParameterSampler::Instance const& initial ) const
+   std::vector<std::vector<uint64_t>> const& logic,
+   double const* initial ) const
   ->
-  ParameterSampler::Instance
+  ParameterSampler::GibbsChain
 {
   // The basic idea of the algorithm is as follows.
   // We have 2^n formulas of the form (L[1])(L[2]+U[3]) (for various U/L combinations)
@@ -106,245 +95,200 @@ ParameterSampler::Gibbs_Sampler
   // following manner:
   //     c < a*(b+x) < d  --> c/a-b < x < d/a - b
   //     Here a is the "coproduct" and "b" is the "cosum"
-  
-  uint64_t N = 1 << n;
-  uint64_t K = logic . size ();
-
-  // std::cout << "\nGibbsSampler\n";
-  // std::cout << "n = " << n << "\n";
-  // std::cout << "m = " << n << "\n";
-  // std::cout << "N = " << N << "\n";
-  // std::cout << "K = " << K << "\n";
+  GibbsChain chain;
+  chain . n = n;
+  chain . m = m;
+  chain . N = 1 << n;
+  chain . K = logic . size ();
+  uint64_t N = chain . N;
+  uint64_t K = chain . K;
 
   const double Inf = std::numeric_limits<double>::infinity();
 
-  // expsample
-  //   Sample according to exponential distribution conditioned on being
-  //   in the interval pair = (min, max)
-  auto expsample = [this](std::pair<double,double> const& pair) {
-      double A = std::exp(-pair.first);
-      double B = std::exp(-pair.second);
-      double mu = distribution(generator);
-      //std::cout << "expsample([" << pair.first << ", " << pair.second << "]) = " << -std::log(A - mu *(A-B)) << "\n";
-      double result = -std::log(A - mu *(A-B));
-      // if ( result < pair.first || result > pair.second ) {
-      //   throw std::logic_error("expsample did not return a value within bounds");
-      // }
-      return result;
-  };
-
   // Read initial instance into faster data structure
-  std::vector<double> L ( n );
-  std::vector<double> U ( n );
-  std::vector<double> T ( m );
-  for ( auto const& pair : initial ) {
-    uint64_t i = std::stoll(pair.first.substr(2,pair.first.size()-3));
-    switch ( pair.first[0] ) {
-      case 'L':
-        L[i-1] = pair.second;
-        break;
-      case 'U':
-        U[i-1] = pair.second;
-        break;
-      case 'T':
-        T[i-1] = pair.second;
-        break;
-    }
-  }
+  chain . L . assign ( initial, initial + n );
+  chain . U . assign ( initial + n, initial + 2 * n );
+  chain . T . assign ( initial + 2 * n, initial + 2 * n + m );
 
   // Initialize "computational tableau" to enable rapid iterations
-  //   which_factor[i] : which factor the ith L (or U) variable is in
-  //   sums[j][k]      : the sum of the terms of the kth factor in the jth L/U formula
-  //   products[j]     : the product of factors in the jth L/U formula
-  //   lower[j]        : threshold that is the greatest lower bound of the jth L/U formula. m+1 indicates no lower bound
-  //   upper[j]        : threshold that is the least upper bound  of the jth L/U formula. m indicates no upper bound
+  //   which_factor[i]    : which factor the ith L (or U) variable is in
+  //   sums[k*N+j]        : the sum of the terms of the kth factor in the jth L/U formula
+  //                        (factor-major, so a factor's sums are contiguous in j)
+  //   products[j]        : the product of factors in the jth L/U formula
+  //   lower[j]           : threshold that is the greatest lower bound of the jth L/U formula. m+1 indicates no lower bound
+  //   upper[j]           : threshold that is the least upper bound  of the jth L/U formula. m indicates no upper bound
+  //   lower_threshold[j] : T[lower[j]], kept up to date as the T's change
+  //   upper_threshold[j] : T[upper[j]]
   //   We set T[m] = Inf and T[m+1] = 0 so T[lower[j]] and T[[upper[j]] reflect lack of lower and upper bounds properly
-  std::vector<uint64_t> which_factor;
-  std::vector<std::vector<double>> sums;
-  std::vector<double> products;
-  std::vector<uint64_t> lower;
-  std::vector<uint64_t> upper;
-
-  // Compute "which_factor"
-  // std::cout << "Compute which_factor (maps variable index to formula factor).\n";
-  which_factor . resize ( n );
+  chain . which_factor . resize ( n );
   {
     uint64_t i = 0;
     for ( uint64_t k = 0; k < K; ++ k ) {
-      // std::cout << "  Inspecting factor " << k << "\n";
       uint64_t num_terms = logic [ k ] . size ();
-      // std::cout << "    There are " << num_terms << " summands in this factor\n";
-      uint64_t start = i;
-      uint64_t stop = i + num_terms;
-      for ( uint64_t j = start; j < stop; ++ j ) {
-        // std::cout << "  Assigning variable " << j << " to factor " << k << "\n";
-        // std::cout << "  e.g. which_factor[" << j << "] <- " << k << "\n";
-        which_factor[j] = k;
-      }
-      i = stop;
+      for ( uint64_t j = i; j < i + num_terms; ++ j ) chain . which_factor[j] = k;
+      i += num_terms;
     }
   }
 
-  // Compute "sums"
-  // std::cout << "Compute sums.\n";
-  sums . resize ( N, std::vector<double>(K, 0.0));;
+  chain . sums . assign ( K * N, 0.0 );
   for ( uint64_t j = 0; j < N; ++ j ) {
     uint64_t bit = 1;
     for ( uint64_t i = 0; i < n; ++ i ) {
-      // std::cout << "  variable " << i << " is in factor " << which_factor[i] << "\n";
-      sums[j][which_factor[i]] += ( j & bit ) ? U[i] : L[i];
+      chain . sums[chain . which_factor[i] * N + j] += ( j & bit ) ? chain . U[i] : chain . L[i];
       bit <<= 1;
-      // std::cout << "  sums[" << j << "][" << which_factor[i] << "] = " << sums[j][which_factor[i]] << "\n";
     }
   }
 
-  // Compute "products"
-  // std::cout << "Compute products.\n";
-  products . resize ( N, 1.0 );
+  chain . products . assign ( N, 1.0 );
   for ( uint64_t j = 0; j < N; ++ j ) {
-    // std::cout << "  products[" << j << "] = " << products[j] << "\n";
     for ( uint64_t k = 0; k < K; ++ k ) {
-      // std::cout << "    update via factor " << k << " with sums[" << j << "][" << k << "] = " << sums[j][k] << "\n";
-      products[j] *= sums[j][k]; 
-      // std::cout << "    products[" << j << "] <- " << products[j] << "\n";
+      chain . products[j] *= chain . sums[k * N + j];
     }
-    // std::cout << "  products[ " << j << "] <- " << products[j] << "\n";
   }
 
-  // Compute "lower" and "upper"
-  lower . resize ( N );
-  upper . resize ( N );
+  chain . lower . resize ( N );
+  chain . upper . resize ( N );
   LogicParameter lp ( n, m, hex );
-  // std::cout << "Scanning lower and upper threshold indices for each equation.\n";
   for ( uint64_t j = 0; j < N; ++ j ) {
     uint64_t bin = lp . bin ( j );
-    lower[j] = (bin == 0) ? m+1 : bin - 1;
-    upper[j] = bin;
-    // std::cout << " inequality " << j << " : bin = " << bin << " lower = " << lower[j]+1 << " and upper = " << upper[j]+1 << "\n";
+    chain . lower[j] = (bin == 0) ? m+1 : bin - 1;
+    chain . upper[j] = bin;
   }
   // Add special values to T so T[lower[j]] and T[[upper[j]] give what we want
-  T . push_back ( Inf ); // T[m]
-  T . push_back ( 0.0 ); // T[m+1]
+  chain . T . push_back ( Inf ); // T[m]
+  chain . T . push_back ( 0.0 ); // T[m+1]
+  chain . lower_threshold . resize ( N );
+  chain . upper_threshold . resize ( N );
+  for ( uint64_t j = 0; j < N; ++ j ) {
+    chain . lower_threshold[j] = chain . T[chain . lower[j]];
+    chain . upper_threshold[j] = chain . T[chain . upper[j]];
+  }
 
   // Temporary storage variables
-  std::vector<double> cofactor(N);
-  std::vector<double> cosum(N);
+  chain . cofactor . resize ( N );
+  chain . cosum . resize ( N );
+  return chain;
+}
+
+template < typename Uniform >
+inline auto
+ParameterSampler::Gibbs_Sweep
+  (ParameterSampler::GibbsChain & chain,
+   Uniform & uniform ) const
+  ->
+  void
+{
+  uint64_t n = chain . n;
+  uint64_t m = chain . m;
+  uint64_t N = chain . N;
+  std::vector<double> & L = chain . L;
+  std::vector<double> & U = chain . U;
+  std::vector<double> & T = chain . T;
+  double * products = chain . products . data ();
+  double * cofactor = chain . cofactor . data ();
+  double * cosum = chain . cosum . data ();
+  double const* lower_threshold = chain . lower_threshold . data ();
+  double const* upper_threshold = chain . upper_threshold . data ();
+
+  const double Inf = std::numeric_limits<double>::infinity();
+
+  // expsample
+  //   Sample according to exponential distribution conditioned on being
+  //   in the interval pair = (min, max)
+  auto expsample = [&](std::pair<double,double> const& pair) {
+      double A = std::exp(-pair.first);
+      double B = std::exp(-pair.second);
+      double mu = uniform();
+      return -std::log(A - mu *(A-B));
+  };
 
   typedef std::pair<double,double> Interval;
-  // Note: we use a mask/bit arguments to filter out all inequalities where we have L[i] instead of U[i]
-  //       or vice-versa as the case requires
+  // The inequalities j with (j & mask) == bit, i.e. those with L[i] (bit = 0)
+  // or U[i] (bit = mask) where mask = 1 << i, form blocks of mask consecutive
+  // j's every 2*mask, so the loops below run over contiguous arrays
   auto scan = [&](Interval & interval, uint64_t k, uint64_t mask, uint64_t bit, double var) {
-    double & min = interval.first;
-    double & max = interval.second;
-    // std::cout << "Scanning with initial interval (" << min << ", " << max << "), factor index = " 
-              // << k << ", mask = " << mask << ", bit = " << bit << ", var = " << var << "\n";
-    for ( uint64_t j = 0; j < N; ++ j ) {
-      if ( (j & mask) != bit ) continue; 
-      // std::cout << "  inequality " << j << "\n";
-      cofactor[j] = products[j]/sums[j][k];
-      cosum[j] = sums[j][k] - var;
-      // std::cout << "    Lower threshold = " << T[lower[j]] << "\n";
-      // std::cout << "    Upper threshold = " << T[upper[j]] << "\n";
-      // std::cout << "    cofactor["<<j<<"] = " << cofactor[j] << "\n";
-      // std::cout << "    cosum["<<j<<"] = " << cosum[j] << "\n";
-      // std::cout << "    products["<<j<<"] = " << products[j] << "\n";
-      // std::cout << "    sums["<<j<<","<<k<<"] = " << sums[j][k] << "\n";
-      // std::cout << "    var = " << var << "\n";
-      // std::cout << "    Intersecting with (" << T[lower[j]]/cofactor[j] - cosum[j] << ", " << T[upper[j]]/cofactor[j] - cosum[j] << ")\n";
-      min = std::max ( min, T[lower[j]]/cofactor[j] - cosum[j]);
-      max = std::min ( max, T[upper[j]]/cofactor[j] - cosum[j]);
+    double min = interval.first;
+    double max = interval.second;
+    double const* sums = chain . sums . data () + k * N;
+    for ( uint64_t block = bit; block < N; block += 2 * mask ) {
+      for ( uint64_t j = block; j < block + mask; ++ j ) {
+        cofactor[j] = products[j]/sums[j];
+        cosum[j] = sums[j] - var;
+        min = std::max ( min, lower_threshold[j]/cofactor[j] - cosum[j]);
+        max = std::min ( max, upper_threshold[j]/cofactor[j] - cosum[j]);
+      }
     }
-    // std::cout << "  returning with interval (" << min << ", " << max << ")\n";
+    interval = {min, max};
   };
   auto fix = [&](uint64_t k, uint64_t mask, uint64_t bit, double var) {
-    for ( uint64_t j = 0; j < N; ++ j ) {
-      if ( (j & mask) != bit ) continue; 
-      // std::cout << "fix: inequality " << j << "\n";
-      sums[j][k] = cosum[j] + var;
-      products[j] = cofactor[j] * sums[j][k];
-      // std::cout << "  products["<<j<<"] = " << products[j] << "\n";
-      // std::cout << "  sums["<<j<<","<<k<<"] = " << sums[j][k] << "\n";
+    double * sums = chain . sums . data () + k * N;
+    for ( uint64_t block = bit; block < N; block += 2 * mask ) {
+      for ( uint64_t j = block; j < block + mask; ++ j ) {
+        sums[j] = cosum[j] + var;
+        products[j] = cofactor[j] * sums[j];
+      }
     }
   };
-  int burn_in_limit = 10;
-  for ( uint64_t burn_in = 0; burn_in < burn_in_limit; ++ burn_in ) {
-    // std::cout << "===== round = " << burn_in << "\n";
-
-    // // j indices LUT formulas, of which there are N := 2^n of. 
-    // for ( uint64_t j = 0; j < N; ++ j ) {
-    //   std::cout << "j = " << j << "\n";
-    //   std::cout << "  lower threshold printindex for ineq j = " << lower[j]+1 << "\n";
-    //   std::cout << "  upper threshold printindex for ineq j = " << upper[j]+1 << "\n";
-
-    //   std::cout << "  T["<<lower[j] + 1 << "] = " << T[lower[j]] << " ";
-    //   for ( uint64_t i = 0; i < n; ++ i ) {
-    //     if ( ( j & (1 << i)) == 0 ) {
-    //       std::cout << "L[" << i+1 << "] = " << L[i] << " ";
-    //     } else {
-    //       std::cout << "U[" << i+1 << "] = " << U[i] << " ";
-    //     }
-    //   }
-    //   std::cout << "T["<<upper[j] + 1 << "] = " << T[upper[j]] << "\n";
-    // }
-
-    // Update L's
-    for ( uint64_t i = 0; i < n; ++ i ) {
-      uint64_t k = which_factor[i];
-      Interval interval = {0, U[i]};
-      // std::cout << "L[" << i+1 << "] update (current value is " << L[i] << ")\n";
-      // std::cout << "  Initial interval is 0 < L[" << i+1 << "] < U[" << i+1 << "] which gives (" << 0 << ", " << U[i] << ")\n";
-      scan(interval, k, 1 << i, 0, L[i]);
-      // std::cout << "  Fixing all other variables gives L[" << i+1 << "] in (" << interval.first << ", " << interval.second << ")\n";
-      L[i] = expsample(interval);
-      // std::cout << "  Updating L[" << i+1 << "] <- " << L[i] << "\n";
-      fix(k, 1 << i, 0, L[i]);
-    }
-    // Update U's
-    for ( uint64_t i = 0; i < n; ++ i ) {
-      uint64_t k = which_factor[i];
-      Interval interval = {L[i], Inf};
-      // std::cout << "U[" << i+1 << "] update (current value is " << U[i] << ")\n";
-      // std::cout << "  Initial interval is L[" << i+1 << "] < U[" << i+1 << "] < inf which gives (" << U[i] << ", inf )\n";
-      scan(interval, k, 1 << i, 1 << i, U[i]);
-      // std::cout << "  Fixing all other variables gives gives U[" << i+1 << "]  (" << interval.first << ", " << interval.second << ")\n";
-      U[i] = expsample(interval);
-      // std::cout << "  Updating U[" << i+1 << "] <- " << U[i] << "\n";
-      fix(k, 1 << i, 1 << i, U[i]);
+  // Update L's
+  for ( uint64_t i = 0; i < n; ++ i ) {
+    uint64_t k = chain . which_factor[i];
+    Interval interval = {0, U[i]};
+    scan(interval, k, 1 << i, 0, L[i]);
+    L[i] = expsample(interval);
+    fix(k, 1 << i, 0, L[i]);
+  }
+  // Update U's
+  for ( uint64_t i = 0; i < n; ++ i ) {
+    uint64_t k = chain . which_factor[i];
+    Interval interval = {L[i], Inf};
+    scan(interval, k, 1 << i, 1 << i, U[i]);
+    U[i] = expsample(interval);
+    fix(k, 1 << i, 1 << i, U[i]);
+  }
+  // Update T's
+  for ( uint64_t i = 0; i < m; ++ i ) {
+    Interval interval;
+    double & min = interval.first;
+    double & max = interval.second;
+    min = ( i == 0 ) ? 0.0 : T[i-1];
+    max = ( i == (m-1) ) ? Inf : T[i+1];
+    for ( uint64_t j = 0; j < N; ++ j ) {
+      if ( chain . lower[j] == i ) max = std::min(max,products[j]);
+      if ( chain . upper[j] == i ) min = std::max(min,products[j]);
     }
-    // Update T's
-    for ( uint64_t i = 0; i < m; ++ i ) {
-      Interval interval;
-      double & min = interval.first;
-      double & max = interval.second;
-      min = ( i == 0 ) ? 0.0 : T[i-1];
-      max = ( i == (m-1) ) ? Inf : T[i+1];
-      // std::cout << "T[" << (i+1) << "] (currently = " << T[i] << ")\n";
-      // std::cout << "  Initial interval is  ( T[" << i << "] = " << min << ", T[" << i+2 << "] = " << max << ")\n";
-      for ( uint64_t j = 0; j < N; ++ j ) {
-        if ( lower[j] == i ) { 
-          // std::cout << "  Intersecting with (0, " << products[j] << ") due to inequality " << j << "\n";
-          max = std::min(max,products[j]);
-        }
-        if ( upper[j] == i ) { 
-          // std::cout << "  Intersecting with (" << products[j] << ", inf) due to inequality " << j << "\n";
-          min = std::max(min,products[j]);
-        }
-      }
-      // std::cout << "  Constraints give interval is  [T[" << i << "] in (" << min << ", " << max << ")\n";
-      T[i] = expsample(interval);
-      // std::cout << "  T[" << (i+1) << "] <- " << T[i] << "\n";
+    T[i] = expsample(interval);
+    for ( uint64_t j = 0; j < N; ++ j ) {
+      if ( chain . lower[j] == i ) chain . lower_threshold[j] = T[i];
+      if ( chain . upper[j] == i ) chain . upper_threshold[j] = T[i];
     }
   }
+}
+
+template < typename Uniform >
+inline auto
+ParameterSampler::Gibbs_Sampler
+  (ParameterSampler::HexCode const& hex, 
+   uint64_t n, 
+   uint64_t m,
+   std::vector<std::vector<uint64_t>> logic,
+   double const* initial,
+   Uniform & uniform ) const
+  ->
+  ParameterSampler::Instance
+{
+  GibbsChain chain = Gibbs_Initialize ( hex, n, m, logic, initial );
+  for ( uint64_t burn_in = 0; burn_in < burn_in_limit; ++ burn_in ) {
+    Gibbs_Sweep ( chain, uniform );
+  }
   // Create Instance object containing result
   Instance result;
   for ( uint64_t i = 0; i < n; ++ i ) {
-    result["L[" + std::to_string(i+1) + "]"] = L[i];
-    result["U[" + std::to_string(i+1) + "]"] = U[i];
+    result["L[" + std::to_string(i+1) + "]"] = chain . L[i];
+    result["U[" + std::to_string(i+1) + "]"] = chain . U[i];
   }
   for ( uint64_t i = 0; i < m; ++ i ) {
-    result["T[" + std::to_string(i+1) + "]"] = T[i];
+    result["T[" + std::to_string(i+1) + "]"] = chain . T[i];
   }
-  // std::cout << "DEBUG: Check this. Hex = " << hex << " and " << InstanceToString(result) << "\n";
   return result;
 }
 
@@ -408,9 +352,11 @@ ParameterSampler::InstanceToString
   return ss . str ();
 }
 
+template < typename UniformOfNode >
 inline auto
-ParameterSampler::sample
-  (Parameter p) const
+ParameterSampler::Sample_String
+  (Parameter const& p,
+   UniformOfNode const& uniform) const
   ->
   std::string
 {
@@ -422,11 +368,12 @@ ParameterSampler::sample
     // Obtain hex code
     HexCode const& hex = logic[d].hex();
     // Obtain initial instance to seed Gibbs sampling with
-    Instance const& instance = instancelookups[d].at(hex);
+    double const* instance = Initial_Instance ( d, hex );
     // Perform Gibbs sampling
     uint64_t m = network . outputs ( d ) . size () ? network . outputs ( d ) . size () : 1;
+    auto node_uniform = uniform ( d );
     Instance sampled = Gibbs_Sampler ( hex, network.inputs(d).size(),
-                                       m, network.logic(d), instance );
+                                       m, network.logic(d), instance, node_uniform );
     // Record parameters for network node
     instances . push_back ( sampled );
   }
@@ -437,3 +384,160 @@ ParameterSampler::sample
   ss << "{\"Parameter\":" << InstanceToString(named_parameters) << "}";
   return ss . str ();
 }
+
+inline auto
+ParameterSampler::sample
+  (Parameter p) const
+  ->
+  std::string
+{
+  // Every node draws from the generator of the sampler
+  return Sample_String ( p, [this](uint64_t) {
+    return [this]() { return distribution(generator); };
+  });
+}
+
+inline auto
+ParameterSampler::sample
+  (Parameter p, uint64_t seed, uint64_t index) const
+  ->
+  std::string
+{
+  return Sample_String ( p, [&](uint64_t d) {
+    return PhiloxStream ( seed, index, d );
+  });
+}
+
+inline auto
+ParameterSampler::names
+  (Parameter p) const
+  ->
+  std::vector<std::string>
+{
+  // Same names as Name_Parameters, in the column order of sample_many
+  uint64_t D = network . size ();
+  std::vector<OrderParameter> const& order = p . order ();
+  std::vector<std::string> result;
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    std::string const& name = network . name ( d );
+    for ( uint64_t input : network . inputs ( d ) ) {
+      result . push_back ( "L[" + network . name ( input ) + "->" + name + "]" );
+    }
+    for ( uint64_t input : network . inputs ( d ) ) {
+      result . push_back ( "U[" + network . name ( input ) + "->" + name + "]" );
+    }
+    // Treat the no out edge case as one out edge
+    uint64_t m = network . outputs ( d ) . size () ? network . outputs ( d ) . size () : 1;
+    for ( uint64_t i = 0; i < m; ++ i ) {
+      std::string output_name = "";
+      if ( network . outputs ( d ) . size () ) {
+        output_name = network . name ( network . outputs(d) [ order[d](i) ] );
+      }
+      result . push_back ( "T[" + name + "->" + output_name + "]" );
+    }
+  }
+  return result;
+}
+
+inline auto
+ParameterSampler::Sample_Rows
+  (Parameter const& p,
+   uint64_t count,
+   uint64_t seed,
+   uint64_t thinning,
+   uint64_t index,
+   double * rows,
+   uint64_t columns,
+   uint64_t const* factors) const
+  ->
+  void
+{
+  uint64_t D = network . size ();
+  std::vector<LogicParameter> const& logic = p . logic ();
+  if ( thinning == 0 ) thinning = 1;
+  // The nodes are sampled independently, each by its own chain and stream
+  uint64_t column = 0;
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    HexCode const& hex = logic[d].hex();
+    uint64_t n = network . inputs ( d ) . size ();
+    uint64_t m = network . outputs ( d ) . size () ? network . outputs ( d ) . size () : 1;
+    PhiloxStream uniform ( seed, index, d );
+    GibbsChain chain = Gibbs_Initialize ( hex, n, m, network . logic ( d ), Initial_Instance ( d, hex, factors ? factors [ d ] : -1 ) );
+    for ( uint64_t burn_in = 0; burn_in < burn_in_limit; ++ burn_in ) Gibbs_Sweep ( chain, uniform );
+    for ( uint64_t s = 0; s < count; ++ s ) {
+      if ( s > 0 ) for ( uint64_t t = 0; t < thinning; ++ t ) Gibbs_Sweep ( chain, uniform );
+      double * row = rows + s * columns + column;
+      std::copy ( chain . L . begin (), chain . L . end (), row );
+      std::copy ( chain . U . begin (), chain . U . end (), row + n );
+      std::copy ( chain . T . begin (), chain . T . begin () + m, row + 2 * n );
+    }
+    column += 2 * n + m;
+  }
+}
+
+inline auto
+ParameterSampler::sample_many
+  (Parameter p, uint64_t count, uint64_t seed, uint64_t thinning, uint64_t index) const
+  ->
+  std::vector<double>
+{
+  uint64_t columns = names ( p ) . size ();
+  std::vector<double> result ( count * columns );
+  Sample_Rows ( p, count, seed, thinning, index, result . data (), columns );
+  return result;
+}
+
+inline auto
+ParameterSampler::sample_indices
+  (ParameterGraph const& pg,
+   std::vector<uint64_t> const& indices,
+   uint64_t count,
+   uint64_t seed,
+   uint64_t thinning,
+   uint64_t num_threads) const
+  ->
+  std::vector<double>
+{
+  uint64_t columns = 0;
+  for ( uint64_t d = 0; d < network . size (); ++ d ) {
+    uint64_t m = network . outputs ( d ) . size () ? network . outputs ( d ) . size () : 1;
+    columns += 2 * network . inputs ( d ) . size () + m;
+  }
+  for ( uint64_t index : indices ) {
+    if ( index >= pg . size () ) throw std::invalid_argument ( "ParameterSampler::sample_indices: parameter index out of range" );
+  }
+  std::vector<double> result ( indices . size () * count * columns );
+  if ( num_threads == 0 ) num_threads = std::max ( 1u, std::thread::hardware_concurrency () );
+  num_threads = std::min<uint64_t> ( num_threads, std::max<uint64_t> ( 1, indices . size () ) );
+  // Each parameter writes its own block of rows from its own streams, so
+  // the order in which threads claim parameters does not matter
+  std::atomic<uint64_t> next ( 0 );
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto work = [&]() {
+    try {
+      // The logic coordinates are the low digits of the index (see
+      // ParameterGraph::coordinates), so the CAD rows need no hex lookup
+      std::vector<uint64_t> factors ( network . size () );
+      for ( uint64_t k = next ++; k < indices . size (); k = next ++ ) {
+        Parameter p = pg . parameter ( indices [ k ] );
+        uint64_t logic_index = indices [ k ] % pg . fixedordersize ();
+        for ( uint64_t d = 0; d < network . size (); ++ d ) {
+          factors [ d ] = logic_index % pg . logicsize ( d );
+          logic_index /= pg . logicsize ( d );
+        }
+        Sample_Rows ( p, count, seed, thinning, indices [ k ], result . data () + k * count * columns, columns, factors . data () );
+      }
+    } catch ( ... ) {
+      std::lock_guard<std::mutex> lock ( error_mutex );
+      if ( not error ) error = std::current_exception ();
+      next = indices . size ();
+    }
+  };
+  std::vector<std::thread> threads;
+  for ( uint64_t t = 1; t < num_threads; ++ t ) threads . emplace_back ( work );
+  work ();
+  for ( auto & thread : threads ) thread . join ();
+  if ( error ) std::rethrow_exception ( error );
+  return result;
+}
@@ -0,0 +1,128 @@
+/// LinearPathMatcher.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Pattern/PatternGraph.h"
+#include "Pattern/MultiPatternGraph.h"
+#include "Pattern/PatternMatch.h"
+
+struct LinearPathMatcher_;
+
+/// LinearPathMatcher
+///   Path matching against the search graph of a label sequence (see
+///   SearchGraph ( labels, dim )) without building it. The search graph
+///   is a chain, so its matching graph is a layered automaton run: the
+///   set of pattern positions at which a match can stand at the current
+///   label is kept as a bitset and advanced one label at a time, by
+///   intermediate matches (positions whose label admits the next label)
+///   and extremal matches (positions reached by PatternGraph::consume on
+///   the edge label). A pattern has a path match iff a position holding
+///   its leaf is ever in the set. Each step costs O(|PG|/64) words per
+///   bit of the label plus one consume per live position.
+class LinearPathMatcher {
+public:
+  /// LinearPathMatcher
+  ///   Default constructor
+  LinearPathMatcher ( void );
+
+  /// LinearPathMatcher
+  ///   Prepare matching of a pattern graph
+  LinearPathMatcher ( PatternGraph const& pg );
+
+  /// LinearPathMatcher
+  ///   Prepare matching of each pattern of merged pattern graphs
+  LinearPathMatcher ( MultiPatternGraph const& mpg );
+
+  /// assign
+  ///   Prepare matching of a pattern graph
+  void
+  assign ( PatternGraph const& pg );
+
+  /// assign
+  ///   Prepare matching of each pattern of merged pattern graphs
+  void
+  assign ( MultiPatternGraph const& mpg );
+
+  /// dimension
+  uint64_t
+  dimension ( void ) const;
+
+  /// patterns
+  ///   Return the number of patterns (1 for a pattern graph)
+  uint64_t
+  patterns ( void ) const;
+
+  /// query
+  ///   Determine if there is a path match of some pattern in the
+  ///   search graph of the label sequence
+  bool
+  query ( std::vector<uint64_t> const& labels ) const;
+
+  /// matches
+  ///   Determine, for each pattern, if there is a path match in the
+  ///   search graph of the label sequence
+  std::vector<bool>
+  matches ( std::vector<uint64_t> const& labels ) const;
+
+  /// matches
+  ///   As above, for the "length" labels starting at "labels", reusing
+  ///   "workspace" (so the labels may be read in place, e.g. from a
+  ///   memory-mapped file)
+  std::vector<bool>
+  matches ( uint64_t const* labels, uint64_t length, PatternMatchWorkspace & workspace ) const;
+
+private:
+  /// assign_automaton
+  ///   Build the bitset tables from the labels of the positions, the
+  ///   root positions, the consumed positions of each (position, slot)
+  ///   and the patterns accepted at each position
+  void
+  assign_automaton ( uint64_t dimension,
+                     uint64_t patterns,
+                     std::vector<uint64_t> const& labels,
+                     std::vector<uint64_t> const& roots,
+                     std::vector<std::vector<uint64_t>> const& consume,
+                     std::vector<std::vector<uint64_t>> const& accepts );
+
+  std::shared_ptr<LinearPathMatcher_> data_;
+};
+
+struct LinearPathMatcher_ {
+  uint64_t dimension_;
+  uint64_t size_;
+  uint64_t words_;
+  uint64_t patterns_;
+  /// bitsets of size_ positions, words_ words each
+  std::vector<uint64_t> roots_;
+  std::vector<uint64_t> accepting_;
+  /// masks_ [ b * words_ ... ] is the set of positions whose label has bit b
+  std::vector<uint64_t> masks_;
+  /// consumed positions (see PatternGraph_::consume_): the targets of
+  /// position v on slot s are targets_[begin_[v*(2D+1)+s]] ... targets_[begin_[v*(2D+1)+s+1]-1]
+  std::vector<uint64_t> begin_;
+  std::vector<uint64_t> targets_;
+  /// accepts_[v] lists the patterns whose leaf is position v
+  std::vector<std::vector<uint64_t>> accepts_;
+};
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+inline void
+LinearPathMatcherBinding (py::module &m) {
+  py::class_<LinearPathMatcher, std::shared_ptr<LinearPathMatcher>>(m, "LinearPathMatcher")
+    .def(py::init<>())
+    .def(py::init<PatternGraph const&>())
+    .def(py::init<MultiPatternGraph const&>())
+    .def("dimension", &LinearPathMatcher::dimension)
+    .def("patterns", &LinearPathMatcher::patterns)
+    .def("query", &LinearPathMatcher::query)
+    .def("matches", (std::vector<bool>(LinearPathMatcher::*)(std::vector<uint64_t> const&)const)&LinearPathMatcher::matches);
+}
@@ -0,0 +1,196 @@
+/// LinearPathMatcher.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#ifndef INLINE_IF_HEADER_ONLY
+#define INLINE_IF_HEADER_ONLY
+#endif
+
+#include "LinearPathMatcher.h"
+
+/// Index of the lowest set bit of a nonzero word
+inline uint64_t
+LinearPathMatcherLowestBit ( uint64_t word ) {
+#if defined(__GNUC__)
+  return __builtin_ctzll ( word );
+#else
+  uint64_t bit = 0;
+  while ( not ( word & 1 ) ) { word >>= 1; ++ bit; }
+  return bit;
+#endif
+}
+
+INLINE_IF_HEADER_ONLY LinearPathMatcher::
+LinearPathMatcher ( void ) {
+  data_ . reset ( new LinearPathMatcher_ );
+  data_ -> dimension_ = 0;
+  data_ -> size_ = 0;
+  data_ -> words_ = 0;
+  data_ -> patterns_ = 0;
+}
+
+INLINE_IF_HEADER_ONLY LinearPathMatcher::
+LinearPathMatcher ( PatternGraph const& pg ) {
+  assign ( pg );
+}
+
+INLINE_IF_HEADER_ONLY LinearPathMatcher::
+LinearPathMatcher ( MultiPatternGraph const& mpg ) {
+  assign ( mpg );
+}
+
+INLINE_IF_HEADER_ONLY void LinearPathMatcher::
+assign ( PatternGraph const& pg ) {
+  uint64_t P = pg . size ();
+  uint64_t slots = 2 * pg . dimension () + 1;
+  std::vector<uint64_t> labels ( P );
+  std::vector<std::vector<uint64_t>> consume ( P * slots );
+  std::vector<std::vector<uint64_t>> accepts ( P );
+  for ( uint64_t v = 0; v < P; ++ v ) {
+    labels [ v ] = pg . label ( v );
+    for ( uint64_t slot = 0; slot < slots; ++ slot ) {
+      uint64_t edge_label = ( slot == 0 ) ? 0 : ( 1LL << ( slot - 1 ) );
+      uint64_t u = pg . consume ( v, edge_label );
+      if ( u != (uint64_t) -1 ) consume [ v * slots + slot ] . push_back ( u );
+    }
+  }
+  accepts [ pg . leaf () ] . push_back ( 0 );
+  assign_automaton ( pg . dimension (), 1, labels, { pg . root () }, consume, accepts );
+}
+
+INLINE_IF_HEADER_ONLY void LinearPathMatcher::
+assign ( MultiPatternGraph const& mpg ) {
+  uint64_t P = mpg . size ();
+  uint64_t slots = 2 * mpg . dimension () + 1;
+  std::vector<uint64_t> labels ( P );
+  std::vector<std::vector<uint64_t>> consume ( P * slots );
+  std::vector<std::vector<uint64_t>> accepts ( P );
+  for ( uint64_t v = 0; v < P; ++ v ) {
+    labels [ v ] = mpg . label ( v );
+    for ( uint64_t slot = 0; slot < slots; ++ slot ) {
+      uint64_t edge_label = ( slot == 0 ) ? 0 : ( 1LL << ( slot - 1 ) );
+      consume [ v * slots + slot ] = mpg . consume ( v, edge_label );
+    }
+    accepts [ v ] = mpg . accepts ( v );
+  }
+  assign_automaton ( mpg . dimension (), mpg . patterns (), labels, mpg . roots (), consume, accepts );
+}
+
+INLINE_IF_HEADER_ONLY void LinearPathMatcher::
+assign_automaton ( uint64_t dimension,
+                   uint64_t patterns,
+                   std::vector<uint64_t> const& labels,
+                   std::vector<uint64_t> const& roots,
+                   std::vector<std::vector<uint64_t>> const& consume,
+                   std::vector<std::vector<uint64_t>> const& accepts ) {
+  data_ . reset ( new LinearPathMatcher_ );
+  uint64_t P = labels . size ();
+  uint64_t W = ( P + 63 ) / 64;
+  data_ -> dimension_ = dimension;
+  data_ -> size_ = P;
+  data_ -> words_ = W;
+  data_ -> patterns_ = patterns;
+  data_ -> roots_ . assign ( W, 0 );
+  for ( uint64_t v : roots ) data_ -> roots_ [ v >> 6 ] |= 1ULL << ( v & 63 );
+  data_ -> accepting_ . assign ( W, 0 );
+  data_ -> accepts_ = accepts;
+  for ( uint64_t v = 0; v < P; ++ v ) {
+    if ( not accepts [ v ] . empty () ) data_ -> accepting_ [ v >> 6 ] |= 1ULL << ( v & 63 );
+  }
+  data_ -> masks_ . assign ( 2 * dimension * W, 0 );
+  for ( uint64_t v = 0; v < P; ++ v ) {
+    for ( uint64_t b = 0; b < 2 * dimension; ++ b ) {
+      if ( labels [ v ] & ( 1ULL << b ) ) data_ -> masks_ [ b * W + ( v >> 6 ) ] |= 1ULL << ( v & 63 );
+    }
+  }
+  data_ -> begin_ . assign ( consume . size () + 1, 0 );
+  data_ -> targets_ . clear ();
+  for ( uint64_t i = 0; i < consume . size (); ++ i ) {
+    data_ -> targets_ . insert ( data_ -> targets_ . end (), consume [ i ] . begin (), consume [ i ] . end () );
+    data_ -> begin_ [ i + 1 ] = data_ -> targets_ . size ();
+  }
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LinearPathMatcher::
+dimension ( void ) const {
+  return data_ -> dimension_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LinearPathMatcher::
+patterns ( void ) const {
+  return data_ -> patterns_;
+}
+
+INLINE_IF_HEADER_ONLY bool LinearPathMatcher::
+query ( std::vector<uint64_t> const& labels ) const {
+  std::vector<bool> result = matches ( labels );
+  return std::find ( result . begin (), result . end (), true ) != result . end ();
+}
+
+INLINE_IF_HEADER_ONLY std::vector<bool> LinearPathMatcher::
+matches ( std::vector<uint64_t> const& labels ) const {
+  PatternMatchWorkspace workspace;
+  return matches ( labels . data (), labels . size (), workspace );
+}
+
+INLINE_IF_HEADER_ONLY std::vector<bool> LinearPathMatcher::
+matches ( uint64_t const* labels, uint64_t length, PatternMatchWorkspace & workspace ) const {
+  uint64_t K = patterns ();
+  uint64_t W = data_ -> words_;
+  uint64_t slots = 2 * dimension () + 1;
+  std::vector<bool> result ( K, false );
+  uint64_t remaining = K;
+  if ( K == 0 || W == 0 ) return result;
+  std::vector<uint64_t> & states = workspace . states_;
+  std::vector<uint64_t> & next = workspace . next_states_;
+  states . assign ( W, 0 );
+  next . assign ( W, 0 );
+  for ( uint64_t t = 0; t < length; ++ t ) {
+    // Matches may start at any label
+    for ( uint64_t w = 0; w < W; ++ w ) next [ w ] = data_ -> roots_ [ w ];
+    if ( t > 0 ) {
+      // Intermediate matches
+      for ( uint64_t w = 0; w < W; ++ w ) next [ w ] |= states [ w ];
+      // Extremal matches, on the edge label of the chain (see SearchGraph::assign)
+      uint64_t edge_label = ( labels [ t - 1 ] ^ labels [ t ] ) & labels [ t ];
+      uint64_t slot = PatternGraphSlot ( edge_label );
+      if ( slot < slots ) {
+        for ( uint64_t w = 0; w < W; ++ w ) {
+          for ( uint64_t word = states [ w ]; word; word &= word - 1 ) {
+            uint64_t i = ( ( w << 6 ) + LinearPathMatcherLowestBit ( word ) ) * slots + slot;
+            for ( uint64_t k = data_ -> begin_ [ i ]; k < data_ -> begin_ [ i + 1 ]; ++ k ) {
+              uint64_t u = data_ -> targets_ [ k ];
+              next [ u >> 6 ] |= 1ULL << ( u & 63 );
+            }
+          }
+        }
+      }
+    }
+    // Keep the positions whose label admits the search label (see
+    // MatchingGraph::query): those having every bit of it
+    for ( uint64_t search_label = labels [ t ]; search_label; search_label &= search_label - 1 ) {
+      uint64_t b = LinearPathMatcherLowestBit ( search_label );
+      if ( b >= 2 * dimension () ) {
+        std::fill ( next . begin (), next . end (), 0 );
+        break;
+      }
+      uint64_t const* mask = & data_ -> masks_ [ b * W ];
+      for ( uint64_t w = 0; w < W; ++ w ) next [ w ] &= mask [ w ];
+    }
+    std::swap ( states, next );
+    // Record the patterns whose leaf is reached
+    for ( uint64_t w = 0; w < W; ++ w ) {
+      for ( uint64_t word = states [ w ] & data_ -> accepting_ [ w ]; word; word &= word - 1 ) {
+        for ( uint64_t k : data_ -> accepts_ [ ( w << 6 ) + LinearPathMatcherLowestBit ( word ) ] ) {
+          if ( result [ k ] ) continue;
+          result [ k ] = true;
+          -- remaining;
+        }
+      }
+    }
+    if ( remaining == 0 ) break;
+  }
+  return result;
+}
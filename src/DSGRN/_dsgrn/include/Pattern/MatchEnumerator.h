@@ -0,0 +1,140 @@
+/// MatchEnumerator.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Pattern/MatchingGraph.h"
+
+struct MatchEnumerator_;
+
+/// MatchEnumerator
+///   Count and lazily enumerate the matches in a matching graph.
+///   Intermediate matches may cycle inside a pattern layer, so the
+///   part of the matching graph reachable from the roots is condensed
+///   into its strongly connected components; a match is a path through
+///   this component DAG from a root (domain, root) to a leaf vertex
+///   (the leaf (domain, leaf) for cycle matches). Each enumerated match
+///   is returned as a witness path through the matching graph, and
+///   distinct matches give distinct witnesses.
+class MatchEnumerator {
+public:
+  /// MatchEnumerator
+  ///   Default constructor
+  MatchEnumerator ( void );
+
+  /// MatchEnumerator
+  ///   Enumerate cycle matches (cycle = true) or path matches
+  ///   (cycle = false) of the matching graph "mg"
+  MatchEnumerator ( MatchingGraph const& mg, bool cycle );
+
+  /// assign
+  ///   Enumerate cycle matches (cycle = true) or path matches
+  ///   (cycle = false) of the matching graph "mg"
+  void
+  assign ( MatchingGraph const& mg, bool cycle );
+
+  /// count
+  ///   Return the number of matches, computed by dynamic programming
+  ///   over the component DAG. Saturates at 2^64-1.
+  uint64_t
+  count ( void ) const;
+
+  /// next
+  ///   Return a witness path of the next match, or an empty
+  ///   path if all matches have been enumerated
+  std::vector<MatchingGraph::Vertex>
+  next ( void );
+
+  /// take
+  ///   Return witness paths of (at most) the next K matches
+  std::vector<std::vector<MatchingGraph::Vertex>>
+  take ( uint64_t K );
+
+private:
+  /// start
+  ///   Prepare the enumeration from the current start
+  void
+  start ( void );
+
+  /// witness
+  ///   Build a matching graph path following the component path
+  ///   on the enumeration stack
+  std::vector<MatchingGraph::Vertex>
+  witness ( void ) const;
+
+  /// connect
+  ///   Append to "path" a path inside the component of local vertex
+  ///   "source" from "source" to "target" (or to a leaf vertex if
+  ///   "target" is -1), excluding "source" itself
+  void
+  connect ( uint64_t source, uint64_t target, std::vector<MatchingGraph::Vertex> & path ) const;
+
+  /// paths
+  ///   Set "memo" to the number of paths from each component to the
+  ///   component "target", or to any component containing a leaf
+  ///   vertex if "target" is -1
+  void
+  paths ( uint64_t target, std::vector<uint64_t> & memo ) const;
+
+  std::shared_ptr<MatchEnumerator_> data_;
+};
+
+struct MatchEnumerator_ {
+  MatchingGraph mg_;
+  bool cycle_;
+  // Reachable part of the matching graph
+  std::vector<uint64_t> local_;     // dense index -> local index (-1 if unreachable)
+  std::vector<uint64_t> vertices_;  // local index -> dense index
+  std::vector<uint64_t> component_; // local index -> component
+  std::vector<bool> terminal_;      // component contains a leaf vertex
+  // Component DAG and, for each edge, a matching graph edge (local indices) realizing it
+  std::vector<std::vector<uint64_t>> successors_;
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> witnesses_;
+  std::vector<uint64_t> topological_;
+  // Starts (local source vertex, local target vertex or -1), grouped by target component
+  std::vector<std::pair<uint64_t,uint64_t>> starts_;
+  uint64_t count_;
+  // Enumeration state
+  uint64_t start_;
+  bool started_;
+  uint64_t memo_target_;
+  std::vector<uint64_t> memo_;
+  std::vector<std::pair<uint64_t,uint64_t>> stack_; // (component, next successor slot)
+};
+
+/// CountCycleMatches
+///   Return the number of cycle matches (see MatchEnumerator)
+uint64_t
+CountCycleMatches ( MatchingGraph const& mg );
+
+/// CountPathMatches
+///   Return the number of path matches (see MatchEnumerator)
+uint64_t
+CountPathMatches ( MatchingGraph const& mg );
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+inline void
+MatchEnumeratorBinding (py::module &m) {
+  py::class_<MatchEnumerator, std::shared_ptr<MatchEnumerator>>(m, "MatchEnumerator")
+    .def(py::init<>())
+    .def(py::init<MatchingGraph const&, bool>(), py::arg("mg"), py::arg("cycle") = true)
+    .def("count", &MatchEnumerator::count)
+    .def("next", &MatchEnumerator::next)
+    .def("take", &MatchEnumerator::take)
+    .def("__iter__", [](MatchEnumerator & e) -> MatchEnumerator & { return e; })
+    .def("__next__", [](MatchEnumerator & e) {
+      std::vector<MatchingGraph::Vertex> path = e . next ();
+      if ( path . empty () ) throw py::stop_iteration ();
+      return path;
+    });
+  m.def("CountCycleMatches", &CountCycleMatches);
+  m.def("CountPathMatches", &CountPathMatches);
+}
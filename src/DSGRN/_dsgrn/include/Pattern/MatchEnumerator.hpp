@@ -0,0 +1,278 @@
+/// MatchEnumerator.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#ifndef INLINE_IF_HEADER_ONLY
+#define INLINE_IF_HEADER_ONLY
+#endif
+
+#include "MatchEnumerator.h"
+#include "Graph/StrongComponents.h"
+
+INLINE_IF_HEADER_ONLY MatchEnumerator::
+MatchEnumerator ( void ) {
+  data_ . reset ( new MatchEnumerator_ );
+  data_ -> count_ = 0;
+  data_ -> start_ = 0;
+  data_ -> started_ = false;
+}
+
+INLINE_IF_HEADER_ONLY MatchEnumerator::
+MatchEnumerator ( MatchingGraph const& mg, bool cycle ) {
+  assign ( mg, cycle );
+}
+
+INLINE_IF_HEADER_ONLY void MatchEnumerator::
+assign ( MatchingGraph const& mg, bool cycle ) {
+  data_ . reset ( new MatchEnumerator_ );
+  data_ -> mg_ = mg;
+  data_ -> cycle_ = cycle;
+  uint64_t N = mg . searchgraph () . size ();
+  uint64_t root = mg . patterngraph () . root ();
+  uint64_t leaf = mg . patterngraph () . leaf ();
+  std::vector<uint64_t> & local = data_ -> local_;
+  std::vector<uint64_t> & vertices = data_ -> vertices_;
+  local . assign ( mg . size (), -1 );
+  // Starts
+  std::vector<std::pair<uint64_t,uint64_t>> starts;
+  for ( uint64_t domain = 0; domain < N; ++ domain ) {
+    if ( not mg . query ( {domain, root} ) ) continue;
+    if ( cycle && not mg . query ( {domain, leaf} ) ) continue;
+    starts . push_back ( { mg . index ( {domain, root} ),
+                           cycle ? mg . index ( {domain, leaf} ) : -1 } );
+  }
+  // Reachable part of the matching graph
+  std::vector<uint64_t> dfs_stack;
+  for ( auto const& s : starts ) {
+    if ( local [ s . first ] != (uint64_t) -1 ) continue;
+    local [ s . first ] = vertices . size ();
+    vertices . push_back ( s . first );
+    dfs_stack . push_back ( s . first );
+  }
+  while ( not dfs_stack . empty () ) {
+    uint64_t v = dfs_stack . back ();
+    dfs_stack . pop_back ();
+    for ( uint64_t u : mg . successors ( v ) ) {
+      if ( local [ u ] != (uint64_t) -1 ) continue;
+      local [ u ] = vertices . size ();
+      vertices . push_back ( u );
+      dfs_stack . push_back ( u );
+    }
+  }
+  uint64_t R = vertices . size ();
+  Digraph digraph;
+  digraph . resize ( R );
+  for ( uint64_t v = 0; v < R; ++ v ) {
+    for ( uint64_t u : mg . successors ( vertices [ v ] ) ) digraph . add_edge ( v, local [ u ] );
+  }
+  // Condensation
+  Components components = StrongComponents ( digraph );
+  uint64_t C = components . size ();
+  data_ -> component_ . resize ( R );
+  data_ -> terminal_ . assign ( C, false );
+  for ( uint64_t v = 0; v < R; ++ v ) {
+    uint64_t c = components . whichComponent ( v );
+    data_ -> component_ [ v ] = c;
+    if ( mg . vertex ( vertices [ v ] ) . second == leaf ) data_ -> terminal_ [ c ] = true;
+  }
+  data_ -> successors_ . assign ( C, std::vector<uint64_t> () );
+  data_ -> witnesses_ . assign ( C, std::vector<std::pair<uint64_t,uint64_t>> () );
+  std::vector<uint64_t> indegree ( C, 0 );
+  for ( uint64_t v = 0; v < R; ++ v ) {
+    uint64_t c = data_ -> component_ [ v ];
+    for ( uint64_t u : digraph . adjacencies ( v ) ) {
+      uint64_t d = data_ -> component_ [ u ];
+      if ( c == d ) continue;
+      // Record each component DAG edge once, with the first
+      // matching graph edge realizing it
+      auto & succ = data_ -> successors_ [ c ];
+      if ( std::find ( succ . begin (), succ . end (), d ) != succ . end () ) continue;
+      succ . push_back ( d );
+      data_ -> witnesses_ [ c ] . push_back ( { v, u } );
+      ++ indegree [ d ];
+    }
+  }
+  // Topological order (Kahn)
+  std::vector<uint64_t> & order = data_ -> topological_;
+  order . clear ();
+  for ( uint64_t c = 0; c < C; ++ c ) if ( indegree [ c ] == 0 ) order . push_back ( c );
+  for ( uint64_t i = 0; i < order . size (); ++ i ) {
+    for ( uint64_t d : data_ -> successors_ [ order [ i ] ] ) {
+      if ( -- indegree [ d ] == 0 ) order . push_back ( d );
+    }
+  }
+  // Starts in local indices, grouped by target component
+  data_ -> starts_ . clear ();
+  for ( auto const& s : starts ) {
+    data_ -> starts_ . push_back ( { local [ s . first ],
+                                     ( s . second == (uint64_t) -1 || local [ s . second ] == (uint64_t) -1 ) ? -1 : local [ s . second ] } );
+  }
+  if ( cycle ) {
+    // Cycle starts whose leaf is unreachable have no matches
+    auto & S = data_ -> starts_;
+    S . erase ( std::remove_if ( S . begin (), S . end (),
+      [](std::pair<uint64_t,uint64_t> const& s){ return s . second == (uint64_t) -1; } ), S . end () );
+    std::stable_sort ( S . begin (), S . end (),
+      [&](std::pair<uint64_t,uint64_t> const& a, std::pair<uint64_t,uint64_t> const& b) {
+        return data_ -> component_ [ a . second ] < data_ -> component_ [ b . second ]; } );
+  }
+  // Count
+  data_ -> count_ = 0;
+  std::vector<uint64_t> memo;
+  uint64_t memo_target = -2;
+  for ( auto const& s : data_ -> starts_ ) {
+    uint64_t target = ( s . second == (uint64_t) -1 ) ? -1 : data_ -> component_ [ s . second ];
+    if ( target != memo_target ) {
+      paths ( target, memo );
+      memo_target = target;
+    }
+    uint64_t n = memo [ data_ -> component_ [ s . first ] ];
+    data_ -> count_ = ( data_ -> count_ + n < n ) ? -1 : data_ -> count_ + n;
+  }
+  // Enumeration state
+  data_ -> start_ = 0;
+  data_ -> started_ = false;
+  data_ -> memo_target_ = -2;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MatchEnumerator::
+count ( void ) const {
+  return data_ -> count_;
+}
+
+INLINE_IF_HEADER_ONLY void MatchEnumerator::
+paths ( uint64_t target, std::vector<uint64_t> & memo ) const {
+  std::vector<uint64_t> const& order = data_ -> topological_;
+  memo . assign ( data_ -> successors_ . size (), 0 );
+  for ( auto it = order . rbegin (); it != order . rend (); ++ it ) {
+    uint64_t c = *it;
+    uint64_t n = ( target == (uint64_t) -1 ) ? ( data_ -> terminal_ [ c ] ? 1 : 0 ) : ( c == target ? 1 : 0 );
+    for ( uint64_t d : data_ -> successors_ [ c ] ) {
+      n = ( n + memo [ d ] < n ) ? -1 : n + memo [ d ];
+    }
+    memo [ c ] = n;
+  }
+}
+
+INLINE_IF_HEADER_ONLY void MatchEnumerator::
+start ( void ) {
+  auto const& s = data_ -> starts_ [ data_ -> start_ ];
+  uint64_t target = ( s . second == (uint64_t) -1 ) ? -1 : data_ -> component_ [ s . second ];
+  if ( target != data_ -> memo_target_ ) {
+    paths ( target, data_ -> memo_ );
+    data_ -> memo_target_ = target;
+  }
+  data_ -> stack_ . clear ();
+  data_ -> started_ = true;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex> MatchEnumerator::
+next ( void ) {
+  auto & stack = data_ -> stack_;
+  auto const& memo = data_ -> memo_;
+  while ( data_ -> start_ < data_ -> starts_ . size () ) {
+    auto const& s = data_ -> starts_ [ data_ -> start_ ];
+    uint64_t target = ( s . second == (uint64_t) -1 ) ? -1 : data_ -> component_ [ s . second ];
+    auto is_target = [&](uint64_t c) {
+      return ( target == (uint64_t) -1 ) ? (bool) data_ -> terminal_ [ c ] : c == target;
+    };
+    if ( not data_ -> started_ ) {
+      start ();
+      uint64_t c = data_ -> component_ [ s . first ];
+      if ( memo [ c ] > 0 ) {
+        stack . push_back ( { c, 0 } );
+        if ( is_target ( c ) ) return witness ();
+      }
+    }
+    // Resume depth-first traversal of the component DAG, only
+    // entering components from which a target can be reached
+    while ( not stack . empty () ) {
+      auto & top = stack . back ();
+      auto const& successors = data_ -> successors_ [ top . first ];
+      if ( top . second == successors . size () ) {
+        stack . pop_back ();
+        continue;
+      }
+      uint64_t d = successors [ top . second ++ ];
+      if ( memo [ d ] == 0 ) continue;
+      stack . push_back ( { d, 0 } );
+      if ( is_target ( d ) ) return witness ();
+    }
+    data_ -> started_ = false;
+    ++ data_ -> start_;
+  }
+  return std::vector<MatchingGraph::Vertex> ();
+}
+
+INLINE_IF_HEADER_ONLY std::vector<std::vector<MatchingGraph::Vertex>> MatchEnumerator::
+take ( uint64_t K ) {
+  std::vector<std::vector<MatchingGraph::Vertex>> result;
+  while ( result . size () < K ) {
+    std::vector<MatchingGraph::Vertex> path = next ();
+    if ( path . empty () ) break;
+    result . push_back ( path );
+  }
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex> MatchEnumerator::
+witness ( void ) const {
+  auto const& s = data_ -> starts_ [ data_ -> start_ ];
+  auto const& stack = data_ -> stack_;
+  std::vector<MatchingGraph::Vertex> path;
+  uint64_t v = s . first;
+  path . push_back ( data_ -> mg_ . vertex ( data_ -> vertices_ [ v ] ) );
+  for ( uint64_t i = 0; i + 1 < stack . size (); ++ i ) {
+    // The edge taken out of stack[i] is the one before its next slot
+    auto const& edge = data_ -> witnesses_ [ stack [ i ] . first ] [ stack [ i ] . second - 1 ];
+    connect ( v, edge . first, path );
+    v = edge . second;
+    path . push_back ( data_ -> mg_ . vertex ( data_ -> vertices_ [ v ] ) );
+  }
+  connect ( v, s . second, path );
+  return path;
+}
+
+INLINE_IF_HEADER_ONLY void MatchEnumerator::
+connect ( uint64_t source, uint64_t target, std::vector<MatchingGraph::Vertex> & path ) const {
+  MatchingGraph const& mg = data_ -> mg_;
+  uint64_t leaf = mg . patterngraph () . leaf ();
+  uint64_t c = data_ -> component_ [ source ];
+  auto done = [&](uint64_t v) {
+    return ( target == (uint64_t) -1 ) ? mg . vertex ( data_ -> vertices_ [ v ] ) . second == leaf : v == target;
+  };
+  if ( done ( source ) ) return;
+  // Breadth-first search inside the component
+  std::unordered_map<uint64_t, uint64_t> parent;
+  std::deque<uint64_t> queue;
+  parent [ source ] = source;
+  queue . push_back ( source );
+  while ( not queue . empty () ) {
+    uint64_t v = queue . front ();
+    queue . pop_front ();
+    for ( uint64_t w : mg . successors ( data_ -> vertices_ [ v ] ) ) {
+      uint64_t u = data_ -> local_ [ w ];
+      if ( data_ -> component_ [ u ] != c || parent . count ( u ) ) continue;
+      parent [ u ] = v;
+      if ( done ( u ) ) {
+        std::vector<MatchingGraph::Vertex> segment;
+        for ( ; u != source; u = parent [ u ] ) segment . push_back ( mg . vertex ( data_ -> vertices_ [ u ] ) );
+        path . insert ( path . end (), segment . rbegin (), segment . rend () );
+        return;
+      }
+      queue . push_back ( u );
+    }
+  }
+}
+
+INLINE_IF_HEADER_ONLY uint64_t
+CountCycleMatches ( MatchingGraph const& mg ) {
+  return MatchEnumerator ( mg, true ) . count ();
+}
+
+INLINE_IF_HEADER_ONLY uint64_t
+CountPathMatches ( MatchingGraph const& mg ) {
+  return MatchEnumerator ( mg, false ) . count ();
+}
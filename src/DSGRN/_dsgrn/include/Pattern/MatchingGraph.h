@@ -44,6 +44,11 @@ public:
   ///   position 
   typedef std::pair<uint64_t,uint64_t> Vertex;
 
+  /// SuccessorIterator, Successors
+  ///   Allocation-free iteration over out-edge adjacencies (see below)
+  class SuccessorIterator;
+  class Successors;
+
   /// query
   ///   Given a (domain, position) pair, determine if it is
   ///   a vertex in the matching graph
@@ -56,6 +61,13 @@ public:
   std::vector<Vertex>
   adjacencies ( Vertex const& v ) const;
 
+  /// successors
+  ///   Given the dense index i of a vertex, return a range over the
+  ///   dense indices of its out-edge adjacencies. Unlike adjacencies
+  ///   this allocates nothing and does not sort.
+  Successors
+  successors ( uint64_t i ) const;
+
   /// roots
   ///   Give the elements of the form (domain, root)
   ///   in the matching graph
@@ -80,6 +92,22 @@ public:
   Vertex
   vertex ( uint64_t domain, uint64_t position ) const;
 
+  /// size
+  ///   Return the number of dense vertex indices, i.e. the number of
+  ///   (domain, position) pairs. Not all of them are vertices.
+  uint64_t
+  size ( void ) const;
+
+  /// index
+  ///   Return the dense index domain * |PG| + position of a vertex
+  uint64_t
+  index ( Vertex const& v ) const;
+
+  /// vertex
+  ///   Return the vertex with dense index i
+  Vertex
+  vertex ( uint64_t i ) const;
+
   /// graphviz
   ///   Return a graphviz representation of the matching graph
   std::string
@@ -97,6 +125,57 @@ private:
 struct MatchingGraph_ {
   PatternGraph pg_;
   SearchGraph sg_;
+  uint64_t positions_ = 0;
+};
+
+/// MatchingGraph::SuccessorIterator
+///   Forward iterator over the dense indices of the successors of
+///   (domain, position). Each search graph edge (domain, nextdomain)
+///   yields at most two: the intermediate match (nextdomain, position)
+///   and the extremal match (nextdomain, consume(position, event)).
+class MatchingGraph::SuccessorIterator {
+public:
+  SuccessorIterator ( MatchingGraph const* mg, uint64_t domain, uint64_t position, uint64_t edge );
+
+  uint64_t
+  operator * ( void ) const;
+
+  SuccessorIterator &
+  operator ++ ( void );
+
+  bool
+  operator != ( SuccessorIterator const& rhs ) const;
+
+private:
+  /// settle
+  ///   Advance to the first successor at or after the current position
+  void
+  settle ( void );
+
+  MatchingGraph const* mg_;
+  std::vector<uint64_t> const* adjacencies_;
+  uint64_t domain_;
+  uint64_t position_;
+  uint64_t edge_;
+  uint64_t stage_; // 0 = intermediate match, 1 = extremal match
+  uint64_t current_;
+};
+
+/// MatchingGraph::Successors
+///   Range of successors, for use in range-based for loops
+class MatchingGraph::Successors {
+public:
+  Successors ( SuccessorIterator const& begin, SuccessorIterator const& end );
+
+  SuccessorIterator
+  begin ( void ) const;
+
+  SuccessorIterator
+  end ( void ) const;
+
+private:
+  SuccessorIterator begin_;
+  SuccessorIterator end_;
 };
 
 /// Python Bindings
@@ -117,7 +196,10 @@ MatchingGraphBinding (py::module &m) {
     .def("roots", &MatchingGraph::roots)
     .def("domain", &MatchingGraph::domain)
     .def("position", &MatchingGraph::position)
-    .def("vertex", &MatchingGraph::vertex)
+    .def("vertex", static_cast<MatchingGraph::Vertex(MatchingGraph::*)(uint64_t,uint64_t)const>(&MatchingGraph::vertex))
+    .def("vertex", static_cast<MatchingGraph::Vertex(MatchingGraph::*)(uint64_t)const>(&MatchingGraph::vertex))
+    .def("size", &MatchingGraph::size)
+    .def("index", &MatchingGraph::index)
     .def("graphviz", &MatchingGraph::graphviz)
     .def("graphviz_with_highlighted_path", &MatchingGraph::graphviz_with_highlighted_path);
 }
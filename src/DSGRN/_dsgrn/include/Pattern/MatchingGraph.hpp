@@ -26,6 +26,7 @@ assign ( SearchGraph const& sg, PatternGraph const& pg ) {
   data_ . reset ( new MatchingGraph_ );
   data_ -> sg_ = sg;
   data_ -> pg_ = pg;
+  data_ -> positions_ = pg . size ();
 }
 
 INLINE_IF_HEADER_ONLY SearchGraph const& MatchingGraph::
@@ -48,23 +49,20 @@ query ( Vertex const& v ) const {
 INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex> MatchingGraph::
 adjacencies ( Vertex const& v ) const {
   std::vector<Vertex> result;
-  uint64_t const& domain = v . first;
-  uint64_t const& position = v . second;
-  for ( auto nextdomain : searchgraph() . adjacencies(domain) ) {
-    // Check for intermediate match
-    if ( query ( {nextdomain, position} ) ) result . push_back ( {nextdomain, position} );
-    // Check for extremal match
-    // Determine which event occurs between domains (min/max on a given variable, encoded as signed integer
-    uint64_t edge_label = searchgraph() . event ( domain, nextdomain );
-    // Find successor in pattern graph which consumes event
-    uint64_t nextposition = patterngraph() . consume ( position, edge_label );
-    if ( nextposition == -1 ) continue;
-    if ( query ( {nextdomain, nextposition} ) ) result . push_back ( {nextdomain, nextposition} );
-  }
+  for ( uint64_t u : successors ( index ( v ) ) ) result . push_back ( vertex ( u ) );
   std::sort ( result.begin(), result.end() );
   return result;
 }
 
+INLINE_IF_HEADER_ONLY MatchingGraph::Successors MatchingGraph::
+successors ( uint64_t i ) const {
+  uint64_t domain = i / data_ -> positions_;
+  uint64_t position = i % data_ -> positions_;
+  uint64_t degree = searchgraph () . adjacencies ( domain ) . size ();
+  return Successors ( SuccessorIterator ( this, domain, position, 0 ),
+                      SuccessorIterator ( this, domain, position, degree ) );
+}
+
 INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex> MatchingGraph::
 roots ( void ) const {
   std::vector<Vertex> result;
@@ -90,6 +88,21 @@ vertex ( uint64_t domain, uint64_t position ) const {
   return Vertex ( {domain, position} );
 }
 
+INLINE_IF_HEADER_ONLY uint64_t MatchingGraph::
+size ( void ) const {
+  return searchgraph () . size () * data_ -> positions_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MatchingGraph::
+index ( Vertex const& v ) const {
+  return v . first * data_ -> positions_ + v . second;
+}
+
+INLINE_IF_HEADER_ONLY MatchingGraph::Vertex MatchingGraph::
+vertex ( uint64_t i ) const {
+  return Vertex ( {i / data_ -> positions_, i % data_ -> positions_} );
+}
+
 INLINE_IF_HEADER_ONLY std::string MatchingGraph::
 graphviz ( void ) const {
   return graphviz_with_highlighted_path( {} );
@@ -140,3 +153,69 @@ graphviz_with_highlighted_path ( std::vector<MatchingGraph::Vertex> const& path
   ss << "}\n";
   return ss . str ();
 }
+
+INLINE_IF_HEADER_ONLY MatchingGraph::SuccessorIterator::
+SuccessorIterator ( MatchingGraph const* mg, uint64_t domain, uint64_t position, uint64_t edge ) :
+  mg_(mg), domain_(domain), position_(position), edge_(edge), stage_(0) {
+  adjacencies_ = & mg_ -> searchgraph () . adjacencies ( domain_ );
+  settle ();
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MatchingGraph::SuccessorIterator::
+operator * ( void ) const {
+  return current_;
+}
+
+INLINE_IF_HEADER_ONLY MatchingGraph::SuccessorIterator & MatchingGraph::SuccessorIterator::
+operator ++ ( void ) {
+  if ( stage_ == 0 ) {
+    stage_ = 1;
+  } else {
+    stage_ = 0;
+    ++ edge_;
+  }
+  settle ();
+  return *this;
+}
+
+INLINE_IF_HEADER_ONLY bool MatchingGraph::SuccessorIterator::
+operator != ( SuccessorIterator const& rhs ) const {
+  return edge_ != rhs . edge_ || stage_ != rhs . stage_;
+}
+
+INLINE_IF_HEADER_ONLY void MatchingGraph::SuccessorIterator::
+settle ( void ) {
+  while ( edge_ < adjacencies_ -> size () ) {
+    uint64_t nextdomain = (*adjacencies_) [ edge_ ];
+    // Check for intermediate match
+    if ( stage_ == 0 ) {
+      if ( mg_ -> query ( {nextdomain, position_} ) ) {
+        current_ = mg_ -> index ( {nextdomain, position_} );
+        return;
+      }
+      stage_ = 1;
+    }
+    // Check for extremal match
+    uint64_t edge_label = mg_ -> searchgraph () . edge_label ( domain_, edge_ );
+    uint64_t nextposition = mg_ -> patterngraph () . consume ( position_, edge_label );
+    if ( nextposition != -1 && mg_ -> query ( {nextdomain, nextposition} ) ) {
+      current_ = mg_ -> index ( {nextdomain, nextposition} );
+      return;
+    }
+    stage_ = 0;
+    ++ edge_;
+  }
+}
+
+INLINE_IF_HEADER_ONLY MatchingGraph::Successors::
+Successors ( SuccessorIterator const& begin, SuccessorIterator const& end ) : begin_(begin), end_(end) {}
+
+INLINE_IF_HEADER_ONLY MatchingGraph::SuccessorIterator MatchingGraph::Successors::
+begin ( void ) const {
+  return begin_;
+}
+
+INLINE_IF_HEADER_ONLY MatchingGraph::SuccessorIterator MatchingGraph::Successors::
+end ( void ) const {
+  return end_;
+}
@@ -40,6 +40,17 @@ public:
   std::string
   edge_labelstring ( uint64_t label ) const;  
 
+  /// vertex_labelstring
+  ///   As above, for a label given by its words, least significant
+  ///   first (e.g. LazyDomainGraph::wide_label)
+  std::string
+  vertex_labelstring ( std::vector<uint64_t> const& label ) const;
+
+  /// edge_labelstring
+  ///   As above, for a label given by its words
+  std::string
+  edge_labelstring ( std::vector<uint64_t> const& label ) const;
+
 private:
   uint64_t dimension_;
 };
@@ -57,6 +68,8 @@ MatchingRelationBinding (py::module &m) {
     .def(py::init<uint64_t>())
     .def("assign", &MatchingRelation::assign)
     .def("dimension", &MatchingRelation::dimension)
-    .def("vertex_labelstring", &MatchingRelation::vertex_labelstring)
-    .def("edge_labelstring", &MatchingRelation::edge_labelstring);
+    .def("vertex_labelstring", (std::string(MatchingRelation::*)(uint64_t)const)&MatchingRelation::vertex_labelstring)
+    .def("vertex_labelstring", (std::string(MatchingRelation::*)(std::vector<uint64_t> const&)const)&MatchingRelation::vertex_labelstring)
+    .def("edge_labelstring", (std::string(MatchingRelation::*)(uint64_t)const)&MatchingRelation::edge_labelstring)
+    .def("edge_labelstring", (std::string(MatchingRelation::*)(std::vector<uint64_t> const&)const)&MatchingRelation::edge_labelstring);
 }
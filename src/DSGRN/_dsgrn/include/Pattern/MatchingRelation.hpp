@@ -33,9 +33,9 @@ INLINE_IF_HEADER_ONLY std::string MatchingRelation::
 vertex_labelstring ( uint64_t L ) const {
   std::string result;
   for ( uint64_t d = 0; d < dimension(); ++ d ){
-    if ( L & ( 1 << d ) ) { 
+    if ( L & ( 1ULL << d ) ) { 
       result.push_back('D');
-    } else if ( L & ( 1 << (d + dimension() ) ) ) { 
+    } else if ( L & ( 1ULL << (d + dimension() ) ) ) { 
       result.push_back('I');
     } else {
       result.push_back('*');
@@ -49,7 +49,42 @@ edge_labelstring ( uint64_t L ) const {
   std::string result;
   uint64_t D = dimension();
   for ( uint64_t d = 0; d < D; ++ d ) {
-    int type = ((L & (1 << d)) >> d) | ((L & (1 << (d + D))) >> (d + D - 1));
+    int type = ((L >> d) & 1) | (((L >> (d + D)) & 1) << 1);
+    if ( type == 0 ) result.push_back('-');
+    if ( type == 1 ) result.push_back('M');
+    if ( type == 2 ) result.push_back('m');
+    if ( type == 3 ) result.push_back('*');
+  }
+  return result;
+};
+
+/// Bit i of a label given by its words, least significant first
+inline bool
+MatchingRelationBit ( std::vector<uint64_t> const& L, uint64_t i ) {
+  return ( i >> 6 ) < L . size () && ( ( L [ i >> 6 ] >> ( i & 63 ) ) & 1 );
+}
+
+INLINE_IF_HEADER_ONLY std::string MatchingRelation::
+vertex_labelstring ( std::vector<uint64_t> const& L ) const {
+  std::string result;
+  for ( uint64_t d = 0; d < dimension(); ++ d ){
+    if ( MatchingRelationBit ( L, d ) ) { 
+      result.push_back('D');
+    } else if ( MatchingRelationBit ( L, d + dimension() ) ) { 
+      result.push_back('I');
+    } else {
+      result.push_back('*');
+    }
+  }
+  return result;
+};
+
+INLINE_IF_HEADER_ONLY std::string MatchingRelation::
+edge_labelstring ( std::vector<uint64_t> const& L ) const {
+  std::string result;
+  uint64_t D = dimension();
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    int type = MatchingRelationBit ( L, d ) | ( MatchingRelationBit ( L, d + D ) << 1 );
     if ( type == 0 ) result.push_back('-');
     if ( type == 1 ) result.push_back('M');
     if ( type == 2 ) result.push_back('m');
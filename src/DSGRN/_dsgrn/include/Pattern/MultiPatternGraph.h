@@ -0,0 +1,132 @@
+/// MultiPatternGraph.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Pattern/PatternGraph.h"
+
+struct MultiPatternGraph_;
+
+/// MultiPatternGraph
+///   Several pattern graphs merged into one automaton, so that a
+///   single traversal of a search graph tests all of them. A vertex
+///   is a set of (pattern, position) pairs, at most one per pattern,
+///   whose positions all carry the same label. It is built by a
+///   subset construction from the roots: pattern positions reached by
+///   the same sequence of consumed events and having the same label
+///   share a vertex, so patterns with common prefixes share the
+///   traversal of those prefixes. Because positions with different
+///   labels are kept apart, an edge label may lead to several vertices.
+class MultiPatternGraph {
+public:
+  /// MultiPatternGraph
+  ///   Default constructor
+  MultiPatternGraph ( void );
+
+  /// MultiPatternGraph
+  ///   Merge pattern graphs (which must have the same dimension)
+  MultiPatternGraph ( std::vector<PatternGraph> const& patterngraphs );
+
+  /// assign
+  ///   Merge pattern graphs (which must have the same dimension)
+  void
+  assign ( std::vector<PatternGraph> const& patterngraphs );
+
+  /// size
+  ///   Return the number of vertices
+  uint64_t
+  size ( void ) const;
+
+  /// dimension
+  uint64_t
+  dimension ( void ) const;
+
+  /// patterns
+  ///   Return the number of merged pattern graphs
+  uint64_t
+  patterns ( void ) const;
+
+  /// patterngraph
+  ///   Return the kth merged pattern graph
+  PatternGraph const&
+  patterngraph ( uint64_t k ) const;
+
+  /// roots
+  ///   Return the vertices containing the roots of the pattern graphs
+  std::vector<uint64_t> const&
+  roots ( void ) const;
+
+  /// root
+  ///   Return the vertex containing the root of the kth pattern graph
+  uint64_t
+  root ( uint64_t k ) const;
+
+  /// label
+  ///   Return the label shared by the positions of vertex v
+  uint64_t
+  label ( uint64_t v ) const;
+
+  /// positions
+  ///   Return the (pattern, position) pairs of vertex v, sorted by pattern
+  std::vector<std::pair<uint64_t,uint64_t>> const&
+  positions ( uint64_t v ) const;
+
+  /// accepts
+  ///   Return the patterns whose leaf is in vertex v
+  std::vector<uint64_t> const&
+  accepts ( uint64_t v ) const;
+
+  /// consume
+  ///   Given a vertex v and an edge label, return the vertices reached by
+  ///   consuming the edge label in each pattern of v (see PatternGraph::consume)
+  std::vector<uint64_t> const&
+  consume ( uint64_t v, uint64_t edge_label ) const;
+
+  /// graphviz
+  ///   Return a graphviz representation of the merged pattern graph
+  std::string
+  graphviz ( void ) const;
+
+private:
+  std::shared_ptr<MultiPatternGraph_> data_;
+};
+
+struct MultiPatternGraph_ {
+  uint64_t dimension_;
+  std::vector<PatternGraph> patterngraphs_;
+  std::vector<uint64_t> roots_;
+  std::vector<uint64_t> root_;
+  std::vector<uint64_t> labels_;
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> positions_;
+  std::vector<std::vector<uint64_t>> accepts_;
+  /// consume_ [ v * (2D+1) + slot ] lists the vertices reached from v
+  /// on the edge label of the slot (see PatternGraph_::consume_)
+  std::vector<std::vector<uint64_t>> consume_;
+};
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+inline void
+MultiPatternGraphBinding (py::module &m) {
+  py::class_<MultiPatternGraph, std::shared_ptr<MultiPatternGraph>>(m, "MultiPatternGraph")
+    .def(py::init<>())
+    .def(py::init<std::vector<PatternGraph> const&>())
+    .def("size", &MultiPatternGraph::size)
+    .def("dimension", &MultiPatternGraph::dimension)
+    .def("patterns", &MultiPatternGraph::patterns)
+    .def("patterngraph", &MultiPatternGraph::patterngraph)
+    .def("roots", &MultiPatternGraph::roots)
+    .def("root", &MultiPatternGraph::root)
+    .def("label", &MultiPatternGraph::label)
+    .def("positions", &MultiPatternGraph::positions)
+    .def("accepts", &MultiPatternGraph::accepts)
+    .def("consume", &MultiPatternGraph::consume)
+    .def("graphviz", &MultiPatternGraph::graphviz);
+}
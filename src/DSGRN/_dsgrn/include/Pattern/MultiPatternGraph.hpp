@@ -0,0 +1,164 @@
+/// MultiPatternGraph.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#ifndef INLINE_IF_HEADER_ONLY
+#define INLINE_IF_HEADER_ONLY
+#endif
+
+#include "Pattern/MultiPatternGraph.h"
+#include "Pattern/MatchingRelation.h"
+
+INLINE_IF_HEADER_ONLY MultiPatternGraph::
+MultiPatternGraph ( void ) {
+  data_ . reset ( new MultiPatternGraph_ );
+  data_ -> dimension_ = 0;
+}
+
+INLINE_IF_HEADER_ONLY MultiPatternGraph::
+MultiPatternGraph ( std::vector<PatternGraph> const& patterngraphs ) {
+  assign ( patterngraphs );
+}
+
+INLINE_IF_HEADER_ONLY void MultiPatternGraph::
+assign ( std::vector<PatternGraph> const& patterngraphs ) {
+  typedef std::vector<std::pair<uint64_t,uint64_t>> State;
+  data_ . reset ( new MultiPatternGraph_ );
+  data_ -> patterngraphs_ = patterngraphs;
+  data_ -> dimension_ = patterngraphs . empty () ? 0 : patterngraphs[0] . dimension ();
+  for ( auto const& pg : patterngraphs ) {
+    if ( pg . dimension () != dimension () ) {
+      throw std::invalid_argument ( "MultiPatternGraph: pattern graphs must have the same dimension" );
+    }
+  }
+  uint64_t slots = 2 * dimension () + 1;
+  std::map<State, uint64_t> vertices;
+  std::stack<uint64_t> recursion_stack;
+  // Return the vertex of a state, creating it if newly discovered
+  auto intern = [&](State const& state, uint64_t label) {
+    auto it = vertices . find ( state );
+    if ( it != vertices . end () ) return it -> second;
+    uint64_t v = data_ -> labels_ . size ();
+    vertices [ state ] = v;
+    data_ -> labels_ . push_back ( label );
+    data_ -> positions_ . push_back ( state );
+    data_ -> accepts_ . push_back ( std::vector<uint64_t> () );
+    for ( auto const& p : state ) {
+      if ( p . second == patterngraphs [ p . first ] . leaf () ) data_ -> accepts_ [ v ] . push_back ( p . first );
+    }
+    data_ -> consume_ . resize ( ( v + 1 ) * slots );
+    recursion_stack . push ( v );
+    return v;
+  };
+  // Group the pattern positions of "pairs" by label
+  auto split = [&](State const& pairs) {
+    std::map<uint64_t, State> groups;
+    for ( auto const& p : pairs ) {
+      groups [ patterngraphs [ p . first ] . label ( p . second ) ] . push_back ( p );
+    }
+    return groups;
+  };
+  State roots;
+  for ( uint64_t k = 0; k < patterngraphs . size (); ++ k ) roots . push_back ( { k, patterngraphs[k] . root () } );
+  data_ -> root_ . resize ( patterngraphs . size () );
+  for ( auto const& group : split ( roots ) ) {
+    uint64_t v = intern ( group . second, group . first );
+    data_ -> roots_ . push_back ( v );
+    for ( auto const& p : group . second ) data_ -> root_ [ p . first ] = v;
+  }
+  while ( not recursion_stack . empty () ) {
+    uint64_t v = recursion_stack . top ();
+    recursion_stack . pop ();
+    for ( uint64_t slot = 0; slot < slots; ++ slot ) {
+      uint64_t edge_label = ( slot == 0 ) ? 0 : ( 1LL << ( slot - 1 ) );
+      State next;
+      for ( auto const& p : data_ -> positions_ [ v ] ) {
+        uint64_t position = patterngraphs [ p . first ] . consume ( p . second, edge_label );
+        if ( position != (uint64_t) -1 ) next . push_back ( { p . first, position } );
+      }
+      for ( auto const& group : split ( next ) ) {
+        uint64_t u = intern ( group . second, group . first );
+        data_ -> consume_ [ v * slots + slot ] . push_back ( u );
+      }
+    }
+  }
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MultiPatternGraph::
+size ( void ) const {
+  return data_ -> labels_ . size ();
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MultiPatternGraph::
+dimension ( void ) const {
+  return data_ -> dimension_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MultiPatternGraph::
+patterns ( void ) const {
+  return data_ -> patterngraphs_ . size ();
+}
+
+INLINE_IF_HEADER_ONLY PatternGraph const& MultiPatternGraph::
+patterngraph ( uint64_t k ) const {
+  return data_ -> patterngraphs_ [ k ];
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> const& MultiPatternGraph::
+roots ( void ) const {
+  return data_ -> roots_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MultiPatternGraph::
+root ( uint64_t k ) const {
+  return data_ -> root_ [ k ];
+}
+
+INLINE_IF_HEADER_ONLY uint64_t MultiPatternGraph::
+label ( uint64_t v ) const {
+  return data_ -> labels_ [ v ];
+}
+
+INLINE_IF_HEADER_ONLY std::vector<std::pair<uint64_t,uint64_t>> const& MultiPatternGraph::
+positions ( uint64_t v ) const {
+  return data_ -> positions_ [ v ];
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> const& MultiPatternGraph::
+accepts ( uint64_t v ) const {
+  return data_ -> accepts_ [ v ];
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> const& MultiPatternGraph::
+consume ( uint64_t v, uint64_t edge_label ) const {
+  static const std::vector<uint64_t> none;
+  uint64_t slot = PatternGraphSlot ( edge_label );
+  if ( slot >= 2 * dimension () + 1 ) return none;
+  return data_ -> consume_ [ v * ( 2 * dimension () + 1 ) + slot ];
+}
+
+INLINE_IF_HEADER_ONLY std::string MultiPatternGraph::
+graphviz ( void ) const {
+  MatchingRelation mr(dimension());
+  std::stringstream ss;
+  ss << "digraph {\n";
+  for ( uint64_t vertex = 0; vertex < size (); ++ vertex ) {
+    ss << vertex << "[label=\"" << vertex << ":" << mr.vertex_labelstring(label ( vertex ));
+    for ( auto const& p : positions ( vertex ) ) ss << " " << p . first << "." << p . second;
+    ss << "\"";
+    if ( not accepts ( vertex ) . empty () ) ss << " shape=doublecircle";
+    ss << "];\n";
+  }
+  for ( uint64_t source = 0; source < size (); ++ source ) {
+    for ( uint64_t slot = 0; slot < 2 * dimension () + 1; ++ slot ) {
+      uint64_t edge_label = ( slot == 0 ) ? 0 : ( 1LL << ( slot - 1 ) );
+      for ( uint64_t target : consume ( source, edge_label ) ) {
+        ss << source << " -> " << target << " [label=\"" << mr.edge_labelstring(edge_label) << "\"];\n";
+      }
+    }
+  }
+  ss << "}\n";
+  return ss . str ();
+}
@@ -0,0 +1,52 @@
+/// MultiPatternMatch.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Pattern/SearchGraph.h"
+#include "Pattern/MultiPatternGraph.h"
+#include "Pattern/PatternMatch.h"
+
+/// QueryCycleMatches
+///   Determine, for each pattern of "mpg", if there is a cycle match
+///   in the search graph "sg". The matching graph of sg and the merged
+///   pattern graph is traversed once per start domain, for all patterns
+///   whose root is in the start vertex. A backward pass first marks the
+///   vertices from which some cycle can be closed, and the traversals are
+///   confined to them.
+std::vector<bool>
+QueryCycleMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg );
+
+/// QueryCycleMatches
+///   As above, reusing "workspace"
+std::vector<bool>
+QueryCycleMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg, PatternMatchWorkspace & workspace );
+
+/// QueryPathMatches
+///   Determine, for each pattern of "mpg", if there is a path match
+///   in the search graph "sg", with a single traversal
+std::vector<bool>
+QueryPathMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg );
+
+/// QueryPathMatches
+///   As above, reusing "workspace"
+std::vector<bool>
+QueryPathMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg, PatternMatchWorkspace & workspace );
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+inline
+void MultiPatternMatchBinding(py::module &m) {
+  typedef std::vector<bool> Result;
+  m.def("QueryCycleMatches", static_cast<Result(*)(SearchGraph const&, MultiPatternGraph const&)>(&QueryCycleMatches));
+  m.def("QueryCycleMatches", static_cast<Result(*)(SearchGraph const&, MultiPatternGraph const&, PatternMatchWorkspace &)>(&QueryCycleMatches));
+  m.def("QueryPathMatches", static_cast<Result(*)(SearchGraph const&, MultiPatternGraph const&)>(&QueryPathMatches));
+  m.def("QueryPathMatches", static_cast<Result(*)(SearchGraph const&, MultiPatternGraph const&, PatternMatchWorkspace &)>(&QueryPathMatches));
+}
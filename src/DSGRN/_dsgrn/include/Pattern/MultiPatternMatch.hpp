@@ -0,0 +1,159 @@
+/// MultiPatternMatch.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#ifndef INLINE_IF_HEADER_ONLY
+#define INLINE_IF_HEADER_ONLY
+#endif
+
+#include "MultiPatternMatch.h"
+
+/// MultiPatternMatchTraverse
+///   Depth-first traversal of the matching graph of "sg" and "mpg" from
+///   the (dense) vertices on the workspace stack, calling visit(domain, v)
+///   on each new vertex. Stops early when visit returns false. If "pruned"
+///   is true only vertices marked by the workspace coreach are entered.
+template < typename Visit > void
+MultiPatternMatchTraverse ( SearchGraph const& sg, MultiPatternGraph const& mpg,
+                            PatternMatchWorkspace & workspace, bool pruned, Visit const& visit ) {
+  uint64_t P = mpg . size ();
+  auto query = [&](uint64_t domain, uint64_t v) {
+    uint64_t search_label = sg . label ( domain );
+    return ( mpg . label ( v ) & search_label ) == search_label;
+  };
+  std::vector<uint64_t> & stack = workspace . stack_;
+  while ( not stack . empty () ) {
+    uint64_t i = stack . back ();
+    stack . pop_back ();
+    if ( not workspace . visit ( i ) ) continue;
+    uint64_t domain = i / P;
+    uint64_t v = i % P;
+    if ( not visit ( domain, v ) ) return;
+    auto push = [&](uint64_t j) {
+      if ( pruned && not workspace . coreachable ( j ) ) return;
+      stack . push_back ( j );
+    };
+    auto const& adjacencies = sg . adjacencies ( domain );
+    for ( uint64_t k = 0; k < adjacencies . size (); ++ k ) {
+      uint64_t nextdomain = adjacencies [ k ];
+      // Intermediate match
+      if ( query ( nextdomain, v ) ) push ( nextdomain * P + v );
+      // Extremal matches
+      for ( uint64_t u : mpg . consume ( v, sg . edge_label ( domain, k ) ) ) {
+        if ( query ( nextdomain, u ) ) push ( nextdomain * P + u );
+      }
+    }
+  }
+}
+
+INLINE_IF_HEADER_ONLY std::vector<bool>
+QueryCycleMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg ) {
+  PatternMatchWorkspace workspace;
+  return QueryCycleMatches ( sg, mpg, workspace );
+}
+
+INLINE_IF_HEADER_ONLY std::vector<bool>
+QueryCycleMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg, PatternMatchWorkspace & workspace ) {
+  uint64_t N = sg . size ();
+  uint64_t P = mpg . size ();
+  uint64_t K = mpg . patterns ();
+  std::vector<bool> result ( K, false );
+  uint64_t remaining = K;
+  if ( K == 0 ) return result;
+  workspace . reserve ( N * P );
+  auto query = [&](uint64_t domain, uint64_t v) {
+    uint64_t search_label = sg . label ( domain );
+    return ( mpg . label ( v ) & search_label ) == search_label;
+  };
+  // Mark the vertices from which some pattern can close a cycle, i.e.
+  // reach (domain, v) where v holds the leaf of a pattern whose root
+  // vertex is also matched at domain.
+  std::vector<uint64_t> targets;
+  for ( uint64_t v = 0; v < P; ++ v ) {
+    if ( mpg . accepts ( v ) . empty () ) continue;
+    for ( uint64_t domain = 0; domain < N; ++ domain ) {
+      if ( not query ( domain, v ) ) continue;
+      for ( uint64_t k : mpg . accepts ( v ) ) {
+        if ( query ( domain, mpg . root ( k ) ) ) {
+          targets . push_back ( domain * P + v );
+          break;
+        }
+      }
+    }
+  }
+  if ( targets . empty () ) return result;
+  uint64_t slots = 2 * mpg . dimension () + 1;
+  workspace . preimage_ . resize ( P );
+  for ( auto & pre : workspace . preimage_ ) pre . clear ();
+  for ( uint64_t v = 0; v < P; ++ v ) {
+    for ( uint64_t slot = 0; slot < slots; ++ slot ) {
+      uint64_t edge_label = ( slot == 0 ) ? 0 : ( 1LL << ( slot - 1 ) );
+      for ( uint64_t u : mpg . consume ( v, edge_label ) ) workspace . preimage_ [ u ] . push_back ( { v, edge_label } );
+    }
+  }
+  workspace . coreach ( sg, P, query, targets );
+  for ( uint64_t domain = 0; domain < N && remaining > 0; ++ domain ) {
+    uint64_t search_label = sg . label ( domain );
+    for ( uint64_t root : mpg . roots () ) {
+      if ( not workspace . coreachable ( domain * P + root ) ) continue;
+      // Patterns of this root which are unmatched and whose leaf is at this domain
+      uint64_t open = 0;
+      for ( auto const& p : mpg . positions ( root ) ) {
+        PatternGraph const& pg = mpg . patterngraph ( p . first );
+        if ( result [ p . first ] ) continue;
+        if ( ( pg . label ( pg . leaf () ) & search_label ) == search_label ) ++ open;
+      }
+      if ( open == 0 ) continue;
+      workspace . fresh ();
+      workspace . stack_ . assign ( 1, domain * P + root );
+      MultiPatternMatchTraverse ( sg, mpg, workspace, true, [&](uint64_t d, uint64_t v) {
+        if ( d != domain ) return true;
+        for ( uint64_t k : mpg . accepts ( v ) ) {
+          // Vertices reached from root only hold patterns of root
+          if ( result [ k ] ) continue;
+          result [ k ] = true;
+          -- remaining;
+          -- open;
+        }
+        return open > 0;
+      });
+    }
+  }
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<bool>
+QueryPathMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg ) {
+  PatternMatchWorkspace workspace;
+  return QueryPathMatches ( sg, mpg, workspace );
+}
+
+INLINE_IF_HEADER_ONLY std::vector<bool>
+QueryPathMatches ( SearchGraph const& sg, MultiPatternGraph const& mpg, PatternMatchWorkspace & workspace ) {
+  uint64_t N = sg . size ();
+  uint64_t P = mpg . size ();
+  uint64_t K = mpg . patterns ();
+  std::vector<bool> result ( K, false );
+  uint64_t remaining = K;
+  if ( K == 0 ) return result;
+  workspace . reserve ( N * P );
+  workspace . fresh ();
+  workspace . stack_ . clear ();
+  for ( uint64_t domain = 0; domain < N; ++ domain ) {
+    uint64_t search_label = sg . label ( domain );
+    for ( uint64_t root : mpg . roots () ) {
+      if ( ( mpg . label ( root ) & search_label ) == search_label ) workspace . stack_ . push_back ( domain * P + root );
+    }
+  }
+  MultiPatternMatchTraverse ( sg, mpg, workspace, false, [&](uint64_t, uint64_t v) {
+    for ( uint64_t k : mpg . accepts ( v ) ) {
+      if ( result [ k ] ) continue;
+      result [ k ] = true;
+      -- remaining;
+    }
+    return remaining > 0;
+  });
+  return result;
+}
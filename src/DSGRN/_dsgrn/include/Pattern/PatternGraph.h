@@ -61,6 +61,7 @@ public:
   ///   Given a vertex v and an edge label, report the unique vertex u, if it exists,
   ///   in the adjacency list of vertex with an identical (not just matching) edge label.
   ///   edge_label is only 1 on single bit; bit i means max (M) in i, bit i+D means min (m) in i
+  ///   The answer is read from a precomputed (vertex x edge label) transition table.
   uint64_t 
   consume ( uint64_t vertex, uint64_t edge_label ) const;
 
@@ -84,7 +85,9 @@ struct PatternGraph_ {
   uint64_t size_;
   uint64_t dimension_;
   std::vector<uint64_t> labels_;
-  std::vector<std::unordered_map<uint64_t, uint64_t>> consume_;
+  /// consume_ is the transition table: entry vertex * (2D+1) + slot holds the
+  /// target of the edge with label 0 (slot 0) or 1 << i (slot 1+i), or -1
+  std::vector<uint64_t> consume_;
 };
 
 /// Python Bindings
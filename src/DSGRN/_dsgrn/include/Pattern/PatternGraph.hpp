@@ -12,6 +12,21 @@
 #include "Pattern/PatternGraph.h"
 #include "Pattern/MatchingRelation.h"
 
+/// Slot of an edge label in the transition table: 0 for the empty
+/// label, 1+i for the single bit 1 << i, and -1 for anything else
+inline uint64_t
+PatternGraphSlot ( uint64_t edge_label ) {
+  if ( edge_label == 0 ) return 0;
+  if ( edge_label & ( edge_label - 1 ) ) return -1;
+#if defined(__GNUC__)
+  return 1 + __builtin_ctzll ( edge_label );
+#else
+  uint64_t slot = 1;
+  while ( not ( edge_label & 1 ) ) { edge_label >>= 1; ++ slot; }
+  return slot;
+#endif
+}
+
 INLINE_IF_HEADER_ONLY PatternGraph::
 PatternGraph ( void ) {
   data_ . reset ( new PatternGraph_ );
@@ -25,6 +40,9 @@ PatternGraph ( Pattern const& pattern ) {
 INLINE_IF_HEADER_ONLY void PatternGraph::
 assign ( Pattern const& pattern ) {
   // std::cout << "DEBUG PatternGraph::assign " << __LINE__ << "\n";
+  if ( pattern . dimension () > 32 ) {
+    throw std::length_error ( "PatternGraph: labels of more than 32 dimensions do not fit in 64 bits" );
+  }
   data_ . reset ( new PatternGraph_ );
   data_ -> dimension_ = pattern . dimension ();
   data_ -> size_ = 0;
@@ -32,11 +50,12 @@ assign ( Pattern const& pattern ) {
   Poset const& poset = pattern . poset ();
   typedef std::set<uint64_t> Clique;
   std::unordered_map<Clique, uint64_t, dsgrn::hash<Clique>> vertices;
+  std::vector<std::unordered_map<uint64_t, uint64_t>> consume;
   // Add the leaf vertex to the pattern graph, which corresponds to
   // the set of maximal elements in the pattern poset.
   data_ -> leaf_ = data_ -> size_ ++;
   data_ -> labels_ . push_back ( pattern . label () );
-  data_ -> consume_ . push_back ( std::unordered_map<uint64_t, uint64_t> () );
+  consume . push_back ( std::unordered_map<uint64_t, uint64_t> () );
 
   std::set<uint64_t> s;
   for (uint64_t i = 0; i < poset.size(); ++i) s.insert(s.end(), i); // insert-with-hint
@@ -70,7 +89,7 @@ assign ( Pattern const& pattern ) {
         //std::cout << "  Assigning index " << vertices[parent_clique] << "\n";
         recursion_stack.push(parent_clique);
         data_ -> labels_ . push_back ( 0 );
-        data_ -> consume_ . push_back ( std::unordered_map<uint64_t, uint64_t> () );
+        consume . push_back ( std::unordered_map<uint64_t, uint64_t> () );
       }
       // Add the edge to the pattern graph
       uint64_t source = vertices[parent_clique];
@@ -79,14 +98,24 @@ assign ( Pattern const& pattern ) {
       auto const& variable = pattern . event ( v );
       //std::cout << "The event variable is " << variable << "\n";
       // Bit fiddling to toggle increasing/decreasing label for "variable"
-      uint64_t bit = 1 << variable;
+      uint64_t bit = 1ULL << variable;
       bit |= bit << pattern . dimension ();
       data_ -> labels_ [ source ] = label(target) ^ bit;
-      data_ -> consume_ [ source ] [ label(target) & bit ] = target; 
+      consume [ source ] [ label(target) & bit ] = target; 
       // example: consider bits (i+D,i). 01 means Max, 01 means decreasing. Target is decreasing after a Max
     }
   }
   data_ -> root_ = vertices [ std::set<uint64_t> () ];
+  // Flatten the transitions into the consume table
+  uint64_t slots = 2 * dimension () + 1;
+  data_ -> consume_ . assign ( size () * slots, -1 );
+  for ( uint64_t source = 0; source < size (); ++ source ) {
+    for ( auto const& transition : consume [ source ] ) {
+      uint64_t slot = PatternGraphSlot ( transition . first );
+      if ( slot == -1 ) continue; // never produced by a search graph edge
+      data_ -> consume_ [ source * slots + slot ] = transition . second;
+    }
+  }
 }
 
 INLINE_IF_HEADER_ONLY uint64_t PatternGraph::
@@ -116,9 +145,9 @@ label ( uint64_t v ) const {
 
 INLINE_IF_HEADER_ONLY uint64_t PatternGraph::
 consume ( uint64_t vertex, uint64_t edge_label ) const {
-  auto it = data_ -> consume_ [ vertex ] . find ( edge_label );
-  if ( it != data_ -> consume_ [ vertex ] . end () ) return it -> second;
-  return -1;
+  uint64_t slot = PatternGraphSlot ( edge_label );
+  if ( slot >= 2 * dimension () + 1 ) return -1;
+  return data_ -> consume_ [ vertex * ( 2 * dimension () + 1 ) + slot ];
 }
 
 INLINE_IF_HEADER_ONLY std::string PatternGraph::
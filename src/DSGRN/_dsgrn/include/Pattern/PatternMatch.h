@@ -9,26 +9,156 @@
 
 #include "Pattern/MatchingGraph.h"
 
+/// PatternMatchWorkspace
+///   Scratch storage for the pattern matching routines, intended to be
+///   reused across many matching graphs (e.g. one per worker).
+///   Vertices of the matching graph are addressed by their dense index
+///   (see MatchingGraph::index). Visited sets are arrays of epoch
+///   stamps, so starting a new search does not clear memory, and
+///   storage only grows.
+struct PatternMatchWorkspace {
+  /// assign
+  ///   Size the workspace for the matching graph "mg"
+  void
+  assign ( MatchingGraph const& mg );
+
+  /// reserve
+  ///   Size the workspace for "size" dense vertex indices
+  void
+  reserve ( uint64_t size );
+
+  /// fresh
+  ///   Start a new visited set, with every vertex unvisited
+  void
+  fresh ( void );
+
+  /// visit
+  ///   Mark vertex i as visited. Return false if it already was.
+  bool
+  visit ( uint64_t i );
+
+  /// coreach
+  ///   Mark every vertex of "mg" from which some vertex in "targets"
+  ///   is reachable, with a single backward traversal.
+  void
+  coreach ( MatchingGraph const& mg, std::vector<uint64_t> const& targets );
+
+  /// coreach
+  ///   As above, for a matching graph of "sg" with P positions given by
+  ///   the predicate query(domain, position); preimage_ must hold the
+  ///   reversed consume relation of the positions
+  template < typename Query > void
+  coreach ( SearchGraph const& sg, uint64_t P, Query const& query, std::vector<uint64_t> const& targets );
+
+  /// coreachable
+  ///   Return true if vertex i was marked by the last call to coreach
+  bool
+  coreachable ( uint64_t i ) const;
+
+  /// closing
+  ///   Given paired vertices sources[k] and targets[k] of "mg", return
+  ///   the first k such that targets[k] is reachable from sources[k]
+  ///   through vertices marked by "coreach", or -1 if there is none.
+  ///   A single iterative Tarjan pass condenses the vertices reachable
+  ///   from the sources into strong components, emitted sinks first.
+  ///   Reachability is then swept over the components with one bit per
+  ///   pair, 64 pairs per sweep, so no search is run per source.
+  uint64_t
+  closing ( MatchingGraph const& mg,
+            std::vector<uint64_t> const& sources,
+            std::vector<uint64_t> const& targets );
+
+  /// search
+  ///   Depth-first search of "mg" from the vertices "sources". Return
+  ///   the first path found to "target", or to any vertex in the leaf
+  ///   layer if "target" is -1 (empty if there is none). If "pruned" is
+  ///   true the search only enters vertices marked by "coreach".
+  std::vector<MatchingGraph::Vertex>
+  search ( MatchingGraph const& mg,
+           std::vector<uint64_t> const& sources,
+           uint64_t target = -1,
+           bool pruned = false );
+
+  uint32_t epoch_ = 0;
+  std::vector<uint32_t> visited_;
+  std::vector<uint64_t> parent_;
+  std::vector<uint64_t> coreachable_; // bitset
+  std::vector<uint64_t> stack_;
+  std::vector<uint64_t> sources_;
+  std::vector<uint64_t> targets_;
+  /// strong components of "closing": lowlink_ and component_ are per
+  /// vertex (preorder numbers are kept in parent_), the vertices of
+  /// component c are order_[component_begin_[c]] ... order_[component_begin_[c+1]-1]
+  struct Frame {
+    uint64_t vertex;
+    MatchingGraph::SuccessorIterator next;
+    MatchingGraph::SuccessorIterator end;
+  };
+  std::vector<Frame> frames_;
+  std::vector<uint64_t> lowlink_;
+  std::vector<uint64_t> component_;
+  std::vector<uint64_t> order_;
+  std::vector<uint64_t> component_begin_;
+  std::vector<uint64_t> masks_;
+  /// reverse search graph (compressed: predecessors of d are
+  /// reverse_[reverse_begin_[d]] ... reverse_[reverse_begin_[d+1]-1])
+  std::vector<uint64_t> reverse_begin_;
+  std::vector<uint64_t> reverse_;
+  /// labels of the reversed edges, parallel to reverse_
+  std::vector<uint64_t> reverse_events_;
+  /// preimage_[q] lists the (position, edge label) pairs consumed into q
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> preimage_;
+  /// position bitsets of LinearPathMatcher
+  std::vector<uint64_t> states_;
+  std::vector<uint64_t> next_states_;
+};
+
 /// QueryCycleMatch
 ///   Determine if there is a cycle match
 bool
 QueryCycleMatch ( MatchingGraph const& mg );
 
+/// QueryCycleMatch
+///   Determine if there is a cycle match, reusing "workspace"
+bool
+QueryCycleMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace );
+
 /// QueryCycleMatch
 ///   Determine if there is a path match
 bool
 QueryPathMatch ( MatchingGraph const& mg );
 
+/// QueryPathMatch
+///   Determine if there is a path match, reusing "workspace"
+bool
+QueryPathMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace );
+
 /// CycleMatch
 ///   Return a cycle match (or else empty if none exists)
 std::vector<MatchingGraph::Vertex>
 CycleMatch ( MatchingGraph const& mg );
 
+/// CycleMatch
+///   Return a cycle match (or else empty if none exists), reusing "workspace".
+///   A single backward traversal from the leaf layer finds the vertices which
+///   can complete a match; if no root (d, root) with (d, leaf) in the matching
+///   graph is among them the query fails without any forward search. Otherwise
+///   existence is decided for all candidate roots at once (see closing), and
+///   a path search is run only to reconstruct the witness of a closing cycle.
+std::vector<MatchingGraph::Vertex>
+CycleMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace );
+
 /// PathMatch
 ///   Return a path match (or else empty if none exists)
 std::vector<MatchingGraph::Vertex>
 PathMatch ( MatchingGraph const& mg );
 
+/// PathMatch
+///   Return a path match (or else empty if none exists), reusing "workspace".
+///   All roots are searched simultaneously with a shared visited set.
+std::vector<MatchingGraph::Vertex>
+PathMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace );
+
 /// FindPath
 ///   Given a MatchingGraph "mg", a starting vertex "start", and a predicate on pairs (u,v),
 ///   find a path from start to a vertex v such that match(start, v) evaluates to true
@@ -45,16 +175,6 @@ FindPath ( MatchingGraph const& mg,
            MatchingGraph::Vertex const& start, 
            std::function<bool(MatchingGraph::Vertex const&, MatchingGraph::Vertex const&)> const& match );
 
-// /// CountCycleMatches
-// ///   Return the number of cycle matches
-// uint64_t
-// CountCycleMatches ( MatchingGraph const& mg );
-
-// /// CountPathMatches
-// ///   Return the number of path matches
-// uint64_t
-// CountPathMatches ( MatchingGraph const& mg );
-
 /// Debugging
 
 /// ExplainCycleMatch
@@ -71,9 +191,16 @@ namespace py = pybind11;
 
 inline
 void PatternMatchBinding(py::module &m) {
-  m.def("QueryCycleMatch", &QueryCycleMatch);
-  m.def("QueryPathMatch", &QueryPathMatch);
-  m.def("CycleMatch", &CycleMatch);
-  m.def("PathMatch", &PathMatch);
+  typedef std::vector<MatchingGraph::Vertex> Path;
+  py::class_<PatternMatchWorkspace, std::shared_ptr<PatternMatchWorkspace>>(m, "PatternMatchWorkspace")
+    .def(py::init<>());
+  m.def("QueryCycleMatch", static_cast<bool(*)(MatchingGraph const&)>(&QueryCycleMatch));
+  m.def("QueryCycleMatch", static_cast<bool(*)(MatchingGraph const&, PatternMatchWorkspace &)>(&QueryCycleMatch));
+  m.def("QueryPathMatch", static_cast<bool(*)(MatchingGraph const&)>(&QueryPathMatch));
+  m.def("QueryPathMatch", static_cast<bool(*)(MatchingGraph const&, PatternMatchWorkspace &)>(&QueryPathMatch));
+  m.def("CycleMatch", static_cast<Path(*)(MatchingGraph const&)>(&CycleMatch));
+  m.def("CycleMatch", static_cast<Path(*)(MatchingGraph const&, PatternMatchWorkspace &)>(&CycleMatch));
+  m.def("PathMatch", static_cast<Path(*)(MatchingGraph const&)>(&PathMatch));
+  m.def("PathMatch", static_cast<Path(*)(MatchingGraph const&, PatternMatchWorkspace &)>(&PathMatch));
   m.def("FindPath", &FindPath);
 }
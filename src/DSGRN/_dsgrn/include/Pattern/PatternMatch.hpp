@@ -11,179 +11,358 @@
 
 #include "PatternMatch.h"
 
+INLINE_IF_HEADER_ONLY void PatternMatchWorkspace::
+assign ( MatchingGraph const& mg ) {
+  reserve ( mg . size () );
+}
+
+INLINE_IF_HEADER_ONLY void PatternMatchWorkspace::
+reserve ( uint64_t size ) {
+  if ( visited_ . size () < size ) {
+    visited_ . resize ( size, 0 );
+    parent_ . resize ( size );
+    lowlink_ . resize ( size );
+    component_ . resize ( size );
+    coreachable_ . resize ( ( size + 63 ) / 64 );
+  }
+}
+
+INLINE_IF_HEADER_ONLY void PatternMatchWorkspace::
+fresh ( void ) {
+  // New epoch; clear stamps only when the counter wraps
+  if ( ++ epoch_ == 0 ) {
+    std::fill ( visited_ . begin (), visited_ . end (), 0 );
+    epoch_ = 1;
+  }
+}
+
+INLINE_IF_HEADER_ONLY bool PatternMatchWorkspace::
+visit ( uint64_t i ) {
+  if ( visited_ [ i ] == epoch_ ) return false;
+  visited_ [ i ] = epoch_;
+  return true;
+}
+
+INLINE_IF_HEADER_ONLY bool PatternMatchWorkspace::
+coreachable ( uint64_t i ) const {
+  return coreachable_ [ i >> 6 ] & ( 1ULL << ( i & 63 ) );
+}
+
+INLINE_IF_HEADER_ONLY void PatternMatchWorkspace::
+coreach ( MatchingGraph const& mg, std::vector<uint64_t> const& targets ) {
+  PatternGraph const& pg = mg . patterngraph ();
+  uint64_t P = pg . size ();
+  // Reverse the consume relation of the pattern graph. Edge labels
+  // are either 0 or a single bit.
+  preimage_ . resize ( P );
+  for ( auto & pre : preimage_ ) pre . clear ();
+  for ( uint64_t position = 0; position < P; ++ position ) {
+    for ( int64_t bit = -1; bit < (int64_t) ( 2 * pg . dimension () ); ++ bit ) {
+      uint64_t edge_label = ( bit < 0 ) ? 0 : ( 1LL << bit );
+      uint64_t next = pg . consume ( position, edge_label );
+      if ( next != (uint64_t) -1 ) preimage_ [ next ] . push_back ( { position, edge_label } );
+    }
+  }
+  coreach ( mg . searchgraph (), P,
+    [&](uint64_t domain, uint64_t position){ return mg . query ( {domain, position} ); },
+    targets );
+}
+
+template < typename Query > void PatternMatchWorkspace::
+coreach ( SearchGraph const& sg, uint64_t P, Query const& query, std::vector<uint64_t> const& targets ) {
+  uint64_t N = sg . size ();
+  // Reverse the search graph
+  reverse_begin_ . assign ( N + 1, 0 );
+  for ( uint64_t d = 0; d < N; ++ d ) {
+    for ( uint64_t next : sg . adjacencies ( d ) ) ++ reverse_begin_ [ next + 1 ];
+  }
+  for ( uint64_t d = 0; d < N; ++ d ) reverse_begin_ [ d + 1 ] += reverse_begin_ [ d ];
+  reverse_ . resize ( reverse_begin_ [ N ] );
+  reverse_events_ . resize ( reverse_begin_ [ N ] );
+  stack_ . assign ( reverse_begin_ . begin (), reverse_begin_ . end () - 1 );
+  for ( uint64_t d = 0; d < N; ++ d ) {
+    auto const& adjacencies = sg . adjacencies ( d );
+    for ( uint64_t k = 0; k < adjacencies . size (); ++ k ) {
+      uint64_t j = stack_ [ adjacencies [ k ] ] ++;
+      reverse_ [ j ] = d;
+      reverse_events_ [ j ] = sg . edge_label ( d, k );
+    }
+  }
+  // Backward traversal
+  std::fill ( coreachable_ . begin (), coreachable_ . begin () + ( N * P + 63 ) / 64, 0 );
+  stack_ . clear ();
+  for ( uint64_t t : targets ) {
+    if ( coreachable ( t ) ) continue;
+    coreachable_ [ t >> 6 ] |= 1ULL << ( t & 63 );
+    stack_ . push_back ( t );
+  }
+  auto mark = [&](uint64_t domain, uint64_t position) {
+    uint64_t i = domain * P + position;
+    if ( coreachable ( i ) ) return;
+    if ( not query ( domain, position ) ) return;
+    coreachable_ [ i >> 6 ] |= 1ULL << ( i & 63 );
+    stack_ . push_back ( i );
+  };
+  while ( not stack_ . empty () ) {
+    uint64_t i = stack_ . back ();
+    stack_ . pop_back ();
+    uint64_t domain = i / P;
+    uint64_t position = i % P;
+    for ( uint64_t k = reverse_begin_ [ domain ]; k < reverse_begin_ [ domain + 1 ]; ++ k ) {
+      uint64_t prevdomain = reverse_ [ k ];
+      // Intermediate match
+      mark ( prevdomain, position );
+      // Extremal match
+      if ( preimage_ [ position ] . empty () ) continue;
+      uint64_t edge_label = reverse_events_ [ k ];
+      for ( auto const& pre : preimage_ [ position ] ) {
+        if ( pre . second == edge_label ) mark ( prevdomain, pre . first );
+      }
+    }
+  }
+}
+
+INLINE_IF_HEADER_ONLY uint64_t PatternMatchWorkspace::
+closing ( MatchingGraph const& mg,
+          std::vector<uint64_t> const& sources,
+          std::vector<uint64_t> const& targets ) {
+  uint64_t const unassigned = -1;
+  // Strong components of the coreachable vertices reachable from sources
+  fresh ();
+  stack_ . clear ();
+  frames_ . clear ();
+  order_ . clear ();
+  component_begin_ . clear ();
+  uint64_t counter = 0;
+  auto open = [&](uint64_t v) {
+    visit ( v );
+    parent_ [ v ] = lowlink_ [ v ] = counter ++;
+    component_ [ v ] = unassigned;
+    stack_ . push_back ( v );
+    auto successors = mg . successors ( v );
+    frames_ . push_back ( { v, successors . begin (), successors . end () } );
+  };
+  for ( uint64_t s : sources ) {
+    if ( visited_ [ s ] == epoch_ ) continue;
+    open ( s );
+    while ( not frames_ . empty () ) {
+      Frame & frame = frames_ . back ();
+      uint64_t v = frame . vertex;
+      if ( frame . next != frame . end ) {
+        uint64_t w = * frame . next;
+        ++ frame . next;
+        if ( not coreachable ( w ) ) continue;
+        if ( visited_ [ w ] != epoch_ ) {
+          open ( w );
+        } else if ( component_ [ w ] == unassigned ) {
+          lowlink_ [ v ] = std::min ( lowlink_ [ v ], parent_ [ w ] );
+        }
+        continue;
+      }
+      frames_ . pop_back ();
+      if ( not frames_ . empty () ) {
+        uint64_t u = frames_ . back () . vertex;
+        lowlink_ [ u ] = std::min ( lowlink_ [ u ], lowlink_ [ v ] );
+      }
+      if ( lowlink_ [ v ] != parent_ [ v ] ) continue;
+      uint64_t c = component_begin_ . size ();
+      component_begin_ . push_back ( order_ . size () );
+      uint64_t w;
+      do {
+        w = stack_ . back ();
+        stack_ . pop_back ();
+        component_ [ w ] = c;
+        order_ . push_back ( w );
+      } while ( w != v );
+    }
+  }
+  uint64_t C = component_begin_ . size ();
+  component_begin_ . push_back ( order_ . size () );
+  // Sweep reachability of the targets, 64 pairs at a time. Components
+  // are numbered sinks first, so successors are always complete.
+  for ( uint64_t base = 0; base < sources . size (); base += 64 ) {
+    uint64_t count = std::min ( (uint64_t) 64, (uint64_t) sources . size () - base );
+    masks_ . assign ( C, 0 );
+    uint64_t pending = 0;
+    for ( uint64_t k = 0; k < count; ++ k ) {
+      uint64_t t = targets [ base + k ];
+      if ( visited_ [ t ] != epoch_ ) continue;
+      masks_ [ component_ [ t ] ] |= 1ULL << k;
+      pending |= 1ULL << k;
+    }
+    if ( pending == 0 ) continue;
+    for ( uint64_t c = 0; c < C; ++ c ) {
+      uint64_t mask = masks_ [ c ];
+      for ( uint64_t j = component_begin_ [ c ]; j < component_begin_ [ c + 1 ]; ++ j ) {
+        for ( uint64_t w : mg . successors ( order_ [ j ] ) ) {
+          if ( not coreachable ( w ) ) continue;
+          mask |= masks_ [ component_ [ w ] ];
+        }
+      }
+      masks_ [ c ] = mask;
+    }
+    for ( uint64_t k = 0; k < count; ++ k ) {
+      if ( masks_ [ component_ [ sources [ base + k ] ] ] & ( 1ULL << k ) ) return base + k;
+    }
+  }
+  return -1;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex> PatternMatchWorkspace::
+search ( MatchingGraph const& mg,
+         std::vector<uint64_t> const& sources,
+         uint64_t target,
+         bool pruned ) {
+  typedef MatchingGraph::Vertex Vertex;
+  uint64_t leaf = mg . patterngraph () . leaf ();
+  uint64_t P = mg . patterngraph () . size ();
+  fresh ();
+  stack_ . clear ();
+  for ( uint64_t s : sources ) {
+    parent_ [ s ] = s;
+    stack_ . push_back ( s );
+  }
+  while ( not stack_ . empty () ) {
+    uint64_t i = stack_ . back ();
+    stack_ . pop_back ();
+    if ( not visit ( i ) ) continue;
+    if ( ( target == (uint64_t) -1 ) ? ( i % P == leaf ) : ( i == target ) ) {
+      std::vector<Vertex> matching_path;
+      matching_path . push_back ( mg . vertex ( i ) );
+      while ( parent_ [ i ] != i ) {
+        i = parent_ [ i ];
+        matching_path . push_back ( mg . vertex ( i ) );
+      }
+      std::reverse(matching_path.begin(),matching_path.end());
+      return matching_path;
+    }
+    for ( uint64_t j : mg . successors ( i ) ) {
+      if ( visited_ [ j ] == epoch_ ) continue;
+      if ( pruned && not coreachable ( j ) ) continue;
+      parent_ [ j ] = i;
+      stack_ . push_back ( j );
+    }
+  }
+  return std::vector<Vertex>();
+}
+
 INLINE_IF_HEADER_ONLY bool
 QueryCycleMatch ( MatchingGraph const& mg ) {
   return CycleMatch(mg).size() > 0;
 }
 
+INLINE_IF_HEADER_ONLY bool
+QueryCycleMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace ) {
+  return CycleMatch(mg, workspace).size() > 0;
+}
+
 INLINE_IF_HEADER_ONLY bool
 QueryPathMatch ( MatchingGraph const& mg ) {
   return PathMatch(mg).size() > 0;
 }
 
+INLINE_IF_HEADER_ONLY bool
+QueryPathMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace ) {
+  return PathMatch(mg, workspace).size() > 0;
+}
+
 INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex>
 CycleMatch ( MatchingGraph const& mg ) {
+  PatternMatchWorkspace workspace;
+  return CycleMatch ( mg, workspace );
+}
+
+INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex>
+CycleMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace ) {
   typedef MatchingGraph::Vertex Vertex;
   uint64_t N = mg . searchgraph() . size ();
+  uint64_t root = mg . patterngraph() . root ();
+  uint64_t leaf = mg . patterngraph() . leaf ();
+  workspace . assign ( mg );
+  // Leaf layer vertices which close a cycle
+  std::vector<uint64_t> targets;
   for ( uint64_t sg_vertex = 0; sg_vertex < N; ++ sg_vertex ) {
-    Vertex start = {sg_vertex, mg . patterngraph() . root () };
-    Vertex end = {sg_vertex, mg . patterngraph() . leaf () };
-    if ( not ( mg . query ( start ) && mg . query ( end ) ) ) continue;
-    auto match = [&](Vertex const& u, Vertex const& v ){return v == end;};
-    std::vector<Vertex> matching_path = FindPath(mg, start, match);
-    if ( matching_path.size() > 0 ) return matching_path;
+    Vertex start = {sg_vertex, root};
+    Vertex end = {sg_vertex, leaf};
+    if ( mg . query ( start ) && mg . query ( end ) ) targets . push_back ( mg . index ( end ) );
+  }
+  if ( targets . empty () ) return std::vector<Vertex>();
+  workspace . coreach ( mg, targets );
+  // Candidate cycles: coreachable roots paired with their leaf vertices
+  workspace . sources_ . clear ();
+  workspace . targets_ . clear ();
+  for ( uint64_t end : targets ) {
+    uint64_t start = mg . index ( { mg . vertex ( end ) . first, root } );
+    if ( not workspace . coreachable ( start ) ) continue;
+    workspace . sources_ . push_back ( start );
+    workspace . targets_ . push_back ( end );
+  }
+  if ( workspace . sources_ . empty () ) return std::vector<Vertex>();
+  uint64_t k = workspace . closing ( mg, workspace . sources_, workspace . targets_ );
+  if ( k != (uint64_t) -1 ) {
+    uint64_t start = workspace . sources_ [ k ];
+    uint64_t end = workspace . targets_ [ k ];
+    workspace . sources_ . assign ( 1, start );
+    return workspace . search ( mg, workspace . sources_, end, true );
   }
   return std::vector<Vertex>();
 }
 
 INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex>
 PathMatch ( MatchingGraph const& mg ) {
-  typedef MatchingGraph::Vertex Vertex;
+  PatternMatchWorkspace workspace;
+  return PathMatch ( mg, workspace );
+}
+
+INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex>
+PathMatch ( MatchingGraph const& mg, PatternMatchWorkspace & workspace ) {
   uint64_t N = mg . searchgraph() . size ();
+  uint64_t root = mg . patterngraph() . root ();
+  workspace . assign ( mg );
+  workspace . sources_ . clear ();
   for ( uint64_t sg_vertex = 0; sg_vertex < N; ++ sg_vertex ) {
-    Vertex start = {sg_vertex, mg . patterngraph() . root () };
-    if ( not mg . query ( start ) ) continue;
-    auto match = [&](Vertex const& u, Vertex const& v){return v.second == mg . patterngraph() . leaf ();};
-    std::vector<Vertex> matching_path = FindPath(mg, start, match);
-    if ( matching_path.size() > 0 ) return matching_path;
+    if ( mg . query ( {sg_vertex, root} ) ) workspace . sources_ . push_back ( mg . index ( {sg_vertex, root} ) );
   }
-  return std::vector<Vertex>();
+  return workspace . search ( mg, workspace . sources_ );
 }
 
 INLINE_IF_HEADER_ONLY std::vector<MatchingGraph::Vertex>
 FindPath ( MatchingGraph const& mg, 
            MatchingGraph::Vertex const& start, 
            std::function<bool(MatchingGraph::Vertex const&, MatchingGraph::Vertex const&)> const& match ) {
-  //std::cout << "FINDPATH\n";
   typedef MatchingGraph::Vertex Vertex;
-  //auto str = [](Vertex const& v) { std::stringstream ss; ss << "(" << v.first << ", " << v.second << ")"; return ss.str();};
-  //std::cout << "0 " << str(start) << "\n";
-  std::stack<Vertex> dfs_stack;
-  std::unordered_set<Vertex, dsgrn::hash<Vertex>> explored;
-  std::unordered_map<Vertex, Vertex, dsgrn::hash<Vertex>> parent;
-  parent[start] = start; 
-  dfs_stack . push ( start );
+  std::vector<uint64_t> dfs_stack;
+  std::vector<uint64_t> explored ( ( mg . size () + 63 ) / 64, 0 );
+  std::vector<uint64_t> parent ( mg . size () );
+  uint64_t s = mg . index ( start );
+  parent[s] = s; 
+  dfs_stack . push_back ( s );
   while ( not dfs_stack . empty () ) {
-    Vertex vertex = dfs_stack . top ();
-    dfs_stack . pop ();
-    if ( explored.count(vertex) ) continue;
-    explored.insert(vertex);
-    if ( match(start, vertex) ) { 
-      Vertex v = vertex;
+    uint64_t i = dfs_stack . back ();
+    dfs_stack . pop_back ();
+    if ( explored[i >> 6] & ( 1ULL << ( i & 63 ) ) ) continue;
+    explored[i >> 6] |= 1ULL << ( i & 63 );
+    if ( match(start, mg . vertex ( i ) ) ) { 
       std::vector<Vertex> matching_path;
-      matching_path . push_back ( v );
-      //std::cout << "1 " << str(v) << "\n";
-      //std::cout << "2 parent(" << str(v) << ") = " << str(parent[v]) << "\n";
-      while ( v != parent[v] ) {
-        v = parent[v];
-        matching_path . push_back ( v );
-        //std::cout << "3 (" << v.first << ", " << v.second << ")\n";
+      matching_path . push_back ( mg . vertex ( i ) );
+      while ( i != parent[i] ) {
+        i = parent[i];
+        matching_path . push_back ( mg . vertex ( i ) );
       }
       std::reverse(matching_path.begin(),matching_path.end());
       return matching_path;
     }
-    //std::cout << "4 Computing adjacencies for vertex = " << str(vertex) << "\n";
-    for ( Vertex const& next_vertex : mg . adjacencies ( vertex ) ) {
-      //std::cout << "5 consider child " << str(next_vertex) << " of " << str(vertex) << "\n";
-      if ( explored . count ( next_vertex ) == 0 ) { 
-        //std::cout << "6 determined that " << str(next_vertex) << " has not been explored\n";
-        dfs_stack . push ( next_vertex );
-        parent[next_vertex] = vertex;
-        //std::cout << "7 Setting parent[" << str(next_vertex) << "] = " << str(vertex) << "\n";
+    for ( uint64_t j : mg . successors ( i ) ) {
+      if ( not ( explored[j >> 6] & ( 1ULL << ( j & 63 ) ) ) ) { 
+        dfs_stack . push_back ( j );
+        parent[j] = i;
       }
     }
-    //std::cout << "8 Done with adjacencies for vertex = " << str(vertex) << "\n";
   }
   return std::vector<Vertex>();
 }
 
 
-/*
-
-uint64_t
-CountCycleMatches ( MatchingGraph const& mg ) {
-  uint64_t N = mg . searchgraph() . size ();
-  uint64_t result = 0;
-  // Loop through starting sg_vertexs
-  for ( uint64_t sg_vertex = 0; sg_vertex < N; ++ sg_vertex ) {
-    // Count the number of paths from (start_sg_vertex, root) to (start_sg_vertex, leaf)
-    uint64_t start = mg . vertex ( sg_vertex, mg . patterngraph . root () );
-    uint64_t end = mg . vertex ( sg_vertex, mg . patterngraph . leaf () );
-    // TODO MAKE SURE start/end exist
-    // We use a data structure which will store the number of paths from a vertex to "end"
-    std::unordered_map<uint64_t, uint64_t> memoization_table; 
-    memoization_table[end] = 1;
-    // The algorithm takes the form of a depth-first-search traversal
-    std::stack<uint64_t> dfs_stack;
-    dfs_stack . push ( start );
-    while ( not dfs_stack . empty () ) {
-      uint64_t vertex = dfs_stack . top ();
-      dfs_stack . pop ();
-      if ( memoization_table . count ( vertex ) == 0 ) {
-        // FIRST VISIT to "vertex" (Preorder step)
-        memoization_table [ vertex ] = -1;
-        // Push the vertex onto dfs_stack again to arrange for second visit
-        dfs_stack . push ( vertex );
-        result_stack . push ( 0 ); // push to result_stack on preorder step
-        for ( uint64_t next_vertex : mg . adjacencies ( vertex ) ) {
-          dfs_stack . push ( next_vertex );
-        }
-      } else { 
-        // SECOND VISIT OR LATER to "vertex"
-        if ( memoization_table [ vertex ] == -1 ) {
-          // SECOND VISIT (Postorder step)
-          memoization_table [ vertex ] = result_stack . top ();
-          result_stack . pop (); // pop from result_stack on postorder step
-        }
-        result_stack . top () += memoization_table [ vertex ];
-      }
-    }
-    result += memoization_table[start];
-  }
-  return result;
-}
-
-uint64_t
-CountPathMatches ( MatchingGraph const& mg ) {
-  uint64_t N = mg . searchgraph() . size ();
-  // Loop through starting sg_vertexs
-  for ( uint64_t sg_vertex = 0; sg_vertex < N; ++ sg_vertex ) {
-    // Count the number of paths from (start_sg_vertex, root) to (start_sg_vertex, leaf)
-    uint64_t start = mg . vertex ( sg_vertex, mg . patterngraph . root () );
-    uint64_t end = mg . patterngraph() . leaf ();
-    // TODO MAKE SURE start/end exist
-    // We use a data structure which will store the number of paths from a vertex to "end"
-    std::unordered_map<uint64_t, uint64_t> memoization_table; 
-    memoization_table[end] = 1;
-    // The algorithm takes the form of a depth-first-search traversal
-    std::stack<uint64_t> dfs_stack;
-    dfs_stack . push ( start );
-    while ( not dfs_stack . empty () ) {
-      uint64_t vertex = dfs_stack . top ();
-      dfs_stack . pop ();
-      if ( memoization_table . count ( vertex ) == 0 ) {
-        // FIRST VISIT to "vertex" (Preorder step)
-        memoization_table [ vertex ] = -1;
-        // Push the vertex onto dfs_stack again to arrange for second visit
-        dfs_stack . push ( vertex );
-        result_stack . push ( 0 ); // push to result_stack on preorder step
-        for ( uint64_t next_vertex : mg . adjacencies ( vertex ) ) {
-          dfs_stack . push ( next_vertex );
-        }
-      } else { 
-        // SECOND VISIT OR LATER to "vertex"
-        if ( memoization_table [ vertex ] == -1 ) {
-          // SECOND VISIT (Postorder step)
-          memoization_table [ vertex ] = result_stack . top ();
-          result_stack . pop (); // pop from result_stack on postorder step
-        }
-        result_stack . top () += memoization_table [ vertex ];
-      }
-    }
-  }
-}
-*/
-
 // Debugging routine
 INLINE_IF_HEADER_ONLY std::string
 ExplainCycleMatch ( MatchingGraph const& mg ) {
@@ -223,7 +402,7 @@ ExplainCycleMatch ( MatchingGraph const& mg ) {
         auto labelstring = [&](uint64_t L) {
           std::string result;
           for ( uint64_t d = 0; d < pg.dimension(); ++ d ){
-            if ( L & (1 << d) ) result.push_back('D'); else result.push_back('I');
+            if ( L & (1ULL << d) ) result.push_back('D'); else result.push_back('I');
           }
           return result;
         };
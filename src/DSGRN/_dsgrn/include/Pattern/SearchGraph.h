@@ -11,6 +11,8 @@
 #include "common.h"
 
 #include "Phase/DomainGraph.h"
+#include "Phase/LazyDomainGraph.h"
+#include "Dynamics/MorseDecomposition.h"
 #include "Graph/Digraph.h"
 
 struct SearchGraph_;
@@ -29,6 +31,11 @@ public:
   ///   Create search graph from a domain graph and a morse set index
   SearchGraph ( DomainGraph dg, uint64_t morse_set_index );
 
+  /// SearchGraph
+  ///   Create search graph from a domain graph and a morse set index
+  ///   using an already computed Morse decomposition of the domain graph
+  SearchGraph ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index );
+
   /// SearchGraph
   ///   Create search graph from a domain graph excluding some variables
   SearchGraph ( DomainGraph dg, std::vector<std::string> const& exclude_vars );
@@ -37,6 +44,25 @@ public:
   ///   Create search graph from a domain graph and a morse set index excluding some variables
   SearchGraph ( DomainGraph dg, uint64_t morse_set_index, std::vector<std::string> const& exclude_vars );
 
+  /// SearchGraph
+  ///   Create search graph from a domain graph and a morse set index excluding some variables
+  ///   using an already computed Morse decomposition of the domain graph
+  SearchGraph ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index, std::vector<std::string> const& exclude_vars );
+
+  /// SearchGraph
+  ///   Create search graph of the Morse set containing a seed domain,
+  ///   labelling only the domains reachable from the seed (for an
+  ///   attractor, the Morse set itself) rather than the phase space.
+  ///   Throws if the seed domain is not in a Morse set, and
+  ///   std::length_error beyond 32 dimensions (labels are uint64_t's).
+  SearchGraph ( LazyDomainGraph ldg, uint64_t seed );
+
+  /// SearchGraph
+  ///   Create search graph of a Morse set given by its domains
+  ///   (e.g. a stored Morse set vertex list), labelling only those domains.
+  ///   Throws std::length_error beyond 32 dimensions.
+  SearchGraph ( LazyDomainGraph ldg, std::vector<uint64_t> const& morse_set );
+
   /// SearchGraph
   ///   Create search graph from a sequence of labels
   ///   (This is used for checking for a pattern in a time series)
@@ -52,6 +78,12 @@ public:
   void
   assign ( DomainGraph dg, uint64_t morse_set_index );
 
+  /// assign
+  ///   Create search graph from a domain graph and a morse set index
+  ///   using an already computed Morse decomposition of the domain graph
+  void
+  assign ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index );
+
   /// assign
   ///   Create search graph from a domain graph excluding some variables
   void
@@ -62,6 +94,30 @@ public:
   void
   assign ( DomainGraph dg, uint64_t morse_set_index, std::vector<std::string> const& exclude_vars );
 
+  /// assign
+  ///   Create search graph from a domain graph and a morse set index excluding some variables
+  ///   using an already computed Morse decomposition of the domain graph
+  void
+  assign ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index, std::vector<std::string> const& exclude_vars );
+
+  /// assign
+  ///   Create search graph of the Morse set containing a seed domain,
+  ///   labelling only the domains near the seed rather than the phase
+  ///   space: the domains downstream and upstream of the seed are
+  ///   searched in turns until either set is exhausted, so about twice
+  ///   the smaller set is explored (for an attractor or a repeller, the
+  ///   Morse set itself). A Morse set with large sets on both sides
+  ///   (e.g. a saddle) may still explore most of the phase space.
+  ///   Throws if the seed domain is not in a Morse set.
+  void
+  assign ( LazyDomainGraph ldg, uint64_t seed );
+
+  /// assign
+  ///   Create search graph of a Morse set given by its domains
+  ///   (e.g. a stored Morse set vertex list), labelling only those domains
+  void
+  assign ( LazyDomainGraph ldg, std::vector<uint64_t> const& morse_set );
+
   /// assign
   ///   Create search graph from a sequence of labels
   ///   (This is used for checking for a pattern in a time series)
@@ -103,6 +159,13 @@ public:
   uint64_t 
   event ( uint64_t source, uint64_t target ) const;
 
+  /// edge_label
+  ///   Given a vertex and the position k of an out-edge in adjacencies(source),
+  ///   return the label of that edge, i.e. event(source, adjacencies(source)[k]).
+  ///   Unlike event this needs no search for the target.
+  uint64_t
+  edge_label ( uint64_t source, uint64_t k ) const;
+
   /// graphviz
   ///   Return a graphviz representation of the search graph
   std::string
@@ -126,13 +189,22 @@ public:
   edgeInformation ( uint64_t source, uint64_t target ) const;
 
 private:
+  /// assign_edges
+  ///   Set the out-edges from (target, label) pairs for each vertex and
+  ///   store their labels parallel to the adjacency lists
+  void
+  assign_edges ( std::vector<std::vector<std::pair<uint64_t,uint64_t>>> & edges );
+
   std::shared_ptr<SearchGraph_> data_;
 };
 
 struct SearchGraph_ {
   Digraph digraph_;
   std::vector<uint64_t> labels_;
-  std::vector<std::unordered_map<uint64_t, uint64_t>> event_;
+  // Labels of the out-edges of vertex v are events_[begin_[v]] ...
+  // events_[begin_[v+1]-1], parallel to digraph_.adjacencies(v)
+  std::vector<uint64_t> begin_;
+  std::vector<uint64_t> events_;
   uint64_t dimension_;
   std::function<std::string(uint64_t)> vertex_information_;
   std::function<std::string(uint64_t,uint64_t)> edge_information_;
@@ -152,12 +224,17 @@ SearchGraphBinding (py::module &m) {
     .def(py::init<DomainGraph const&, uint64_t>())
     .def(py::init<DomainGraph const&, std::vector<std::string> const&>())
     .def(py::init<DomainGraph const&, uint64_t, std::vector<std::string> const&>())
+    .def(py::init<DomainGraph const&, MorseDecomposition const&, uint64_t>())
+    .def(py::init<DomainGraph const&, MorseDecomposition const&, uint64_t, std::vector<std::string> const&>())
+    .def(py::init<LazyDomainGraph const&, uint64_t>())
+    .def(py::init<LazyDomainGraph const&, std::vector<uint64_t> const&>())
     .def(py::init<std::vector<uint64_t> const&, uint64_t>())
     .def("size", &SearchGraph::size)
     .def("dimension", &SearchGraph::dimension)
     .def("label", &SearchGraph::label)
     .def("adjacencies", &SearchGraph::adjacencies)
     .def("event", &SearchGraph::event)
+    .def("edge_label", &SearchGraph::edge_label)
     .def("graphviz", &SearchGraph::graphviz)
     .def("graphviz_with_highlighted_path", &SearchGraph::graphviz_with_highlighted_path)
     .def("vertexInformation", &SearchGraph::vertexInformation)
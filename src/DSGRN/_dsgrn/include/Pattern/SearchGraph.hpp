@@ -30,6 +30,11 @@ SearchGraph ( DomainGraph dg, uint64_t morse_set_index ) {
   assign ( dg, morse_set_index );
 }
 
+SearchGraph::
+SearchGraph ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index ) {
+  assign ( dg, md, morse_set_index );
+}
+
 SearchGraph::
 SearchGraph ( DomainGraph dg, std::vector<std::string> const& exclude_vars ) {
   assign ( dg, exclude_vars );
@@ -40,6 +45,21 @@ SearchGraph ( DomainGraph dg, uint64_t morse_set_index, std::vector<std::string>
   assign ( dg, morse_set_index, exclude_vars );
 }
 
+SearchGraph::
+SearchGraph ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index, std::vector<std::string> const& exclude_vars ) {
+  assign ( dg, md, morse_set_index, exclude_vars );
+}
+
+SearchGraph::
+SearchGraph ( LazyDomainGraph ldg, uint64_t seed ) {
+  assign ( ldg, seed );
+}
+
+SearchGraph::
+SearchGraph ( LazyDomainGraph ldg, std::vector<uint64_t> const& morse_set ) {
+  assign ( ldg, morse_set );
+}
+
 SearchGraph::
 SearchGraph ( std::vector<uint64_t> const& labels, uint64_t dim ) {
   assign ( labels, dim );
@@ -50,30 +70,32 @@ void SearchGraph::
 assign ( DomainGraph dg ) {
   data_ . reset ( new SearchGraph_ );
   data_ -> dimension_ = dg . dimension ();
-  Digraph & digraph = data_ -> digraph_;
   uint64_t N = dg . digraph() . size ();
   for ( uint64_t domain = 0; domain < N; ++ domain ) {
     data_ -> labels_ . push_back ( dg . label ( domain ) );
   }
-  digraph . resize ( N );
-  data_ -> event_ . resize ( N );
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> edges ( N );
   for ( uint64_t source = 0; source < N; ++ source ) {
-    for ( uint64_t target : dg . digraph() . adjacencies ( source ) ) {
+    auto const& adjacencies = dg . digraph() . adjacencies ( source );
+    for ( uint64_t k = 0; k < adjacencies . size (); ++ k ) {
+      uint64_t target = adjacencies [ k ];
       if ( source == target ) continue; // Don't add self-edge to search graph.
-      digraph . add_edge ( source, target );
-      data_ -> event_ [ source ] [ target ] = dg . label ( source, target );
+      edges [ source ] . push_back ( { target, dg . edge_label ( source, k ) } );
     }
   }
-  digraph . finalize ();
+  assign_edges ( edges );
 }
 
 void SearchGraph::
 assign ( DomainGraph dg, uint64_t morse_set_index ) {
+  assign ( dg, MorseDecomposition ( dg . digraph () ), morse_set_index );
+}
+
+void SearchGraph::
+assign ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index ) {
   data_ . reset ( new SearchGraph_ );
   data_ -> dimension_ = dg . dimension ();
-  MorseDecomposition md ( dg . digraph () );
   auto const& morse_set = md . recurrent () [ morse_set_index ];
-  Digraph & digraph = data_ -> digraph_;
   std::unordered_map<uint64_t, uint64_t> domain_to_vertex;
   uint64_t N = 0;
   for ( uint64_t domain : morse_set ) {
@@ -81,21 +103,20 @@ assign ( DomainGraph dg, uint64_t morse_set_index ) {
     data_ -> labels_ . push_back ( dg . label ( domain ) );
     // std::cout << "Domain " << domain << " is vertex " << domain_to_vertex [ domain ] << "\n";
   }
-  digraph . resize ( N );
-  data_ -> event_ . resize ( N );
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> edges ( N );
   std::vector<uint64_t> domains ( N );
   for ( uint64_t source : morse_set ) {
     uint64_t u = domain_to_vertex [ source ];
     domains [ u ] = source;
-    for ( uint64_t target : dg . digraph() . adjacencies ( source ) ) {
-      if ( domain_to_vertex . count ( target ) ) {
-        uint64_t v = domain_to_vertex [ target ];
-        digraph . add_edge ( u, v );
-        data_ -> event_ [ u ] [ v ] = dg . label ( source, target );
+    auto const& adjacencies = dg . digraph() . adjacencies ( source );
+    for ( uint64_t k = 0; k < adjacencies . size (); ++ k ) {
+      auto it = domain_to_vertex . find ( adjacencies [ k ] );
+      if ( it != domain_to_vertex . end () ) {
+        edges [ u ] . push_back ( { it -> second, dg . edge_label ( source, k ) } );
       }
     }
   }
-  digraph . finalize ();
+  assign_edges ( edges );
   // Debug information (Note: will not survive a serialization/deserialization)
   MatchingRelation mr(dimension());
   data_ -> vertex_information_ = [=](uint64_t v ){
@@ -133,23 +154,23 @@ assign ( DomainGraph dg, std::vector<std::string> const& exclude_vars ) {
   data_ . reset ( new SearchGraph_ );
   uint64_t D = dg . dimension ();
   data_ -> dimension_ = D;
-  Digraph & digraph = data_ -> digraph_;
   // Create a node name to index map
   std::unordered_map<std::string, uint64_t> index_by_name;
   for ( uint64_t index = 0; index < D; ++ index ) {
     std::string name = dg . parameter () . network () . name ( index );
     index_by_name [ name ] = index;
   }
-  // Check if names are valid and set flags for exclude varibales
-  std::vector<bool> exclude (D, false);
+  // Check if names are valid and set the label bits of exclude varibales
+  // (an edge label has at most one bit set, that of the regulated variable)
+  uint64_t exclude = 0;
   for ( auto var_name : exclude_vars ) {
     // Check if varibale name is valid
     if ( index_by_name . count ( var_name ) == 0 ) {
       throw std::runtime_error ( "Invalid variable name: " + var_name );
     }
-    // Get variable index and set exclude to true
+    // Get variable index and set its bits index and index + D
     uint64_t index = index_by_name [ var_name ];
-    exclude [ index ] = true;
+    exclude |= (1LL << index) | (1LL << (index + D));
   }
 
   uint64_t N = dg . digraph() . size ();
@@ -164,48 +185,51 @@ assign ( DomainGraph dg, std::vector<std::string> const& exclude_vars ) {
     }
     data_ -> labels_ . push_back ( vertex_label );
   }
-  digraph . resize ( N );
-  data_ -> event_ . resize ( N );
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> edges ( N );
   for ( uint64_t source = 0; source < N; ++ source ) {
-    for ( uint64_t target : dg . digraph() . adjacencies ( source ) ) {
+    auto const& adjacencies = dg . digraph() . adjacencies ( source );
+    for ( uint64_t k = 0; k < adjacencies . size (); ++ k ) {
+      uint64_t target = adjacencies [ k ];
       if ( source == target ) continue; // Don't add self-edge to search graph.
-      digraph . add_edge ( source, target );
-      uint64_t edge_label = dg . label ( source, target );
-      uint64_t regulated_var = dg .regulator ( source, target );
-      // Set edge label to 0 if regulated_var is one of the exclude_vars
-      if ( exclude [ regulated_var ] ) {
+      uint64_t edge_label = dg . edge_label ( source, k );
+      // Set edge label to 0 if the regulated variable is one of the exclude_vars
+      if ( edge_label & exclude ) {
         edge_label = 0;
       }
-      data_ -> event_ [ source ] [ target ] = edge_label;
+      edges [ source ] . push_back ( { target, edge_label } );
     }
   }
-  digraph . finalize ();
+  assign_edges ( edges );
 }
 
 void SearchGraph::
 assign ( DomainGraph dg, uint64_t morse_set_index, std::vector<std::string> const& exclude_vars ) {
+  assign ( dg, MorseDecomposition ( dg . digraph () ), morse_set_index, exclude_vars );
+}
+
+void SearchGraph::
+assign ( DomainGraph dg, MorseDecomposition const& md, uint64_t morse_set_index, std::vector<std::string> const& exclude_vars ) {
   data_ . reset ( new SearchGraph_ );
   uint64_t D = dg . dimension ();
   data_ -> dimension_ = D;
-  MorseDecomposition md ( dg . digraph () );
   auto const& morse_set = md . recurrent () [ morse_set_index ];
-  Digraph & digraph = data_ -> digraph_;
   // Create a node name to index map
   std::unordered_map<std::string, uint64_t> index_by_name;
   for ( uint64_t index = 0; index < D; ++ index ) {
     std::string name = dg . parameter () . network () . name ( index );
     index_by_name [ name ] = index;
   }
-  // Check if names are valid and set flags for exclude varibales
-  std::vector<bool> exclude (D, false);
+  // Check if names are valid and set the label bits of exclude varibales
+  // (an edge label has at most one bit set, that of the regulated variable)
+  uint64_t exclude = 0;
   for ( auto var_name : exclude_vars ) {
     // Check if varibale name is valid
     if ( index_by_name . count ( var_name ) == 0 ) {
       throw std::runtime_error ( "Invalid variable name: " + var_name );
     }
-    // Get variable index and set exclude to true
+    // Get variable index and set its bits index and index + D
     uint64_t index = index_by_name [ var_name ];
-    exclude [ index ] = true;
+    exclude |= (1LL << index) | (1LL << (index + D));
   }
 
   std::unordered_map<uint64_t, uint64_t> domain_to_vertex;
@@ -221,26 +245,119 @@ assign ( DomainGraph dg, uint64_t morse_set_index, std::vector<std::string> cons
     data_ -> labels_ . push_back ( vertex_label );
     // std::cout << "Domain " << domain << " is vertex " << domain_to_vertex [ domain ] << "\n";
   }
-  digraph . resize ( N );
-  data_ -> event_ . resize ( N );
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> edges ( N );
   for ( uint64_t source : morse_set ) {
     uint64_t u = domain_to_vertex [ source ];
-    for ( uint64_t target : dg . digraph() . adjacencies ( source ) ) {
+    auto const& adjacencies = dg . digraph() . adjacencies ( source );
+    for ( uint64_t k = 0; k < adjacencies . size (); ++ k ) {
+      uint64_t target = adjacencies [ k ];
       if ( source == target ) continue; // Don't add self-edge to search graph.
-      if ( domain_to_vertex . count ( target ) ) {
-        uint64_t v = domain_to_vertex [ target ];
-        digraph . add_edge ( u, v );
-        uint64_t edge_label = dg . label ( source, target );
-        uint64_t regulated_var = dg .regulator ( source, target );
-        // Set edge label to 0 if regulated_var is one of the exclude_vars
-        if ( exclude [ regulated_var ] ) {
+      auto it = domain_to_vertex . find ( target );
+      if ( it != domain_to_vertex . end () ) {
+        uint64_t edge_label = dg . edge_label ( source, k );
+        // Set edge label to 0 if the regulated variable is one of the exclude_vars
+        if ( edge_label & exclude ) {
           edge_label = 0;
         }
-        data_ -> event_ [ u ] [ v ] = edge_label;
+        edges [ u ] . push_back ( { it -> second, edge_label } );
       }
     }
   }
-  digraph . finalize ();
+  assign_edges ( edges );
+}
+
+/// Search graph labels are uint64_t's, as are the labels of pattern
+/// graphs and matching graphs, so pattern matching is limited to 32
+/// dimensions even though LazyDomainGraph goes beyond
+inline void
+SearchGraphCheckLabelWords ( LazyDomainGraph const& ldg ) {
+  if ( ldg . label_words () > 1 ) {
+    throw std::length_error ( "SearchGraph: labels of more than 32 dimensions do not fit in 64 bits" );
+  }
+}
+
+void SearchGraph::
+assign ( LazyDomainGraph ldg, uint64_t seed ) {
+  SearchGraphCheckLabelWords ( ldg );
+  // Local strong component of the seed: the domains reachable from
+  // the seed which can also reach it back. The forward (side 0) and
+  // backward (side 1) closures of the seed are grown in turns until one
+  // of them is complete; it contains the component, which is then found
+  // by searching the other way within it.
+  std::unordered_set<uint64_t> closure [ 2 ] = { { seed }, { seed } };
+  std::vector<uint64_t> frontier [ 2 ] = { { seed }, { seed } };
+  int side = 0;
+  while ( not frontier [ side ] . empty () ) {
+    uint64_t domain = frontier [ side ] . back ();
+    frontier [ side ] . pop_back ();
+    for ( uint64_t next : side ? ldg . predecessors ( domain ) : ldg . adjacencies ( domain ) ) {
+      if ( closure [ side ] . insert ( next ) . second ) frontier [ side ] . push_back ( next );
+    }
+    side = 1 - side;
+  }
+  std::unordered_set<uint64_t> const& complete = closure [ side ];
+  std::unordered_set<uint64_t> component { seed };
+  std::vector<uint64_t> stack { seed };
+  while ( not stack . empty () ) {
+    uint64_t domain = stack . back ();
+    stack . pop_back ();
+    for ( uint64_t next : side ? ldg . adjacencies ( domain ) : ldg . predecessors ( domain ) ) {
+      if ( complete . count ( next ) && component . insert ( next ) . second ) stack . push_back ( next );
+    }
+  }
+  auto const& adjacencies = ldg . adjacencies ( seed );
+  if ( component . size () == 1 && not std::binary_search ( adjacencies . begin (), adjacencies . end (), seed ) ) {
+    throw std::invalid_argument ( "SearchGraph: domain " + std::to_string ( seed ) + " is not in a Morse set" );
+  }
+  std::vector<uint64_t> morse_set ( component . begin (), component . end () );
+  std::sort ( morse_set . begin (), morse_set . end () );
+  assign ( ldg, morse_set );
+}
+
+void SearchGraph::
+assign ( LazyDomainGraph ldg, std::vector<uint64_t> const& morse_set ) {
+  SearchGraphCheckLabelWords ( ldg );
+  data_ . reset ( new SearchGraph_ );
+  data_ -> dimension_ = ldg . dimension ();
+  std::unordered_map<uint64_t, uint64_t> domain_to_vertex;
+  uint64_t N = 0;
+  for ( uint64_t domain : morse_set ) {
+    domain_to_vertex [ domain ] = N ++;
+    data_ -> labels_ . push_back ( ldg . label ( domain ) );
+  }
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> edges ( N );
+  for ( uint64_t source : morse_set ) {
+    uint64_t u = domain_to_vertex [ source ];
+    for ( uint64_t target : ldg . adjacencies ( source ) ) {
+      auto it = domain_to_vertex . find ( target );
+      if ( it != domain_to_vertex . end () ) {
+        edges [ u ] . push_back ( { it -> second, ldg . label ( source, target ) } );
+      }
+    }
+  }
+  assign_edges ( edges );
+  // Debug information (Note: will not survive a serialization/deserialization)
+  std::vector<uint64_t> domains ( morse_set );
+  data_ -> vertex_information_ = [=](uint64_t v ){
+    std::stringstream ss;
+    ss << "(";
+    bool first = true;
+    for ( auto const& x : ldg . coordinates ( domains [ v ] ) ) {
+      if ( first ) first = false; else ss << ", ";
+      ss << .5 + (float) x;
+    }
+    ss << ")";
+    return ss . str ();
+  };
+  MatchingRelation mr(dimension());
+  data_ -> edge_information_ = [=](uint64_t u, uint64_t v ){
+    std::stringstream ss;
+    ss << "Transition from " << u << " to " << v << " in searchgraph.\n";
+    ss << u << " is domain " << domains[u] << " with coordinates " << vertexInformation(u) << "\n";
+    ss << v << " is domain " << domains[v] << " with coordinates " << vertexInformation(v) << "\n";
+    ss << "(" << u << ", " << v << ") has label " << mr.edge_labelstring(event(u,v)) << "(" << event(u,v) << ")\n";
+    return ss.str();
+  };
 }
 
 // TODO PROBLEM: This code is uncovered by tests.
@@ -250,13 +367,11 @@ assign ( std::vector<uint64_t> const& labels, uint64_t dim ) {
   data_ -> dimension_ = dim;
   data_ -> labels_ = labels;
   uint64_t N = labels . size ();
-  data_ -> digraph_ . resize ( N );
-  data_ -> event_ . resize ( N );
-  for ( uint64_t v = 0; v < N-1; ++ v ) {
-    data_ -> digraph_ . add_edge ( v, v+1 );
-    data_ -> event_ [ v ] [ v+1 ] = (label(v) ^ label(v+1)) & label(v+1);
+  std::vector<std::vector<std::pair<uint64_t,uint64_t>>> edges ( N );
+  for ( uint64_t v = 0; v + 1 < N; ++ v ) {
+    edges [ v ] . push_back ( { v+1, (label(v) ^ label(v+1)) & label(v+1) } );
   }
-  data_ -> digraph_ . finalize ();
+  assign_edges ( edges );
   // Debug information (Note: will not survive a serialization/deserialization)
   MatchingRelation mr(dimension());
   data_ -> vertex_information_ = [=]( uint64_t v ){
@@ -274,6 +389,24 @@ assign ( std::vector<uint64_t> const& labels, uint64_t dim ) {
   };
 } 
 
+void SearchGraph::
+assign_edges ( std::vector<std::vector<std::pair<uint64_t,uint64_t>>> & edges ) {
+  uint64_t N = edges . size ();
+  Digraph & digraph = data_ -> digraph_;
+  digraph . resize ( N );
+  data_ -> begin_ . assign ( N + 1, 0 );
+  data_ -> events_ . clear ();
+  for ( uint64_t source = 0; source < N; ++ source ) {
+    // Sort by target, as Digraph::finalize does for the adjacency lists
+    std::sort ( edges [ source ] . begin (), edges [ source ] . end () );
+    for ( auto const& edge : edges [ source ] ) {
+      digraph . add_edge ( source, edge . first );
+      data_ -> events_ . push_back ( edge . second );
+    }
+    data_ -> begin_ [ source + 1 ] = data_ -> events_ . size ();
+  }
+}
+
 uint64_t SearchGraph::
 size ( void ) const {
   return data_ -> digraph_ . size ();
@@ -296,7 +429,15 @@ adjacencies ( uint64_t v ) const {
 
 uint64_t SearchGraph::
 event ( uint64_t source, uint64_t target ) const {
-  return data_ -> event_ [ source ] [ target ];
+  auto const& adjacencies = data_ -> digraph_ . adjacencies ( source );
+  auto it = std::lower_bound ( adjacencies . begin (), adjacencies . end (), target );
+  if ( it == adjacencies . end () || *it != target ) return 0;
+  return edge_label ( source, it - adjacencies . begin () );
+}
+
+uint64_t SearchGraph::
+edge_label ( uint64_t source, uint64_t k ) const {
+  return data_ -> events_ [ data_ -> begin_ [ source ] + k ];
 }
 
 std::string SearchGraph::
@@ -75,6 +75,14 @@ public:
   uint64_t 
   label ( uint64_t source, uint64_t target ) const;
 
+  /// edge_label
+  ///   Given a domain and the position k of an out-edge in
+  ///   digraph().adjacencies(source), return the label of that edge,
+  ///   i.e. label(source, digraph().adjacencies(source)[k]).
+  ///   The labels of all edges are computed with the graph.
+  uint64_t
+  edge_label ( uint64_t source, uint64_t k ) const;
+
   /// direction
   ///   Given adjacent domains, return the variable
   ///   in which they differ. Given the same domain 
@@ -116,6 +124,10 @@ struct DomainGraph_ {
   Parameter parameter_;
   std::vector<uint64_t> labelling_;
   std::unordered_map<uint64_t,uint64_t> direction_;
+  // Labels of the out-edges of domain i are edge_labels_[edge_begin_[i]]
+  // ... edge_labels_[edge_begin_[i+1]-1], parallel to digraph_.adjacencies(i)
+  std::vector<uint64_t> edge_begin_;
+  std::vector<uint64_t> edge_labels_;
 };
 
 /// Python Bindings
@@ -136,6 +148,7 @@ DomainGraphBinding (py::module &m) {
     .def("coordinates", &DomainGraph::coordinates)
     .def("label", (uint64_t(DomainGraph::*)(uint64_t)const)&DomainGraph::label)
     .def("label", (uint64_t(DomainGraph::*)(uint64_t,uint64_t)const)&DomainGraph::label)
+    .def("edge_label", &DomainGraph::edge_label)
     .def("direction", &DomainGraph::direction)
     .def("regulator", &DomainGraph::regulator)
     .def("annotate", &DomainGraph::annotate)
@@ -25,6 +25,9 @@ DomainGraph ( Parameter const& parameter ) {
 
 INLINE_IF_HEADER_ONLY void DomainGraph::
 assign ( Parameter const& parameter ) {
+  if ( parameter . network () . size () > 32 ) {
+    throw std::length_error ( "DomainGraph: networks of more than 32 nodes are not supported (see LazyDomainGraph)" );
+  }
   data_ . reset ( new DomainGraph_ );
   data_ -> parameter_ = parameter;
   uint64_t D = parameter . network () . size ();
@@ -74,6 +77,46 @@ assign ( Parameter const& parameter ) {
     }
   }
   digraph . finalize ();
+  // Edge labels (see label(source,target)). The label of a wall only
+  // depends on its direction d, its threshold t and the orientation of
+  // the edge, so tabulate them per wall first.
+  Network network = parameter . network ();
+  std::vector<uint64_t> wall_begin ( D + 1, 0 );
+  for ( uint64_t d = 0; d < D; ++ d ) wall_begin [ d + 1 ] = wall_begin [ d ] + 2 * limits [ d ];
+  std::vector<uint64_t> wall_labels ( wall_begin [ D ], 0 );
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    for ( uint64_t t = 0; t + 1 < limits [ d ]; ++ t ) {
+      uint64_t j = parameter . regulator ( d, t );
+      if ( j == d || j == D ) continue;
+      bool interaction = network . interaction ( d, j );
+      // Edges towards higher domains at 2t, towards lower domains at 2t+1
+      wall_labels [ wall_begin [ d ] + 2 * t ] = 1LL << ( j + ( interaction ? D : 0 ) );
+      wall_labels [ wall_begin [ d ] + 2 * t + 1 ] = 1LL << ( j + ( interaction ? 0 : D ) );
+    }
+  }
+  data_ -> edge_begin_ . assign ( N + 1, 0 );
+  data_ -> edge_labels_ . clear ();
+  std::vector<uint64_t> & edge_labels = data_ -> edge_labels_;
+  std::vector<uint64_t> coordinates ( D, 0 );
+  for ( uint64_t i = 0; i < N; ++ i ) {
+    for ( uint64_t j : digraph . adjacencies ( i ) ) {
+      if ( i == j ) {
+        edge_labels . push_back ( 0 );
+      } else if ( j > i ) {
+        uint64_t d = data_ -> direction_ [ j - i ];
+        edge_labels . push_back ( wall_labels [ wall_begin [ d ] + 2 * coordinates [ d ] ] );
+      } else {
+        uint64_t d = data_ -> direction_ [ i - j ];
+        edge_labels . push_back ( wall_labels [ wall_begin [ d ] + 2 * ( coordinates [ d ] - 1 ) + 1 ] );
+      }
+    }
+    data_ -> edge_begin_ [ i + 1 ] = edge_labels . size ();
+    // Advance the coordinates of domain i to those of domain i+1
+    for ( uint64_t d = 0; d < D; ++ d ) {
+      if ( ++ coordinates [ d ] < limits [ d ] ) break;
+      coordinates [ d ] = 0;
+    }
+  }
 }
 
 INLINE_IF_HEADER_ONLY Parameter const DomainGraph::
@@ -119,6 +162,11 @@ label ( uint64_t source, uint64_t target ) const {
   return 1L << ( j + ( ((source < target) ^ interaction) ? 0 : dimension() ) );
 }
 
+INLINE_IF_HEADER_ONLY uint64_t DomainGraph::
+edge_label ( uint64_t source, uint64_t k ) const {
+  return data_ -> edge_labels_ [ data_ -> edge_begin_ [ source ] + k ];
+}
+
 INLINE_IF_HEADER_ONLY uint64_t DomainGraph::
 direction ( uint64_t source, uint64_t target ) const {
   if ( source == target ) return dimension ();
@@ -0,0 +1,109 @@
+/// DomainLabel.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// WideLabel
+///   Wall label (see Parameter::labelling) of W 64 bit words, for phase
+///   spaces whose 2D wall bits do not fit in a uint64_t. Bit i is bit
+///   i % 64 of word i / 64. Only LazyDomainGraph uses it, as WideLabel<2>
+///   for 33 to 63 dimensions, and only the operations its labelling and
+///   adjacency code applies to uint64_t labels are provided, so that code
+///   is written once for both (see DomainLabelTraits).
+template < uint64_t W >
+class WideLabel {
+public:
+  WideLabel ( void ) {
+    words_ . fill ( 0 );
+  }
+
+  /// set
+  ///   Set bit i
+  void
+  set ( uint64_t i ) {
+    words_ [ i >> 6 ] |= 1ULL << ( i & 63 );
+  }
+
+  /// words
+  ///   Return the words, least significant first
+  std::vector<uint64_t>
+  words ( void ) const {
+    return std::vector<uint64_t> ( words_ . begin (), words_ . end () );
+  }
+
+  explicit operator bool ( void ) const {
+    for ( uint64_t k = 0; k < W; ++ k ) if ( words_ [ k ] ) return true;
+    return false;
+  }
+
+  WideLabel &
+  operator &= ( WideLabel const& rhs ) {
+    for ( uint64_t k = 0; k < W; ++ k ) words_ [ k ] &= rhs . words_ [ k ];
+    return *this;
+  }
+
+  WideLabel &
+  operator |= ( WideLabel const& rhs ) {
+    for ( uint64_t k = 0; k < W; ++ k ) words_ [ k ] |= rhs . words_ [ k ];
+    return *this;
+  }
+
+  WideLabel
+  operator >> ( uint64_t shift ) const {
+    WideLabel result;
+    uint64_t words = shift >> 6;
+    uint64_t bits = shift & 63;
+    for ( uint64_t k = 0; k + words < W; ++ k ) {
+      result . words_ [ k ] = words_ [ k + words ] >> bits;
+      if ( bits && k + words + 1 < W ) result . words_ [ k ] |= words_ [ k + words + 1 ] << ( 64 - bits );
+    }
+    return result;
+  }
+
+  friend WideLabel operator & ( WideLabel lhs, WideLabel const& rhs ) { return lhs &= rhs; }
+
+  friend bool operator == ( WideLabel const& lhs, WideLabel const& rhs ) { return lhs . words_ == rhs . words_; }
+
+private:
+  std::array<uint64_t, W> words_;
+};
+
+/// DomainLabelTraits
+///   Construction of labels of type Label (uint64_t, or WideLabel in
+///   LazyDomainGraph beyond 32 dimensions): bit(i) has bit i set and
+///   low(k) the k least significant bits
+template < typename Label >
+struct DomainLabelTraits;
+
+template <>
+struct DomainLabelTraits<uint64_t> {
+  static uint64_t bit ( uint64_t i ) { return 1ULL << i; }
+  static uint64_t low ( uint64_t k ) { return ( k >= 64 ) ? ~ 0ULL : ( 1ULL << k ) - 1; }
+};
+
+template < uint64_t W >
+struct DomainLabelTraits<WideLabel<W>> {
+  static WideLabel<W> bit ( uint64_t i ) {
+    WideLabel<W> result;
+    result . set ( i );
+    return result;
+  }
+  static WideLabel<W> low ( uint64_t k ) {
+    WideLabel<W> result;
+    for ( uint64_t i = 0; i < k && i < 64 * W; ++ i ) result . set ( i );
+    return result;
+  }
+};
+
+/// domain_label_words
+///   Return the number of 64 bit words of the wall labels of a phase
+///   space of dimension D (2D bits)
+inline uint64_t
+domain_label_words ( uint64_t D ) {
+  return ( 2 * D + 63 ) / 64;
+}
@@ -0,0 +1,209 @@
+/// LazyDomainGraph.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Parameter/Parameter.h"
+#include "Phase/DomainLabel.h"
+
+struct LazyDomainGraph_;
+
+/// LazyDomainGraph
+///   The domain graph of a parameter with labels and adjacencies
+///   computed on demand, one domain at a time, instead of for the
+///   whole phase space. Labels agree with Parameter::labelling
+///   (including the blowup of self-edge thresholds), adjacencies
+///   with DomainGraph::digraph and edge labels with DomainGraph::label.
+///   Computed labels are cached; the cache makes the class unsuitable
+///   for concurrent use of the same object.
+///
+///   Since only the explored domains are labelled, the phase space may
+///   have more than 32 dimensions, as long as the number of domains fits
+///   in 64 bits (so at most 63 dimensions, each having at least two
+///   domains). Beyond 32 dimensions labels are WideLabel's of two words
+///   instead of uint64_t's (see label_words), returned by wide_label,
+///   and only the queries of this class are supported: DomainGraph,
+///   Parameter::labelling and pattern matching (SearchGraph,
+///   PatternGraph, MatchingGraph) use uint64_t labels and throw
+///   std::length_error beyond 32 dimensions.
+class LazyDomainGraph : public TypedObject {
+public:
+
+  /// type
+  virtual std::string type (void) const final { return "LazyDomainGraph"; }
+
+  /// constructor
+  LazyDomainGraph ( void );
+
+  /// LazyDomainGraph
+  ///   Construct based on parameter and network.
+  ///   Throws std::length_error if the number of domains does not fit
+  ///   in 64 bits.
+  explicit LazyDomainGraph ( Parameter const& parameter );
+
+  /// assign
+  ///   Construct based on parameter and network
+  void
+  assign ( Parameter const& parameter );
+
+  /// parameter
+  ///   Return underlying parameter
+  Parameter const
+  parameter ( void ) const;
+
+  /// dimension
+  ///   Return dimension of phase space
+  uint64_t
+  dimension ( void ) const;
+
+  /// size
+  ///   Return the number of domains
+  uint64_t
+  size ( void ) const;
+
+  /// coordinates
+  ///   Given a domain, return its coordinates (see DomainGraph::coordinates)
+  std::vector<uint64_t>
+  coordinates ( uint64_t domain ) const;
+
+  /// label_words
+  ///   Return the number of 64 bit words of a label: 1 for at most 32
+  ///   dimensions, 2 otherwise
+  uint64_t
+  label_words ( void ) const;
+
+  /// label
+  ///   Given a domain, return its wall label (see DomainGraph::label).
+  ///   Throws std::length_error if label_words () > 1.
+  uint64_t
+  label ( uint64_t domain ) const;
+
+  /// label
+  ///   Given a pair of adjacent domains (source, target), return the
+  ///   search graph label of the edge (see DomainGraph::label).
+  ///   Throws std::length_error if its bit does not fit in 64 bits,
+  ///   and std::invalid_argument if the domains are not adjacent.
+  uint64_t
+  label ( uint64_t source, uint64_t target ) const;
+
+  /// wide_label
+  ///   Given a domain, return the label_words () words of its wall
+  ///   label, least significant first
+  std::vector<uint64_t>
+  wide_label ( uint64_t domain ) const;
+
+  /// wide_label
+  ///   Given a pair of adjacent domains (source, target), return the
+  ///   label_words () words of the search graph label of the edge.
+  ///   Throws std::invalid_argument if the domains are not adjacent.
+  std::vector<uint64_t>
+  wide_label ( uint64_t source, uint64_t target ) const;
+
+  /// adjacencies
+  ///   Return the sorted out-edge adjacencies of a domain,
+  ///   including the domain itself if it has a self-edge
+  std::vector<uint64_t>
+  adjacencies ( uint64_t domain ) const;
+
+  /// predecessors
+  ///   Return the sorted in-edge adjacencies of a domain,
+  ///   including the domain itself if it has a self-edge
+  std::vector<uint64_t>
+  predecessors ( uint64_t domain ) const;
+
+  /// explored
+  ///   Return the number of domains whose label has been computed
+  uint64_t
+  explored ( void ) const;
+
+private:
+  /// wall
+  ///   Return the left (bit d) and right (bit D+d) wall bits in
+  ///   dimension d of the domain of the unblown-up phase space
+  ///   with the given coordinates
+  template < typename Label >
+  Label
+  wall ( std::vector<uint64_t> const& coordinates, uint64_t d ) const;
+
+  /// label_as
+  ///   Return the wall label of a domain as a Label
+  template < typename Label >
+  Label
+  label_as ( uint64_t domain ) const;
+
+  /// labels
+  ///   Return the cache of labels of type Label
+  template < typename Label >
+  std::unordered_map<uint64_t, Label> &
+  labels ( void ) const;
+
+  /// edge_bit
+  ///   Return the bit of the search graph label of an edge, or -1
+  ///   for a self-edge. Throws std::invalid_argument if the domains
+  ///   are not adjacent.
+  uint64_t
+  edge_bit ( uint64_t source, uint64_t target ) const;
+
+  template < typename Label >
+  std::vector<uint64_t>
+  adjacencies_as ( uint64_t domain ) const;
+
+  template < typename Label >
+  std::vector<uint64_t>
+  predecessors_as ( uint64_t domain ) const;
+
+  std::shared_ptr<LazyDomainGraph_> data_;
+};
+
+struct LazyDomainGraph_ {
+  Parameter parameter_;
+  uint64_t dimension_;
+  uint64_t size_;
+  std::vector<uint64_t> limits_;
+  std::vector<uint64_t> jump_;
+  /// extended_[d][i] is the coordinate, in the phase space with every
+  /// threshold blown up, of the domains with ith coordinate i in dimension d
+  std::vector<std::vector<uint64_t>> extended_;
+  /// inputs_[d] lists (source, critical bin, activating) for each input of d
+  std::vector<std::vector<std::tuple<uint64_t,uint64_t,bool>>> inputs_;
+  std::vector<LogicParameter> logic_;
+  /// bits of the edge labels of the walls of dimension d (or -1):
+  /// wall_bits_[wall_begin_[d]+2t] for edges crossing threshold t
+  /// upwards, +1 for downwards
+  std::vector<uint64_t> wall_begin_;
+  std::vector<uint64_t> wall_bits_;
+  /// number of words of a label
+  uint64_t words_;
+  /// labels computed so far, in labels_ if words_ is 1 and in
+  /// wide_labels_ otherwise
+  std::unordered_map<uint64_t,uint64_t> labels_;
+  std::unordered_map<uint64_t,WideLabel<2>> wide_labels_;
+};
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+inline void
+LazyDomainGraphBinding (py::module &m) {
+  py::class_<LazyDomainGraph, std::shared_ptr<LazyDomainGraph>, TypedObject>(m, "LazyDomainGraph")
+    .def(py::init<>())
+    .def(py::init<Parameter const&>())
+    .def("parameter", &LazyDomainGraph::parameter)
+    .def("dimension", &LazyDomainGraph::dimension)
+    .def("size", &LazyDomainGraph::size)
+    .def("coordinates", &LazyDomainGraph::coordinates)
+    .def("label_words", &LazyDomainGraph::label_words)
+    .def("label", (uint64_t(LazyDomainGraph::*)(uint64_t)const)&LazyDomainGraph::label)
+    .def("label", (uint64_t(LazyDomainGraph::*)(uint64_t,uint64_t)const)&LazyDomainGraph::label)
+    .def("wide_label", (std::vector<uint64_t>(LazyDomainGraph::*)(uint64_t)const)&LazyDomainGraph::wide_label)
+    .def("wide_label", (std::vector<uint64_t>(LazyDomainGraph::*)(uint64_t,uint64_t)const)&LazyDomainGraph::wide_label)
+    .def("adjacencies", &LazyDomainGraph::adjacencies)
+    .def("predecessors", &LazyDomainGraph::predecessors)
+    .def("explored", &LazyDomainGraph::explored);
+}
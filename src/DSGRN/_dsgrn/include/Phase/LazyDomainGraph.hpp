@@ -0,0 +1,307 @@
+/// LazyDomainGraph.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#ifndef INLINE_IF_HEADER_ONLY
+#define INLINE_IF_HEADER_ONLY
+#endif
+
+#include "LazyDomainGraph.h"
+
+#include <limits>
+
+INLINE_IF_HEADER_ONLY LazyDomainGraph::
+LazyDomainGraph ( void ) {
+  data_ . reset ( new LazyDomainGraph_ );
+}
+
+INLINE_IF_HEADER_ONLY LazyDomainGraph::
+LazyDomainGraph ( Parameter const& parameter ) {
+  assign ( parameter );
+}
+
+INLINE_IF_HEADER_ONLY void LazyDomainGraph::
+assign ( Parameter const& parameter ) {
+  data_ . reset ( new LazyDomainGraph_ );
+  data_ -> parameter_ = parameter;
+  Network network = parameter . network ();
+  uint64_t D = network . size ();
+  data_ -> dimension_ = D;
+  data_ -> words_ = domain_label_words ( D );
+  data_ -> limits_ = network . domains ();
+  data_ -> jump_ . resize ( D );
+  data_ -> size_ = 1;
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    data_ -> jump_ [ d ] = data_ -> size_;
+    if ( data_ -> size_ > std::numeric_limits<uint64_t>::max () / data_ -> limits_ [ d ] ) {
+      throw std::length_error ( "LazyDomainGraph: the number of domains does not fit in 64 bits" );
+    }
+    data_ -> size_ *= data_ -> limits_ [ d ];
+  }
+  std::vector<OrderParameter> order = parameter . order ();
+  data_ -> logic_ = parameter . logic ();
+  // Coordinates kept from the phase space with every threshold blown up
+  // (see Parameter::labelling): the regular domains, at odd coordinates,
+  // and the blowups of self-edge thresholds, at even coordinates
+  data_ -> extended_ . resize ( D );
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    std::vector<uint64_t> outputs = network . outputs ( d );
+    // Treat the no out edge case as one out edge
+    uint64_t m = outputs . size ();
+    uint64_t regular_limit = (m ? m : 1) + 1;
+    for ( uint64_t e = 1; e < 2 * regular_limit; ++ e ) {
+      if ( e % 2 == 0 ) {
+        if ( m == 0 ) continue;
+        uint64_t thres = e / 2 - 1;
+        if ( outputs [ order [ d ] ( thres ) ] != d ) continue;
+        // Do not blowup positive self edges if pos_edge_blowup is false
+        if ( not network . pos_edge_blowup () && network . interaction ( d, d ) ) continue;
+      }
+      data_ -> extended_ [ d ] . push_back ( e );
+    }
+    if ( data_ -> extended_ [ d ] . size () != data_ -> limits_ [ d ] ) {
+      throw std::runtime_error ( "LazyDomainGraph: inconsistent number of thresholds for " + network . name ( d ) );
+    }
+  }
+  // Input edges, with the first bin on the activating side of them
+  data_ -> inputs_ . resize ( D );
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    for ( uint64_t source : network . inputs ( d ) ) {
+      uint64_t thres = order [ source ] . inverse ( network . order ( source, d ) ) + 1;
+      data_ -> inputs_ [ d ] . push_back ( std::make_tuple ( source, thres, network . interaction ( source, d ) ) );
+    }
+  }
+  // Edge labels of the walls (see DomainGraph::assign)
+  data_ -> wall_begin_ . assign ( D + 1, 0 );
+  for ( uint64_t d = 0; d < D; ++ d ) data_ -> wall_begin_ [ d + 1 ] = data_ -> wall_begin_ [ d ] + 2 * data_ -> limits_ [ d ];
+  data_ -> wall_bits_ . assign ( data_ -> wall_begin_ [ D ], -1 );
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    for ( uint64_t t = 0; t + 1 < data_ -> limits_ [ d ]; ++ t ) {
+      uint64_t j = parameter . regulator ( d, t );
+      if ( j == d || j == D ) continue;
+      bool interaction = network . interaction ( d, j );
+      data_ -> wall_bits_ [ data_ -> wall_begin_ [ d ] + 2 * t ] = j + ( interaction ? D : 0 );
+      data_ -> wall_bits_ [ data_ -> wall_begin_ [ d ] + 2 * t + 1 ] = j + ( interaction ? 0 : D );
+    }
+  }
+}
+
+INLINE_IF_HEADER_ONLY Parameter const LazyDomainGraph::
+parameter ( void ) const {
+  return data_ -> parameter_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LazyDomainGraph::
+dimension ( void ) const {
+  return data_ -> dimension_;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LazyDomainGraph::
+size ( void ) const {
+  return data_ -> size_;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> LazyDomainGraph::
+coordinates ( uint64_t domain ) const {
+  std::vector<uint64_t> result ( dimension () );
+  for ( uint64_t d = 0; d < dimension (); ++ d ) {
+    result [ d ] = domain % data_ -> limits_ [ d ];
+    domain /= data_ -> limits_ [ d ];
+  }
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LazyDomainGraph::
+label_words ( void ) const {
+  return data_ -> words_;
+}
+
+template < typename Label > Label LazyDomainGraph::
+wall ( std::vector<uint64_t> const& coordinates, uint64_t d ) const {
+  typedef DomainLabelTraits<Label> Traits;
+  // Input combination of d in the domain (see Parameter::labelling)
+  uint64_t in = 0;
+  uint64_t inorder = 0;
+  for ( auto const& input : data_ -> inputs_ [ d ] ) {
+    bool side = ( coordinates [ std::get<0>(input) ] < std::get<1>(input) ) ^ std::get<2>(input);
+    if ( side ) in |= 1LL << inorder;
+    ++ inorder;
+  }
+  uint64_t bin = data_ -> logic_ [ d ] . bin ( in );
+  Label result = Label ();
+  if ( coordinates [ d ] < bin ) result |= Traits::bit ( dimension () + d ); // flows to the right
+  if ( coordinates [ d ] > bin ) result |= Traits::bit ( d ); // flows to the left
+  return result;
+}
+
+template <> inline std::unordered_map<uint64_t,uint64_t> & LazyDomainGraph::
+labels<uint64_t> ( void ) const {
+  return data_ -> labels_;
+}
+
+template <> inline std::unordered_map<uint64_t,WideLabel<2>> & LazyDomainGraph::
+labels<WideLabel<2>> ( void ) const {
+  return data_ -> wide_labels_;
+}
+
+template < typename Label > Label LazyDomainGraph::
+label_as ( uint64_t domain ) const {
+  typedef DomainLabelTraits<Label> Traits;
+  std::unordered_map<uint64_t,Label> & cache = labels<Label> ();
+  auto it = cache . find ( domain );
+  if ( it != cache . end () ) return it -> second;
+  uint64_t D = dimension ();
+  // Coordinates in the blown up phase space, and those of the
+  // regular domain on the right of each blown up threshold
+  std::vector<uint64_t> extended ( D );
+  std::vector<uint64_t> regular ( D );
+  uint64_t index = domain;
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    extended [ d ] = data_ -> extended_ [ d ] [ index % data_ -> limits_ [ d ] ];
+    index /= data_ -> limits_ [ d ];
+    regular [ d ] = extended [ d ] / 2;
+  }
+  Label result = Label ();
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    Label mask_left = Traits::bit ( d );
+    Label mask_right = Traits::bit ( D + d );
+    if ( extended [ d ] % 2 == 1 ) {
+      result |= wall<Label> ( regular, d );
+    } else {
+      // Blowup of a threshold: negate the facing walls of its neighbours
+      if ( not ( wall<Label> ( regular, d ) & mask_left ) ) result |= mask_right;
+      -- regular [ d ];
+      if ( not ( wall<Label> ( regular, d ) & mask_right ) ) result |= mask_left;
+      ++ regular [ d ];
+    }
+  }
+  cache [ domain ] = result;
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LazyDomainGraph::
+label ( uint64_t domain ) const {
+  if ( data_ -> words_ > 1 ) {
+    throw std::length_error ( "LazyDomainGraph::label: labels of more than 32 dimensions do not fit in 64 bits (see wide_label)" );
+  }
+  return label_as<uint64_t> ( domain );
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> LazyDomainGraph::
+wide_label ( uint64_t domain ) const {
+  if ( data_ -> words_ > 1 ) return label_as<WideLabel<2>> ( domain ) . words ();
+  return { label_as<uint64_t> ( domain ) };
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LazyDomainGraph::
+edge_bit ( uint64_t source, uint64_t target ) const {
+  if ( source == target ) return -1;
+  // The domains must differ by one in exactly one coordinate
+  uint64_t D = dimension ();
+  uint64_t s = source;
+  uint64_t t = target;
+  uint64_t d = D;
+  uint64_t low = 0;
+  for ( uint64_t k = 0; k < D; ++ k ) {
+    uint64_t a = s % data_ -> limits_ [ k ];
+    uint64_t b = t % data_ -> limits_ [ k ];
+    s /= data_ -> limits_ [ k ];
+    t /= data_ -> limits_ [ k ];
+    if ( a == b ) continue;
+    if ( d != D || ( a + 1 != b && b + 1 != a ) ) { d = D; break; }
+    d = k;
+    low = std::min ( a, b );
+  }
+  if ( d == D || s != 0 || t != 0 ) {
+    throw std::invalid_argument ( "LazyDomainGraph::label: domains " + std::to_string ( source ) + " and " 
+                                  + std::to_string ( target ) + " are not adjacent" );
+  }
+  return data_ -> wall_bits_ [ data_ -> wall_begin_ [ d ] + 2 * low + ( source < target ? 0 : 1 ) ];
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LazyDomainGraph::
+label ( uint64_t source, uint64_t target ) const {
+  uint64_t bit = edge_bit ( source, target );
+  if ( bit == (uint64_t) -1 ) return 0;
+  if ( bit >= 64 ) {
+    throw std::length_error ( "LazyDomainGraph::label: labels of more than 32 dimensions do not fit in 64 bits (see wide_label)" );
+  }
+  return 1ULL << bit;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> LazyDomainGraph::
+wide_label ( uint64_t source, uint64_t target ) const {
+  std::vector<uint64_t> result ( data_ -> words_, 0 );
+  uint64_t bit = edge_bit ( source, target );
+  if ( bit != (uint64_t) -1 ) result [ bit >> 6 ] |= 1ULL << ( bit & 63 );
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> LazyDomainGraph::
+adjacencies ( uint64_t domain ) const {
+  if ( data_ -> words_ > 1 ) return adjacencies_as<WideLabel<2>> ( domain );
+  return adjacencies_as<uint64_t> ( domain );
+}
+
+INLINE_IF_HEADER_ONLY std::vector<uint64_t> LazyDomainGraph::
+predecessors ( uint64_t domain ) const {
+  if ( data_ -> words_ > 1 ) return predecessors_as<WideLabel<2>> ( domain );
+  return predecessors_as<uint64_t> ( domain );
+}
+
+template < typename Label > std::vector<uint64_t> LazyDomainGraph::
+adjacencies_as ( uint64_t domain ) const {
+  // See DomainGraph::assign
+  typedef DomainLabelTraits<Label> Traits;
+  std::vector<uint64_t> result;
+  uint64_t D = dimension ();
+  Label L = label_as<Label> ( domain );
+  Label left_wall_mask = Traits::low ( D );
+  if ( (L & left_wall_mask) == (L >> D) ) result . push_back ( domain );
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    Label leftbit = Traits::bit ( d );
+    Label rightbit = Traits::bit ( D + d );
+    if ( L & rightbit ) {
+      uint64_t j = domain + data_ -> jump_ [ d ];
+      if ( not ( label_as<Label> ( j ) & leftbit ) ) result . push_back ( j );
+    }
+    if ( L & leftbit ) {
+      uint64_t j = domain - data_ -> jump_ [ d ];
+      if ( not ( label_as<Label> ( j ) & rightbit ) ) result . push_back ( j );
+    }
+  }
+  std::sort ( result . begin (), result . end () );
+  return result;
+}
+
+template < typename Label > std::vector<uint64_t> LazyDomainGraph::
+predecessors_as ( uint64_t domain ) const {
+  typedef DomainLabelTraits<Label> Traits;
+  std::vector<uint64_t> result;
+  uint64_t D = dimension ();
+  Label L = label_as<Label> ( domain );
+  Label left_wall_mask = Traits::low ( D );
+  if ( (L & left_wall_mask) == (L >> D) ) result . push_back ( domain );
+  std::vector<uint64_t> x = coordinates ( domain );
+  for ( uint64_t d = 0; d < D; ++ d ) {
+    Label leftbit = Traits::bit ( d );
+    Label rightbit = Traits::bit ( D + d );
+    if ( x [ d ] > 0 && not ( L & leftbit ) ) {
+      uint64_t j = domain - data_ -> jump_ [ d ];
+      if ( label_as<Label> ( j ) & rightbit ) result . push_back ( j );
+    }
+    if ( x [ d ] + 1 < data_ -> limits_ [ d ] && not ( L & rightbit ) ) {
+      uint64_t j = domain + data_ -> jump_ [ d ];
+      if ( label_as<Label> ( j ) & leftbit ) result . push_back ( j );
+    }
+  }
+  std::sort ( result . begin (), result . end () );
+  return result;
+}
+
+INLINE_IF_HEADER_ONLY uint64_t LazyDomainGraph::
+explored ( void ) const {
+  return data_ -> labels_ . size () + data_ -> wide_labels_ . size ();
+}
@@ -0,0 +1,42 @@
+/// DatabaseIndices.h
+/// 2026-10-19
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+/// DatabaseIndexProfile
+///   A named list of "create index" statements run once all rows of a
+///   signatures database are inserted
+typedef std::pair<std::string,std::vector<std::string>> DatabaseIndexProfile;
+
+/// DatabaseIndexProfiles
+///   Return the index profiles of the signatures databases written by
+///   DSGRN-Database and Signatures.py, for the legacy (compact = false)
+///   or the compact schema.
+///     "full"  : all indices (default)
+///     "query" : only the indices used by the DSGRN.Query modules
+///               (skips the Graphviz text index and reverse lookups)
+///     "none"  : no indices (e.g. shards to be merged by merge.sh)
+std::vector<DatabaseIndexProfile> const&
+DatabaseIndexProfiles ( bool compact = false );
+
+/// DatabaseIndexStatements
+///   Return the statements of the named index profile. Throws
+///   std::invalid_argument if there is no such profile.
+std::vector<std::string> const&
+DatabaseIndexStatements ( std::string const& profile, bool compact = false );
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+inline void
+DatabaseIndicesBinding (py::module &m) {
+  m.def("DatabaseIndexProfiles", &DatabaseIndexProfiles, py::arg("compact") = false);
+  m.def("DatabaseIndexStatements", &DatabaseIndexStatements, py::arg("profile"), py::arg("compact") = false);
+}
@@ -0,0 +1,46 @@
+/// DatabaseIndices.hpp
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "DatabaseIndices.h"
+
+inline std::vector<DatabaseIndexProfile> const&
+DatabaseIndexProfiles ( bool compact ) {
+  static std::vector<DatabaseIndexProfile> const legacy = {
+    { "full", {
+      "create index if not exists Signatures2 on Signatures (MorseGraphIndex, ParameterIndex);",
+      "create index if not exists MorseGraphAnnotations3 on MorseGraphAnnotations (Label, MorseGraphIndex);",
+      "create index if not exists MorseGraphViz2 on MorseGraphViz (Graphviz, MorseGraphIndex);",
+      "create index if not exists MorseGraphVertices1 on MorseGraphVertices (MorseGraphIndex, Vertex);",
+      "create index if not exists MorseGraphVertices2 on MorseGraphVertices (Vertex, MorseGraphIndex);",
+      "create index if not exists MorseGraphEdges1 on MorseGraphEdges (MorseGraphIndex);",
+      "create index if not exists MorseGraphAnnotations1 on MorseGraphAnnotations (MorseGraphIndex);" } },
+    { "query", {
+      "create index if not exists Signatures2 on Signatures (MorseGraphIndex, ParameterIndex);",
+      "create index if not exists MorseGraphAnnotations3 on MorseGraphAnnotations (Label, MorseGraphIndex);",
+      "create index if not exists MorseGraphVertices1 on MorseGraphVertices (MorseGraphIndex, Vertex);",
+      "create index if not exists MorseGraphEdges1 on MorseGraphEdges (MorseGraphIndex);" } },
+    { "none", {} } };
+  // Lookups of vertices, edges and Graphviz by MorseGraphIndex use the
+  // primary keys of MorseGraphs and Positions, and label lookups the
+  // UNIQUE index of AnnotationLabels, so only MorseGraphLabels is indexed.
+  static std::vector<DatabaseIndexProfile> const compacted = {
+    { "full", {
+      "create index if not exists Signatures2 on Signatures (MorseGraphIndex, ParameterIndex);",
+      "create index if not exists MorseGraphAnnotations3 on MorseGraphLabels (LabelIndex, MorseGraphIndex);",
+      "create index if not exists MorseGraphAnnotations1 on MorseGraphLabels (MorseGraphIndex);" } },
+    { "query", {
+      "create index if not exists Signatures2 on Signatures (MorseGraphIndex, ParameterIndex);",
+      "create index if not exists MorseGraphAnnotations3 on MorseGraphLabels (LabelIndex, MorseGraphIndex);",
+      "create index if not exists MorseGraphAnnotations1 on MorseGraphLabels (MorseGraphIndex);" } },
+    { "none", {} } };
+  return compact ? compacted : legacy;
+}
+
+inline std::vector<std::string> const&
+DatabaseIndexStatements ( std::string const& profile, bool compact ) {
+  for ( auto const& p : DatabaseIndexProfiles ( compact ) ) {
+    if ( p . first == profile ) return p . second;
+  }
+  throw std::invalid_argument ( "Unknown index profile " + profile );
+}
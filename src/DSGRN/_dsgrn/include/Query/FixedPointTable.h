@@ -0,0 +1,91 @@
+/// FixedPointTable.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+struct FixedPointTable_ {
+  uint64_t D;     // D is the number of network nodes
+  // One row per FP annotation: Morse graph index, Morse graph vertex and
+  // the D coordinates of the fixed point (row-major in coordinates)
+  std::vector<uint64_t> morsegraphindices;
+  std::vector<uint64_t> vertices;
+  std::vector<uint32_t> coordinates;
+};
+
+class FixedPointTable {
+public:
+  /// FixedPointTable
+  ///   Parse the FP annotations among the rows (mgi, vertex, label) of the
+  ///   MorseGraphAnnotations table into an integer coordinate matrix.
+  ///   Labels which are not of the form "FP { x_0, ..., x_{D-1} }" are ignored.
+  FixedPointTable(uint64_t D,
+                  std::vector<uint64_t> const& morsegraphindices,
+                  std::vector<uint64_t> const& vertices,
+                  std::vector<std::string> const& labels);
+
+  /// rows
+  ///   Return the indices of the rows whose fixed point lies in the box
+  ///   bounds[d].first <= x_d <= bounds[d].second for all d
+  std::vector<uint64_t>
+  rows(std::vector<std::pair<uint64_t,uint64_t>> const& bounds) const;
+
+  /// matches
+  ///   Return the sorted list of Morse graph indices with a fixed point in the box
+  std::vector<uint64_t>
+  matches(std::vector<std::pair<uint64_t,uint64_t>> const& bounds) const;
+
+  /// size
+  ///   Return the number of FP annotations in the table
+  uint64_t
+  size(void) const;
+
+  /// dimension
+  ///   Return the number of coordinates of each fixed point
+  uint64_t
+  dimension(void) const;
+
+  /// morsegraphindex
+  ///   Return Morse graph index of a row
+  uint64_t
+  morsegraphindex(uint64_t row) const;
+
+  /// vertex
+  ///   Return Morse graph vertex of a row
+  uint64_t
+  vertex(uint64_t row) const;
+
+  /// coordinates
+  ///   Return the fixed point coordinates of a row
+  std::vector<uint64_t>
+  coordinates(uint64_t row) const;
+
+private:
+  FixedPointTable_ self;
+};
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+inline void
+FixedPointTableBinding (py::module &m) {
+  auto to_numpy = [](std::vector<uint64_t> const& v) {
+    return py::array_t<uint64_t>(v.size(), v.data());
+  };
+  py::class_<FixedPointTable, std::shared_ptr<FixedPointTable>>(m, "FixedPointTable")
+    .def(py::init<uint64_t, std::vector<uint64_t> const&, std::vector<uint64_t> const&, std::vector<std::string> const&>())
+    .def("rows", [=](FixedPointTable const& self, std::vector<std::pair<uint64_t,uint64_t>> const& bounds){ return to_numpy(self.rows(bounds)); })
+    .def("matches", [=](FixedPointTable const& self, std::vector<std::pair<uint64_t,uint64_t>> const& bounds){ return to_numpy(self.matches(bounds)); })
+    .def("size", &FixedPointTable::size)
+    .def("dimension", &FixedPointTable::dimension)
+    .def("morsegraphindex", &FixedPointTable::morsegraphindex)
+    .def("vertex", &FixedPointTable::vertex)
+    .def("coordinates", &FixedPointTable::coordinates);
+}
@@ -0,0 +1,98 @@
+/// FixedPointTable.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#include "FixedPointTable.h"
+
+inline FixedPointTable::
+FixedPointTable(uint64_t D,
+                std::vector<uint64_t> const& morsegraphindices,
+                std::vector<uint64_t> const& vertices,
+                std::vector<std::string> const& labels) {
+  if ( morsegraphindices.size() != labels.size() || vertices.size() != labels.size() ) {
+    throw std::invalid_argument("FixedPointTable: column lengths differ");
+  }
+  self.D = D;
+  std::vector<uint32_t> x(D);
+  for ( uint64_t i = 0; i < labels.size(); ++ i ) {
+    // Parse "FP { x_0, x_1, ..., x_{D-1} }"
+    std::string const& label = labels[i];
+    if ( label.compare(0, 2, "FP") != 0 ) continue;
+    uint64_t d = 0;
+    bool in_number = false;
+    for ( char c : label ) {
+      if ( std::isdigit(c) ) {
+        if ( not in_number ) {
+          if ( d == D ) { d = D + 1; break; }
+          x[d++] = 0;
+          in_number = true;
+        }
+        x[d-1] = 10 * x[d-1] + (c - '0');
+      } else {
+        in_number = false;
+      }
+    }
+    if ( d != D ) continue;
+    self.morsegraphindices.push_back(morsegraphindices[i]);
+    self.vertices.push_back(vertices[i]);
+    self.coordinates.insert(self.coordinates.end(), x.begin(), x.end());
+  }
+}
+
+inline std::vector<uint64_t> FixedPointTable::
+rows(std::vector<std::pair<uint64_t,uint64_t>> const& bounds) const {
+  if ( bounds.size() != self.D ) {
+    throw std::invalid_argument("FixedPointTable: expected one bound per network node");
+  }
+  // Unsigned wrap-around makes (x - lo) <= (hi - lo) equivalent to lo <= x <= hi
+  std::vector<uint64_t> lower(self.D), width(self.D);
+  for ( uint64_t d = 0; d < self.D; ++ d ) {
+    if ( bounds[d].second < bounds[d].first ) return std::vector<uint64_t>();
+    lower[d] = bounds[d].first;
+    width[d] = bounds[d].second - bounds[d].first;
+  }
+  std::vector<uint64_t> result;
+  uint64_t N = self.morsegraphindices.size();
+  uint32_t const* x = self.coordinates.data();
+  for ( uint64_t row = 0; row < N; ++ row, x += self.D ) {
+    bool inside = true;
+    for ( uint64_t d = 0; d < self.D; ++ d ) inside &= ( x[d] - lower[d] <= width[d] );
+    if ( inside ) result.push_back(row);
+  }
+  return result;
+}
+
+inline std::vector<uint64_t> FixedPointTable::
+matches(std::vector<std::pair<uint64_t,uint64_t>> const& bounds) const {
+  std::vector<uint64_t> result;
+  for ( auto row : rows(bounds) ) result.push_back(self.morsegraphindices[row]);
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+inline uint64_t FixedPointTable::
+size(void) const {
+  return self.morsegraphindices.size();
+}
+
+inline uint64_t FixedPointTable::
+dimension(void) const {
+  return self.D;
+}
+
+inline uint64_t FixedPointTable::
+morsegraphindex(uint64_t row) const {
+  return self.morsegraphindices[row];
+}
+
+inline uint64_t FixedPointTable::
+vertex(uint64_t row) const {
+  return self.vertices[row];
+}
+
+inline std::vector<uint64_t> FixedPointTable::
+coordinates(uint64_t row) const {
+  return std::vector<uint64_t>(self.coordinates.begin() + row * self.D, 
+                               self.coordinates.begin() + (row + 1) * self.D);
+}
@@ -0,0 +1,84 @@
+/// SingleGeneQuerySweep.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include "common.h"
+
+#include "Parameter/Network.h"
+#include "Query/NFA.h"
+#include "Query/ComputeSingleGeneQuery.h"
+
+struct SingleGeneQuerySweep_ {
+  // Morse graph index of each parameter index (i.e. the Signatures table)
+  std::shared_ptr<std::vector<uint64_t>> morsegraphindices;
+  // Label of each Morse graph index (e.g. 'Q', 'q', 'B', 'p', 'P', 'O')
+  std::shared_ptr<std::vector<char>> labels;
+  std::shared_ptr<ComputeSingleGeneQuery> query;
+};
+
+class SingleGeneQuerySweep {
+public:
+  /// SingleGeneQuerySweep
+  ///   Prepare single gene queries for "gene" where the parameter with index pi
+  ///   is labelled by labels[morsegraphindices[pi]]
+  SingleGeneQuerySweep(Network network, 
+                       std::string const& gene, 
+                       std::vector<uint64_t> const& morsegraphindices, 
+                       std::vector<char> const& labels);
+
+  /// operator ()
+  ///   For every reduced parameter index rpi, intersect the single gene query
+  ///   automaton of rpi (see ComputeSingleGeneQuery) with "pattern" and return
+  ///   result[rpi] = 1 if the intersection accepts some path, 0 otherwise.
+  ///   Reduced parameters are processed by "num_threads" threads (0 means one per core).
+  ///   Results are memoized by the string of labels of the gene parameters, since
+  ///   reduced parameters with the same labels have the same answer.
+  std::vector<uint8_t>
+  operator () (NFA const& pattern, uint64_t num_threads = 0) const;
+
+  /// match
+  ///   Return true if the single gene query automaton of reduced parameter
+  ///   index rpi matches "pattern" (no memoization)
+  bool
+  match(NFA const& pattern, uint64_t reduced_parameter_index) const;
+
+  /// labelstring
+  ///   Return the labels of the gene parameters of reduced parameter index rpi
+  std::string
+  labelstring(uint64_t reduced_parameter_index) const;
+
+  /// number_of_reduced_parameters
+  ///   Return number of reduced parameters (the length of the sweep result)
+  uint64_t
+  number_of_reduced_parameters(void) const;
+
+private:
+  SingleGeneQuerySweep_ self;
+};
+
+/// Python Bindings
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+inline void
+SingleGeneQuerySweepBinding (py::module &m) {
+  py::class_<SingleGeneQuerySweep, std::shared_ptr<SingleGeneQuerySweep>>(m, "SingleGeneQuerySweep")
+    .def(py::init<Network, std::string const&, std::vector<uint64_t> const&, std::vector<char> const&>())
+    .def("__call__", [](SingleGeneQuerySweep const& self, NFA const& pattern, uint64_t num_threads) {
+        std::vector<uint8_t> result;
+        {
+          py::gil_scoped_release release;
+          result = self(pattern, num_threads);
+        }
+        return py::array_t<bool>(result.size(), reinterpret_cast<bool const*>(result.data()));
+      }, py::arg("pattern"), py::arg("num_threads") = 0)
+    .def("match", &SingleGeneQuerySweep::match)
+    .def("labelstring", &SingleGeneQuerySweep::labelstring)
+    .def("number_of_reduced_parameters", &SingleGeneQuerySweep::number_of_reduced_parameters);
+}
@@ -0,0 +1,124 @@
+/// SingleGeneQuerySweep.hpp
+/// 2026-10-18
+/// MIT LICENSE
+
+#include "SingleGeneQuerySweep.h"
+
+namespace SingleGeneQuerySweep_detail_ {
+  /// ConcurrentMemo
+  ///   Hash map from label strings to results, split into independently
+  ///   locked shards so that threads rarely contend
+  class ConcurrentMemo {
+  public:
+    ConcurrentMemo ( uint64_t num_shards ) : shards_(num_shards) {}
+
+    /// find
+    ///   Return 0 or 1 if key is known, -1 otherwise
+    int
+    find ( std::string const& key ) {
+      Shard & shard = shards_[std::hash<std::string>()(key) % shards_.size()];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.map.find(key);
+      return ( it == shard.map.end() ) ? -1 : (int) it -> second;
+    }
+
+    /// insert
+    void
+    insert ( std::string const& key, bool value ) {
+      Shard & shard = shards_[std::hash<std::string>()(key) % shards_.size()];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.map.emplace(key, value);
+    }
+
+  private:
+    struct Shard {
+      std::mutex mutex;
+      std::unordered_map<std::string, bool> map;
+    };
+    std::vector<Shard> shards_;
+  };
+}
+
+inline SingleGeneQuerySweep::
+SingleGeneQuerySweep(Network network, 
+                     std::string const& gene, 
+                     std::vector<uint64_t> const& morsegraphindices, 
+                     std::vector<char> const& labels) {
+  self.morsegraphindices = std::make_shared<std::vector<uint64_t>>(morsegraphindices);
+  self.labels = std::make_shared<std::vector<char>>(labels);
+  auto mgis = self.morsegraphindices;
+  auto mgi_labels = self.labels;
+  self.query = std::make_shared<ComputeSingleGeneQuery>(network, gene, 
+    [mgis, mgi_labels](uint64_t pi) { return (*mgi_labels)[(*mgis)[pi]]; });
+}
+
+inline std::vector<uint8_t> SingleGeneQuerySweep::
+operator () (NFA const& pattern, uint64_t num_threads) const {
+  using namespace SingleGeneQuerySweep_detail_;
+  uint64_t N = number_of_reduced_parameters();
+  std::vector<uint8_t> result(N, 0);
+  if ( num_threads == 0 ) num_threads = std::max<uint64_t>(1, std::thread::hardware_concurrency());
+  ConcurrentMemo memo(64 * num_threads);
+  std::atomic<uint64_t> next(0);
+  uint64_t const chunk = 256;
+  auto worker = [&]() {
+    while ( true ) {
+      uint64_t begin = next.fetch_add(chunk);
+      if ( begin >= N ) break;
+      uint64_t end = std::min(N, begin + chunk);
+      for ( uint64_t rpi = begin; rpi < end; ++ rpi ) {
+        std::string key = labelstring(rpi);
+        int known = memo.find(key);
+        if ( known == -1 ) {
+          known = match(pattern, rpi) ? 1 : 0;
+          memo.insert(key, known);
+        }
+        result[rpi] = (uint8_t) known;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for ( uint64_t i = 1; i < num_threads; ++ i ) threads.emplace_back(worker);
+  worker();
+  for ( auto & thread : threads ) thread.join();
+  return result;
+}
+
+inline bool SingleGeneQuerySweep::
+match(NFA const& pattern, uint64_t reduced_parameter_index) const {
+  NFA nfa = NFA::intersect(pattern, (*self.query)(reduced_parameter_index)).first;
+  // Search for a path from initial to final vertex
+  std::vector<bool> visited(nfa.num_vertices(), false);
+  std::stack<uint64_t> work_stack;
+  work_stack.push(nfa.initial());
+  visited[nfa.initial()] = true;
+  while ( not work_stack.empty() ) {
+    uint64_t v = work_stack.top();
+    work_stack.pop();
+    if ( v == nfa.final() ) return true;
+    for ( auto const& label_children : nfa.adjacencies(v) ) {
+      for ( uint64_t u : label_children.second ) {
+        if ( visited[u] ) continue;
+        visited[u] = true;
+        work_stack.push(u);
+      }
+    }
+  }
+  return false;
+}
+
+inline std::string SingleGeneQuerySweep::
+labelstring(uint64_t reduced_parameter_index) const {
+  uint64_t n = self.query -> number_of_gene_parameters();
+  std::string result(n, ' ');
+  for ( uint64_t gpi = 0; gpi < n; ++ gpi ) {
+    uint64_t pi = self.query -> full_parameter_index(reduced_parameter_index, gpi);
+    result[gpi] = (*self.labels)[(*self.morsegraphindices)[pi]];
+  }
+  return result;
+}
+
+inline uint64_t SingleGeneQuerySweep::
+number_of_reduced_parameters(void) const {
+  return self.query -> number_of_reduced_parameters();
+}
@@ -0,0 +1,72 @@
+/// Philox.h
+/// 2026-10-18
+/// MIT LICENSE
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/// PhiloxStream
+///   Counter-based random number stream (Philox4x32-10, Salmon et al.,
+///   "Parallel random numbers: as easy as 1, 2, 3", SC 2011). The 64 bit
+///   key is the seed; the 128 bit counter is made of the index and stream
+///   numbers (e.g. a parameter index and a network node) and a 64 bit
+///   block number, whose high half is folded into the stream word by an
+///   odd multiplier: a stream never repeats, and its first 2^32 blocks
+///   use the stream number unchanged. Streams with different (seed,
+///   index, stream) are independent and each is a pure function of them,
+///   so results do not depend on which thread draws them or in what order
+///   the streams are used.
+class PhiloxStream {
+public:
+  PhiloxStream ( uint64_t seed, uint64_t index, uint32_t stream ) :
+    key_ ( { (uint32_t) seed, (uint32_t) ( seed >> 32 ) } ),
+    index_ ( index ), stream_ ( stream ), block_ ( 0 ), position_ ( 4 ) {}
+
+  /// next
+  ///   Return the next 32 random bits
+  uint32_t
+  next ( void ) {
+    if ( position_ == 4 ) {
+      uint32_t high = (uint32_t) ( block_ >> 32 );
+      output_ = generate ( { (uint32_t) block_, stream_ + high * 0x9E3779B9, (uint32_t) index_, (uint32_t) ( index_ >> 32 ) } );
+      ++ block_;
+      position_ = 0;
+    }
+    return output_ [ position_ ++ ];
+  }
+
+  /// operator ()
+  ///   Return a uniform double in [0,1) with 53 random bits
+  double
+  operator () ( void ) {
+    uint64_t a = next () >> 5;
+    uint64_t b = next () >> 6;
+    return ( a * 67108864.0 + b ) * ( 1.0 / 9007199254740992.0 );
+  }
+
+private:
+  typedef std::array<uint32_t,4> Block;
+
+  Block
+  generate ( Block counter ) const {
+    std::array<uint32_t,2> key = key_;
+    for ( int round = 0; round < 10; ++ round ) {
+      uint64_t p0 = (uint64_t) 0xD2511F53 * counter [ 0 ];
+      uint64_t p1 = (uint64_t) 0xCD9E8D57 * counter [ 2 ];
+      counter = { (uint32_t) ( p1 >> 32 ) ^ counter [ 1 ] ^ key [ 0 ], (uint32_t) p1,
+                  (uint32_t) ( p0 >> 32 ) ^ counter [ 3 ] ^ key [ 1 ], (uint32_t) p0 };
+      key [ 0 ] += 0x9E3779B9;
+      key [ 1 ] += 0xBB67AE85;
+    }
+    return counter;
+  }
+
+  std::array<uint32_t,2> key_;
+  uint64_t index_;
+  uint32_t stream_;
+  uint64_t block_;
+  uint32_t position_;
+  Block output_;
+};
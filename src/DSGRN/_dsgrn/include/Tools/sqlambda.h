@@ -34,13 +34,21 @@
 #include <functional>
 #include <stdexcept>
 #include <typeinfo>
+#include <tuple>
+#include <vector>
+#include <algorithm>
 #include "sqlite3.h"
 
 namespace sqlite {
 
+/// blob
+///   Binary column data (bound with sqlite3_bind_blob)
+typedef std::vector<unsigned char> blob;
+
 // Forward Declarations
 class database;
 class statement;
+template<typename... Args> class batch;
 class statement_wrapper;
 class database_wrapper;
 
@@ -74,6 +82,17 @@ public:
   void 
   exec ( std::string const& sql_expr ) const;
 
+  /// bulk_load [API]
+  ///   Configure the connection for bulk insertion:
+  ///     locking_mode = EXCLUSIVE, journal_mode = OFF
+  ///     (or WAL if "wal" is true), synchronous = OFF,
+  ///     a page cache of "cache_kib" KiB and in-memory
+  ///     temporary storage.
+  ///   Note: durability is traded for speed; a database
+  ///         interrupted mid-load should be rebuilt.
+  void
+  bulk_load ( bool wal = false, int64_t cache_kib = 1048576 ) const;
+
   /// sqlite3* cast [API]
   ///   Return underlying sqlite3* pointer
   ///   This is used to access the SQLite C API
@@ -178,6 +197,61 @@ private:
 
 	std::shared_ptr<statement_wrapper> stmt_;
 };
+/// class batch
+///   This class is used to insert many rows into a table
+///   using multi-row "insert ... values (?,?),(?,?),..."
+///   statements. Rows are buffered by "insert" and written
+///   "rows" at a time, which amortizes the cost of stepping
+///   a statement per row. Call "flush" after the last row.
+///   Example:
+///     batch<uint64_t,std::string> b ( db, "T", {"A", "B"} );
+///     b . insert ( 0, "x" ) . insert ( 1, "y" ) . flush ();
+template<typename... Args>
+class batch {
+public:
+  /// batch
+  ///   No default constructor: a batch is only usable
+  ///   once its insertion statement has been prepared
+  batch ( void ) = delete;
+
+  /// batch [API]
+  ///   Prepare a batched insertion into "table" with the
+  ///   given "columns" (one per template argument). The
+  ///   number of rows per statement is capped so the number
+  ///   of bound variables stays within the SQLite limit.
+  batch ( database const& db,
+          std::string const& table,
+          std::vector<std::string> const& columns,
+          int rows = 64 );
+
+  /// insert [API]
+  ///   Buffer a row, writing the buffer if it is full
+  batch& 
+  insert ( Args const&... args );
+
+  /// flush [API]
+  ///   Write all buffered rows
+  batch& 
+  flush ( void );
+
+private:
+	/// _statement [IMPLEMENTATION]
+	///   Prepare an insertion statement for "rows" rows
+	statement 
+	_statement ( int rows ) const;
+
+	/// _write [IMPLEMENTATION]
+	///   Bind the buffered rows to "stmt" and execute it
+	void 
+	_write ( statement & stmt );
+
+	database db_;
+	std::string head_;
+	std::string row_;
+	int rows_;
+	statement full_;
+	std::vector<std::tuple<Args...>> buffer_;
+};
 
 
 ////////////////////
@@ -278,6 +352,9 @@ SQL_COLUMN(std::string,char *,text);
 SQL_COLUMN(std::u16string,char16_t *,text16);
 SQL_COLUMN(double,double,double);
 SQL_COLUMN(float,float,double);
+template <> blob sqlite3_column<blob> ( sqlite3_stmt* stmt, int iCol ) {
+	unsigned char const* data = (unsigned char const*) sqlite3_column_blob (stmt, iCol);
+	return blob ( data, data + sqlite3_column_bytes (stmt, iCol) ); }
 
 template < class T >
 int sqlite3_bind(sqlite3_stmt* stmt_, int iCol, T const& t) {
@@ -299,6 +376,9 @@ SQL_BIND(uint64_t,(sqlite3_int64),int64);
 SQL_BIND(sqlite3_int64,,int64);
 SQL_BINDTEXT(std::string,text);
 SQL_BINDTEXT(std::u16string,text16);
+template <> int sqlite3_bind<blob> ( sqlite3_stmt* stmt_, int iCol, blob const& t ) {
+	if ( t . empty () ) return sqlite3_bind_zeroblob (stmt_, iCol, 0);
+	return sqlite3_bind_blob (stmt_, iCol, t.data(), (int) t.size(), SQLITE_TRANSIENT); }
 
 int sql_try(int rc) {
 	if (rc != SQLITE_OK && rc != SQLITE_ROW && rc != SQLITE_DONE ) {
@@ -378,6 +458,87 @@ _apply(std::function<void(Head, Tail...)> callback, int i) {
   _apply(partial, ++i);
 }
 
+/// _bind_tuple [IMPLEMENTATION]
+///   Bind the entries of a tuple to consecutive columns
+///   starting at iCol
+template < std::size_t I, typename Tuple >
+struct _bind_tuple {
+	static void bind ( sqlite3_stmt* stmt, int iCol, Tuple const& t ) {
+		_bind_tuple<I-1,Tuple>::bind ( stmt, iCol, t );
+		sql_try(sqlite3_bind( stmt, iCol + (int) I - 1, std::get<I-1>(t)));
+	}
+};
+
+template < typename Tuple >
+struct _bind_tuple<0,Tuple> {
+	static void bind ( sqlite3_stmt*, int, Tuple const& ) {}
+};
+
+template<typename... Args> batch<Args...>::
+batch ( database const& db,
+        std::string const& table,
+        std::vector<std::string> const& columns,
+        int rows ) : db_ ( db ) {
+	if ( columns . size () != sizeof...(Args) ) {
+		throw sqlite_exception ( "batch: number of columns does not match row type\n" );
+	}
+	head_ = "insert into " + table + " (";
+	row_ = "(";
+	for ( std::size_t i = 0; i < columns . size (); ++ i ) {
+		if ( i > 0 ) { head_ += ", "; row_ += ", "; }
+		head_ += columns [ i ];
+		row_ += "?";
+	}
+	head_ += ") values ";
+	row_ += ")";
+	int max_vars = sqlite3_limit ( db_, SQLITE_LIMIT_VARIABLE_NUMBER, -1 );
+	rows_ = std::max ( 1, std::min ( rows, max_vars / (int) sizeof...(Args) ) );
+	full_ = _statement ( rows_ );
+	buffer_ . reserve ( rows_ );
+}
+
+template<typename... Args> batch<Args...>& batch<Args...>::
+insert ( Args const&... args ) {
+	buffer_ . emplace_back ( args... );
+	if ( buffer_ . size () == (std::size_t) rows_ ) _write ( full_ );
+	return *this;
+}
+
+template<typename... Args> batch<Args...>& batch<Args...>::
+flush ( void ) {
+	if ( buffer_ . empty () ) return *this;
+	if ( buffer_ . size () == (std::size_t) rows_ ) {
+		_write ( full_ );
+	} else {
+		statement partial = _statement ( (int) buffer_ . size () );
+		_write ( partial );
+	}
+	return *this;
+}
+
+template<typename... Args> statement batch<Args...>::
+_statement ( int rows ) const {
+	std::string sql_expr = head_;
+	for ( int r = 0; r < rows; ++ r ) {
+		if ( r > 0 ) sql_expr += ", ";
+		sql_expr += row_;
+	}
+	return db_ . prepare ( sql_expr + ";" );
+}
+
+template<typename... Args> void batch<Args...>::
+_write ( statement & stmt ) {
+	typedef std::tuple<Args...> Row;
+	sql_try(sqlite3_reset(stmt));
+	int iCol = 1;
+	for ( Row const& row : buffer_ ) {
+		_bind_tuple<sizeof...(Args),Row>::bind ( stmt, iCol, row );
+		iCol += sizeof...(Args);
+	}
+	sql_try(sqlite3_step(stmt));
+	buffer_ . clear ();
+}
+
 inline database::
 database ( std::string const & db_name )
 	: db_ ( new database_wrapper(db_name) ) {}
@@ -406,6 +567,15 @@ exec ( std::string const& sql_expr ) const {
 	prepare(sql_expr).exec();
 }
 
+inline void database::
+bulk_load ( bool wal, int64_t cache_kib ) const {
+	exec ( "pragma locking_mode = EXCLUSIVE;" );
+	exec ( wal ? "pragma journal_mode = WAL;" : "pragma journal_mode = OFF;" );
+	exec ( "pragma synchronous = OFF;" );
+	exec ( "pragma cache_size = -" + std::to_string ( cache_kib ) + ";" );
+	exec ( "pragma temp_store = MEMORY;" );
+}
+
 inline database::
 operator sqlite3* () const {
 	return  *db_;
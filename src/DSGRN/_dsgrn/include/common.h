@@ -23,6 +23,9 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <regex>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 class TypedObject {
 public:
@@ -0,0 +1,108 @@
+/// TestCADTable.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "DSGRN.h"
+
+#include <cstring>
+#include <dirent.h>
+#include <stdlib.h>
+
+std::string const resources = "../src/DSGRN/Resources/CAD";
+
+/// Copy
+///   Copy a file, applying edit to its bytes
+void Copy ( std::string const& source, std::string const& target,
+            std::function<void(std::string &)> const& edit = [](std::string &){} ) {
+  std::ifstream infile ( source, std::ios::binary );
+  std::stringstream ss;
+  ss << infile . rdbuf ();
+  std::string bytes = ss . str ();
+  edit ( bytes );
+  std::ofstream outfile ( target, std::ios::binary );
+  outfile . write ( bytes . data (), bytes . size () );
+  outfile . close ();
+  if ( not infile . good () || outfile . fail () ) throw std::runtime_error ( "Could not copy " + source + " to " + target );
+}
+
+/// CheckEqual
+///   Throw unless the two tables hold the same rows, bit for bit
+void CheckEqual ( CADTable const& table, CADTable const& reference, std::string const& what ) {
+  if ( table . inputs () != reference . inputs () || table . outputs () != reference . outputs () ||
+       table . size () != reference . size () || table . columns () != reference . columns () ) {
+    throw std::logic_error ( what + " does not have the shape of its JSON database" );
+  }
+  for ( uint64_t i = 0; i < reference . size (); ++ i ) {
+    if ( table . hex ( i ) != reference . hex ( i ) || table . index ( reference . hex ( i ) ) != i ||
+         std::memcmp ( table . instance ( i ), reference . instance ( i ), reference . columns () * sizeof ( double ) ) != 0 ) {
+      throw std::logic_error ( what + " differs from its JSON database at row " + std::to_string ( i ) );
+    }
+  }
+}
+
+int main ( int argc, char * argv [] ) {
+  try {
+    char dirname [] = "/tmp/TestCADTableXXXXXX";
+    if ( mkdtemp ( dirname ) == nullptr ) throw std::runtime_error ( "Could not make a temporary directory" );
+    std::string tmp ( dirname );
+    for ( std::string sub : { "/json", "/cad", "/version", "/byte_order", "/truncated" } ) {
+      if ( mkdir ( ( tmp + sub ) . c_str (), 0700 ) != 0 ) throw std::runtime_error ( "Could not make " + tmp + sub );
+    }
+    std::vector<std::string> names;
+    DIR * dir = opendir ( resources . c_str () );
+    if ( dir == nullptr ) throw std::runtime_error ( "Missing " + resources );
+    while ( dirent * entry = readdir ( dir ) ) {
+      std::string filename ( entry -> d_name );
+      if ( filename . size () > 5 && filename . substr ( filename . size () - 5 ) == ".json" ) {
+        names . push_back ( filename . substr ( 0, filename . size () - 5 ) );
+      }
+    }
+    closedir ( dir );
+    if ( names . empty () ) throw std::logic_error ( "No CAD databases in " + resources );
+    for ( std::string const& name : names ) {
+      // The JSON database alone, so it cannot be read from a binary file
+      Copy ( resources + "/" + name + ".json", tmp + "/json/" + name + ".json" );
+      CADTable reference ( tmp + "/json/" + name );
+      if ( reference . size () == 0 ) throw std::logic_error ( "Empty CAD database " + name );
+      // A compiled binary file reads back as its JSON database
+      CADTable::compile ( resources + "/" + name + ".json", tmp + "/cad/" + name + ".cad" );
+      CheckEqual ( CADTable ( tmp + "/cad/" + name ), reference, "Compiled table " + name );
+      // and so does the binary file built with the package, if there is one
+      std::ifstream built ( resources + "/" + name + ".cad" );
+      if ( built . good () ) CheckEqual ( CADTable ( resources + "/" + name ), reference, "Built table " + name );
+    }
+    // A binary file of another version or byte order, or a truncated one,
+    // is ignored in favor of the JSON database. The first value of each is
+    // changed so that reading it would be noticed.
+    std::string name = names [ 0 ];
+    CADTable reference ( tmp + "/json/" + name );
+    auto perturb = [&]( uint64_t offset, char byte ) {
+      return [=]( std::string & bytes ) {
+        bytes [ offset ] ^= byte;
+        bytes [ 48 + 7 ] ^= 0x40;
+      };
+    };
+    Copy ( tmp + "/cad/" + name + ".cad", tmp + "/version/" + name + ".cad", perturb ( 8, 0x7 ) );
+    Copy ( tmp + "/cad/" + name + ".cad", tmp + "/byte_order/" + name + ".cad", perturb ( 12, 0x5 ) );
+    Copy ( tmp + "/cad/" + name + ".cad", tmp + "/truncated/" + name + ".cad", [&]( std::string & bytes ) {
+      bytes [ 48 + 7 ] ^= 0x40;
+      bytes . pop_back ();
+    } );
+    for ( std::string sub : { "/version/", "/byte_order/", "/truncated/" } ) {
+      Copy ( resources + "/" + name + ".json", tmp + sub + name + ".json" );
+      CheckEqual ( CADTable ( tmp + sub + name ), reference, "Table of unusable binary file " + sub );
+    }
+    // The perturbation is visible when the header is valid
+    Copy ( tmp + "/cad/" + name + ".cad", tmp + "/cad/perturbed.cad", perturb ( 0, 0 ) );
+    if ( CADTable ( tmp + "/cad/perturbed" ) . instance ( 0 ) [ 0 ] == reference . instance ( 0 ) [ 0 ] ) {
+      throw std::logic_error ( "Perturbing the binary file does not change its first value" );
+    }
+    system ( ( "rm -rf " + tmp ) . c_str () );
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}
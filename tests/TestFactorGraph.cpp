@@ -0,0 +1,103 @@
+/// TestFactorGraph.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "DSGRN.h"
+
+#include <set>
+
+/// Reference
+///   The maps connected to "start", found by a search over
+///   MonotonicMap::neighbors
+std::set<std::vector<int64_t>> Reference ( MonotonicMap const& start ) {
+  std::set<std::vector<int64_t>> result = { start . bin_ };
+  std::vector<MonotonicMap> stack = { start };
+  while ( not stack . empty () ) {
+    MonotonicMap map = stack . back ();
+    stack . pop_back ();
+    for ( auto const& neighbor : map . neighbors () ) {
+      if ( result . insert ( neighbor -> bin_ ) . second ) stack . push_back ( *neighbor );
+    }
+  }
+  return result;
+}
+
+/// CheckGraph
+///   Throw unless the factor graph of "start" has the vertices of the
+///   reference search and the adjacencies of MonotonicMap::neighbors
+void CheckGraph ( MonotonicMap const& start, int64_t num_threads, bool wide_keys, std::string const& what ) {
+  FactorGraph graph ( wide_keys );
+  graph . construct ( start, num_threads );
+  std::set<std::vector<int64_t>> reference = Reference ( start );
+  std::map<std::vector<int64_t>, int64_t> vertices;
+  for ( int64_t v = 0; v < (int64_t) graph . size (); ++ v ) {
+    vertices [ graph . vertex ( v ) . bin_ ] = v;
+  }
+  if ( vertices . size () != graph . size () ) throw std::logic_error ( what + ": repeated vertices" );
+  if ( graph . size () != reference . size () ||
+       not std::equal ( reference . begin (), reference . end (), vertices . begin (),
+                        [] ( std::vector<int64_t> const& a, std::pair<std::vector<int64_t> const, int64_t> const& b ) { return a == b . first; } ) ) {
+    throw std::logic_error ( what + ": vertices differ from the search over neighbors" );
+  }
+  for ( int64_t v = 0; v < (int64_t) graph . size (); ++ v ) {
+    std::set<int64_t> expected;
+    for ( auto const& neighbor : graph . vertex ( v ) . neighbors () ) expected . insert ( vertices [ neighbor -> bin_ ] );
+    std::vector<int64_t> const& adjacent = graph . adjacencies ( v );
+    if ( std::set<int64_t> ( adjacent . begin (), adjacent . end () ) != expected || adjacent . size () != expected . size () ) {
+      throw std::logic_error ( what + ": adjacencies differ from neighbors at vertex " + std::to_string ( v ) );
+    }
+  }
+}
+
+int main ( int argc, char * argv [] ) {
+  try {
+    // Packed keys of one and of several words round trip, and list the
+    // same adjacent maps
+    for ( int64_t n : { 2, 6, 7 } ) {
+      for ( int64_t m : { 1, 2, 5 } ) {
+        MonotonicMap map ( n, m );
+        for ( int64_t i = 0; i < (1 << n); ++ i ) map . bin_ [ i ] = ( i * 7 + n ) % ( m + 1 );
+        MonotonicMap copy ( n, m );
+        copy . assign_key ( map . wide_key () );
+        if ( copy . bin_ != map . bin_ ) throw std::logic_error ( "wide_key does not round trip" );
+        if ( map . packable () != ( map . key_size () == 1 ) ) throw std::logic_error ( "packable disagrees with key_size" );
+        std::vector<int64_t> changed, wide_changed;
+        auto wide = map . adjacent_wide_keys ( &wide_changed );
+        if ( map . packable () ) {
+          copy . assign_key ( map . key () );
+          if ( copy . bin_ != map . bin_ ) throw std::logic_error ( "key does not round trip" );
+          auto keys = map . adjacent_keys ( &changed );
+          if ( keys . size () != wide . size () || changed != wide_changed ) throw std::logic_error ( "adjacent keys differ" );
+          for ( uint64_t k = 0; k < keys . size (); ++ k ) {
+            if ( wide [ k ] != MonotonicMap::WideKey ( 1, keys [ k ] ) ) throw std::logic_error ( "adjacent keys differ" );
+          }
+        }
+        for ( uint64_t k = 0; k < wide . size (); ++ k ) {
+          copy . assign_key ( wide [ k ] );
+          int64_t i = wide_changed [ k ];
+          for ( int64_t j = 0; j < (1 << n); ++ j ) {
+            if ( ( j == i ) != ( copy . bin_ [ j ] != map . bin_ [ j ] ) || std::abs ( copy . bin_ [ i ] - map . bin_ [ i ] ) != 1 ) {
+              throw std::logic_error ( "adjacent wide key does not change one value by one" );
+            }
+          }
+        }
+      }
+    }
+    // Graphs over packed keys of one word, and of several words (the
+    // maps which need several words have graphs too large to search here,
+    // so keys of several words are also checked on packable maps)
+    for ( bool wide_keys : { false, true } ) {
+      std::string what = wide_keys ? " over wide keys" : "";
+      CheckGraph ( MonotonicMap ( 2, 5, { 1, 1 } ), 1, wide_keys, "ab, 5 outputs" + what );
+      CheckGraph ( MonotonicMap ( 3, 3, { 3 } ), 1, wide_keys, "(a+b+c), 3 outputs" + what );
+      CheckGraph ( MonotonicMap ( 3, 2, { 2, 1 } ), 2, wide_keys, "(a+b)c, 2 outputs" + what );
+      CheckGraph ( MonotonicMap ( 4, 2, { 1, 1, 1, 1 } ), 4, wide_keys, "abcd, 2 outputs" + what );
+    }
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}
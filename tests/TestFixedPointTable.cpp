@@ -0,0 +1,115 @@
+/// TestFixedPointTable.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "DSGRN.h"
+#include "Tools/sqlambda.h"
+
+using namespace sqlite;
+
+/// like_matches
+///   The Morse graph indices with a fixed point in the box, found with
+///   the SQL "like" patterns the Python queries used before FixedPointTable
+std::vector<uint64_t>
+like_matches ( database const& db, std::vector<std::pair<uint64_t,uint64_t>> const& box ) {
+  uint64_t D = box . size ();
+  std::string sql = "select distinct MorseGraphIndex from MorseGraphAnnotations where 1";
+  for ( uint64_t i = 0; i < D; ++ i ) {
+    std::vector<std::string> terms;
+    for ( uint64_t j = box [ i ] . first; j <= box [ i ] . second; ++ j ) {
+      std::string pattern = "FP { ";
+      for ( uint64_t k = 0; k < D; ++ k ) {
+        if ( k > 0 ) pattern += ", ";
+        pattern += ( k == i ) ? std::to_string ( j ) : "_";
+      }
+      terms . push_back ( "Label like '" + pattern + "%'" );
+    }
+    sql += " and (";
+    for ( uint64_t t = 0; t < terms . size (); ++ t ) sql += ( t > 0 ? " or " : "" ) + terms [ t ];
+    sql += ( terms . empty () ? "0)" : ")" );
+  }
+  sql += " order by MorseGraphIndex;";
+  std::vector<uint64_t> result;
+  db . prepare ( sql ) . forEach ( [&](uint64_t mgi){ result . push_back ( mgi ); } );
+  return result;
+}
+
+int main ( int argc, char * argv [] ) {
+  try {
+    // Parsing: only labels "FP { x_0, ..., x_{D-1} }" are kept
+    FixedPointTable parsed ( 2, { 0, 1, 2, 3, 4, 5 }, { 0, 1, 0, 2, 1, 0 },
+      { "FP { 1, 12 }", "FC", "XC { 1, * }", "FP { 3 }", "FP { 0, 1, 2 }", "FP { 2, 0 }" } );
+    if ( parsed . size () != 2 || parsed . dimension () != 2 ) throw std::logic_error ( "FixedPointTable parsed the wrong labels" );
+    if ( parsed . morsegraphindex ( 0 ) != 0 || parsed . vertex ( 0 ) != 0 ||
+         parsed . coordinates ( 0 ) != std::vector<uint64_t> ( { 1, 12 } ) ) throw std::logic_error ( "FixedPointTable misparsed FP { 1, 12 }" );
+    if ( parsed . morsegraphindex ( 1 ) != 5 || parsed . coordinates ( 1 ) != std::vector<uint64_t> ( { 2, 0 } ) ) {
+      throw std::logic_error ( "FixedPointTable misparsed FP { 2, 0 }" );
+    }
+    // Box bounds are inclusive, and empty when a lower bound exceeds its upper bound
+    if ( parsed . rows ( { { 1, 1 }, { 12, 12 } } ) != std::vector<uint64_t> ( { 0 } ) ) throw std::logic_error ( "FixedPointTable misses a fixed point on the box boundary" );
+    if ( parsed . matches ( { { 0, 2 }, { 0, 11 } } ) != std::vector<uint64_t> ( { 5 } ) ) throw std::logic_error ( "FixedPointTable matches outside the box" );
+    if ( not parsed . rows ( { { 2, 1 }, { 0, 20 } } ) . empty () ) throw std::logic_error ( "FixedPointTable matches an empty box" );
+    bool thrown = false;
+    try { parsed . rows ( { { 0, 1 } } ); } catch ( std::invalid_argument const& ) { thrown = true; }
+    if ( not thrown ) throw std::logic_error ( "FixedPointTable accepts a box of the wrong dimension" );
+
+    // The matches agree with the SQL "like" query on the Morse graphs of a network
+    configuration () -> set_path ( "../src/DSGRN/Resources" );
+    Network network ( "X : (X)(~Z) \n"
+                      "Y : X + Y \n"
+                      "Z : X + Y \n" );
+    ParameterGraph pg ( network );
+    uint64_t D = network . size ();
+    database db ( ":memory:" );
+    db . exec ( "create table MorseGraphAnnotations (MorseGraphIndex INTEGER, Vertex INTEGER, Label TEXT);" );
+    std::vector<uint64_t> morsegraphindices, vertices;
+    std::vector<std::string> labels;
+    std::unordered_map<std::string, uint64_t> lookup;
+    {
+      batch<uint64_t, uint64_t, std::string> insert ( db, "MorseGraphAnnotations", { "MorseGraphIndex", "Vertex", "Label" } );
+      for ( uint64_t pi = 0; pi < pg . size (); ++ pi ) {
+        MorseGraph mg ( DomainGraph ( pg . parameter ( pi ) ) );
+        std::string gv = mg . graphviz ();
+        if ( lookup . count ( gv ) ) continue;
+        uint64_t mgi = lookup . size ();
+        lookup [ gv ] = mgi;
+        for ( uint64_t v = 0; v < mg . poset () . size (); ++ v ) {
+          for ( std::string const& label : mg . annotation ( v ) ) {
+            insert . insert ( mgi, v, label );
+            morsegraphindices . push_back ( mgi );
+            vertices . push_back ( v );
+            labels . push_back ( label );
+          }
+        }
+      }
+      insert . flush ();
+    }
+    FixedPointTable table ( D, morsegraphindices, vertices, labels );
+    uint64_t fixed_points = 0;
+    for ( std::string const& label : labels ) fixed_points += ( label . compare ( 0, 2, "FP" ) == 0 );
+    if ( table . size () != fixed_points || fixed_points == 0 ) throw std::logic_error ( "FixedPointTable dropped a fixed point" );
+    // Every box of coordinates between 0 and the number of outputs
+    std::vector<uint64_t> limit ( D );
+    for ( uint64_t d = 0; d < D; ++ d ) limit [ d ] = network . outputs ( d ) . size ();
+    std::vector<std::pair<uint64_t,uint64_t>> box ( D, { 0, 0 } );
+    uint64_t boxes = 0;
+    while ( true ) {
+      if ( table . matches ( box ) != like_matches ( db, box ) ) throw std::logic_error ( "FixedPointTable disagrees with the SQL like query" );
+      ++ boxes;
+      uint64_t d = 0;
+      for ( ; d < D; ++ d ) {
+        if ( box [ d ] . second < limit [ d ] ) { ++ box [ d ] . second; break; }
+        if ( box [ d ] . first < limit [ d ] ) { ++ box [ d ] . first; box [ d ] . second = box [ d ] . first; break; }
+        box [ d ] = { 0, 0 };
+      }
+      if ( d == D ) break;
+    }
+    std::cout << boxes << " boxes and " << fixed_points << " fixed points checked\n";
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}
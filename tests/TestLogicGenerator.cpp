@@ -0,0 +1,111 @@
+/// TestLogicGenerator.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "DSGRN.h"
+
+#include <stdlib.h>
+
+std::string const resources = "../src/DSGRN/Resources";
+
+/// Contents
+///   Return the bytes of a file
+std::string Contents ( std::string const& filename ) {
+  std::ifstream infile ( filename, std::ios::binary );
+  if ( not infile . good () ) throw std::runtime_error ( "Missing file " + filename );
+  std::stringstream ss;
+  ss << infile . rdbuf ();
+  return ss . str ();
+}
+
+/// Lines
+///   Return the codes as the lines of a logic resource
+std::string Lines ( std::vector<std::string> const& codes ) {
+  std::string result;
+  for ( auto const& code : codes ) result += code + "\n";
+  return result;
+}
+
+int main ( int argc, char * argv [] ) {
+  try {
+    char dirname [] = "/tmp/TestLogicGeneratorXXXXXX";
+    if ( mkdtemp ( dirname ) == nullptr ) throw std::runtime_error ( "Could not make a temporary directory" );
+    std::string tmp ( dirname );
+    // Generated resources are those shipped, byte for byte, as are the
+    // files they are saved to
+    for ( auto const& type : std::vector<std::pair<uint64_t,std::vector<uint64_t>>> { { 1, { 3 } }, { 2, { 1, 1 } }, { 2, { 2 } } } ) {
+      uint64_t m = type . first;
+      std::vector<uint64_t> const& logic = type . second;
+      uint64_t n = std::accumulate ( logic . begin (), logic . end (), (uint64_t) 0 );
+      LogicGenerator generator ( n, m, logic );
+      generator . generate ( 2 );
+      generator . save ( tmp + "/generated" );
+      for ( bool essential : { false, true } ) {
+        std::string name = generator . name ( essential );
+        std::string shipped = Contents ( resources + "/logic/" + name + ".dat" );
+        if ( Lines ( generator . codes ( essential ) ) != shipped ) throw std::logic_error ( "Generated " + name + " differs from the shipped resource" );
+        if ( Contents ( tmp + "/generated/" + name + ".dat" ) != shipped ) throw std::logic_error ( "Saved " + name + " differs from the shipped resource" );
+      }
+      // The estimate is a lower estimate, but not far off for small types
+      double estimate = generator . estimate ( 20000 );
+      double size = generator . codes () . size ();
+      if ( estimate > size || estimate < 0.5 * size ) {
+        throw std::logic_error ( "Estimate " + std::to_string ( estimate ) + " of " + generator . name () + " is far from " + std::to_string ( size ) );
+      }
+    }
+    // Parameter graphs over the shipped resources, for reference
+    configuration () -> set_path ( resources );
+    Network network ( "X : (X)(~Z) \n"
+                      "Y : X + Y \n"
+                      "Z : X + Y \n" );
+    Network other ( "X : X + Y + Z \n"
+                    "Y : ~X \n"
+                    "Z : Y \n" );
+    uint64_t network_size = ParameterGraph ( network ) . size ();
+    uint64_t other_size = ParameterGraph ( other ) . size ();
+    // Nothing is shipped from here on
+    configuration () -> set_path ( tmp + "/empty" );
+    configuration () -> set_cache_path ( tmp + "/cache" );
+    std::vector<std::string> missing = LogicGenerator::missing ( network );
+    std::sort ( missing . begin (), missing . end () );
+    if ( missing != std::vector<std::string> { "2_1_2", "2_2_2", "2_3_1_1" } ) throw std::logic_error ( "missing does not list the resources to generate" );
+    // Generation is off by default: the resources are not generated, and
+    // the error gives their size
+    if ( configuration () -> get_generate_logic () ) throw std::logic_error ( "Generation of logic resources is on by default" );
+    for ( Network const& net : { network, other } ) {
+      try {
+        ParameterGraph pg ( net );
+        throw std::logic_error ( "ParameterGraph generated a logic resource without being allowed to" );
+      } catch ( std::runtime_error const& e ) {
+        if ( std::string ( e . what () ) . find ( "estimated" ) == std::string::npos ) throw std::logic_error ( std::string ( "Unexpected error: " ) + e . what () );
+      }
+    }
+    if ( LogicGenerator::missing ( network ) . size () != 3 ) throw std::logic_error ( "A resource was cached without being generated" );
+    // Cached resources are read, with generation off
+    LogicGeneratorDetail::make_directories ( tmp + "/cache/logic" );
+    for ( std::string name : missing ) {
+      std::ofstream ( tmp + "/cache/logic/" + name + ".dat" ) << Contents ( resources + "/logic/" + name + ".dat" );
+    }
+    if ( not LogicGenerator::missing ( network ) . empty () ) throw std::logic_error ( "missing lists cached resources" );
+    if ( ParameterGraph ( network ) . size () != network_size ) throw std::logic_error ( "Cached resources give another parameter graph" );
+    // With generation on, missing resources are generated and cached
+    configuration () -> set_generate_logic ( true );
+    missing = LogicGenerator::missing ( other );
+    if ( missing . size () != 3 ) throw std::logic_error ( "missing does not list the resources to generate" );
+    if ( ParameterGraph ( other ) . size () != other_size ) throw std::logic_error ( "Generated resources give another parameter graph" );
+    for ( std::string const& name : missing ) {
+      if ( Contents ( tmp + "/cache/logic/" + name + ".dat" ) != Contents ( resources + "/logic/" + name + ".dat" ) ) {
+        throw std::logic_error ( "Cached " + name + " differs from the shipped resource" );
+      }
+    }
+    if ( not LogicGenerator::missing ( other ) . empty () ) throw std::logic_error ( "missing lists generated resources" );
+    configuration () -> set_generate_logic ( false );
+    if ( system ( ( "rm -rf " + tmp ) . c_str () ) != 0 ) throw std::runtime_error ( "Could not remove " + tmp );
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,204 @@
+/// TestMonotonicMap.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "DSGRN.h"
+
+#include <random>
+
+typedef std::vector<std::pair<int64_t,std::pair<int64_t,int64_t>>> Constraints;
+
+/// ScalarMonotonic
+///   The map-at-a-time monotonicity check, kept as the reference for
+///   the bit-parallel check MonotonicMap uses for n <= 6
+bool ScalarMonotonic ( MonotonicMap const& map ) {
+  std::vector<int64_t> const& bin_ = map . bin_;
+  int64_t N = (1 << map . n);
+  for ( int64_t i = 0; i < N; ++ i ) {
+    for ( int64_t pos = 0; pos < map . n; ++ pos ) {
+      int64_t bit = 1 << pos;
+      if ( not ( i & bit ) && bin_[i|bit] < bin_[i] ) return false;
+    }
+  }
+  return true;
+}
+
+/// ScalarRealizable
+///   The map-at-a-time realizability check, kept as the reference for
+///   the bit-parallel check MonotonicMap uses for n <= 6
+bool ScalarRealizable ( MonotonicMap const& map ) {
+  std::vector<int64_t> const& bin_ = map . bin_;
+  std::vector<int64_t> const& logic_ = map . logic_;
+  int64_t n = map . n;
+  int64_t N = (1 << n);
+  // Step 1. Check constraints
+  for ( int64_t a = 0; a < N; ++ a ) {
+    for ( int64_t b = 0; b < N; ++ b ) {
+      for ( auto const& constraint : map . constraints_ ) {
+        int64_t const& mask = constraint . first;
+        int64_t const& x = constraint . second . first;
+        int64_t const& y = constraint . second . second;
+        if ( ((a & ~mask) == (b & ~mask)) && ( (a & mask) == x ) && ( (b & mask) == y ) ) {
+          if ( bin_[a] > bin_[b] ) return false;
+        }
+      }
+    }
+  }
+  // Step 2. Other realizability conditions
+  int64_t max_terms_in_factor = 0;
+  for ( int64_t k : logic_ ) max_terms_in_factor = std::max ( max_terms_in_factor, k );
+  if ( (logic_ . size () == 1) || (max_terms_in_factor == 1) ) {
+    for ( int64_t i = 0; i < N; ++ i ) {
+      for ( int64_t a = 0; a < N; ++ a ) {
+        if ( (a & i) != a ) continue;
+        for ( int64_t b = 0; b < N; ++ b ) {
+          if ( (b & i) != b ) continue;
+          bool less = false;
+          bool greater = false;
+          for ( int64_t c = 0; c < N; ++ c ) {
+            if ( (c & i ) != 0 ) continue;
+            if ( bin_[a|c] < bin_[b|c] ) less = true;
+            if ( bin_[a|c] > bin_[b|c] ) greater = true;
+            if ( less && greater ) return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+  if ( logic_ == std::vector<int64_t> { 2, 1 } ) {
+    if ( (bin_[2] < bin_[4]) && not (bin_[3] <= bin_[5]) ) return false;
+    if ( (bin_[1] < bin_[4]) && not (bin_[3] <= bin_[6]) ) return false;
+    if ( (bin_[2] > bin_[1]) && not (bin_[6] >= bin_[5]) ) return false;
+    if ( (bin_[2] < bin_[1]) && not (bin_[6] <= bin_[5]) ) return false;
+    return true;
+  }
+  if ( logic_ == std::vector<int64_t> { 1, 2 } ) {
+    if ( (bin_[4] < bin_[1]) && not (bin_[6] <= bin_[3]) ) return false;
+    if ( (bin_[2] < bin_[1]) && not (bin_[6] <= bin_[5]) ) return false;
+    if ( (bin_[4] > bin_[2]) && not (bin_[5] >= bin_[3]) ) return false;
+    if ( (bin_[4] < bin_[2]) && not (bin_[5] <= bin_[3]) ) return false;
+    return true;
+  }
+  // Case (2,2). Slice Conditions.
+  for ( int64_t slice : { 0b1100, 0b0011, 0b1011, 0b0111, 0b1101, 0b1110 } ) {
+    for ( int64_t x = 0; x < 16; ++ x ) {
+      for ( int64_t v = 0; v < 16; ++ v ) {
+        int64_t y = (x & slice) | (v & ~slice);
+        int64_t u = (x & ~slice) | (v & slice);
+        if ( bin_[x] < bin_[y] && !(bin_[u] <= bin_[v]) ) return false;
+      }
+    }
+  }
+  // Promotion Condition.
+  for ( int64_t x = 0; x < 16; ++ x ) {
+    for ( int64_t y = 0; y < 16; ++ y ) {
+      if ( bin_[x] >= bin_[y] ) continue;
+      for ( int64_t slice : { 0b1100, 0b0011 } ) {
+        bool condition_met = false;
+        for ( int64_t z = 0; z < 16; ++ z ) {
+          if ( bin_ [ (x & slice) | (z & ~slice) ] > bin_ [ (y & slice) | (z & ~slice) ] ) {
+            condition_met = true;
+            break;
+          }
+        }
+        if ( not condition_met ) continue;
+        for ( int i = 0; i < 4; ++ i ) {
+          int64_t bit = 1 << i;
+          if ( not (slice & bit) ) continue;
+          if ( (x & bit) | (y & bit) ) continue;
+          if ( bin_[x|bit] > bin_[y|bit] ) return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/// CheckMap
+///   Compare the checks on map against the scalar references; map differs
+///   from previous (which is monotonic and realizable as flagged) at most
+///   in bin_[i]. Return whether map is monotonic and realizable.
+bool CheckMap ( MonotonicMap const& map, int64_t i,
+                    bool previous_monotonic, bool previous_realizable ) {
+  bool monotonic = ScalarMonotonic ( map );
+  if ( map . monotonic () != monotonic ) throw std::logic_error ( "monotonic disagrees with the scalar check on " + map . hex () );
+  if ( previous_monotonic && map . monotonic_at ( i ) != monotonic ) {
+    throw std::logic_error ( "monotonic_at disagrees with the scalar check on " + map . hex () );
+  }
+  bool realizable = ScalarRealizable ( map );
+  if ( map . realizable () != realizable ) throw std::logic_error ( "realizable disagrees with the scalar check on " + map . hex () );
+  if ( previous_realizable && map . realizable_at ( i ) != realizable ) {
+    throw std::logic_error ( "realizable_at disagrees with the scalar check on " + map . hex () );
+  }
+  return monotonic && realizable;
+}
+
+int main ( int argc, char * argv [] ) {
+  try {
+    std::mt19937_64 engine ( 13 );
+    for ( int64_t n = 1; n <= 6; ++ n ) {
+      std::vector<std::vector<int64_t>> logics = { { n }, std::vector<int64_t> ( n, 1 ) };
+      if ( n == 3 ) { logics . push_back ( { 2, 1 } ); logics . push_back ( { 1, 2 } ); }
+      if ( n == 4 ) logics . push_back ( { 2, 2 } );
+      std::vector<Constraints> constraint_lists = { Constraints () };
+      if ( n >= 2 ) constraint_lists . push_back ( { { 0b11, { 0b01, 0b10 } } } );
+      int64_t N = (1 << n);
+      for ( int64_t m = 1; m <= 3; ++ m ) {
+        for ( auto const& logic : logics ) {
+          for ( auto const& constraints : constraint_lists ) {
+            uint64_t realizable_count = 0;
+            if ( N * std::log2 ( m + 1 ) <= 13 ) {
+              // Every map, and every change of a single bin from it
+              std::vector<int64_t> data ( N, 0 );
+              while ( true ) {
+                MonotonicMap map ( n, m, logic, constraints, data );
+                bool monotonic = ScalarMonotonic ( map );
+                bool realizable = ScalarRealizable ( map );
+                if ( CheckMap ( map, 0, false, false ) ) ++ realizable_count;
+                for ( int64_t i = 0; i < N; ++ i ) {
+                  for ( int64_t value = 0; value <= m; ++ value ) {
+                    MonotonicMap changed = map;
+                    changed . bin_ [ i ] = value;
+                    CheckMap ( changed, i, monotonic, realizable );
+                  }
+                }
+                int64_t k = 0;
+                while ( k < N && data [ k ] == m ) data [ k ++ ] = 0;
+                if ( k == N ) break;
+                ++ data [ k ];
+              }
+            } else {
+              // A random walk through the monotonic realizable maps, checking
+              // every single-bin change along the way
+              MonotonicMap map ( n, m, logic, constraints, std::vector<int64_t> ( N, 0 ) );
+              for ( uint64_t step = 0; step < 4096 / N; ++ step ) {
+                std::vector<MonotonicMap> moves;
+                for ( int64_t i = 0; i < N; ++ i ) {
+                  for ( int64_t value = 0; value <= m; ++ value ) {
+                    if ( value == map . bin_ [ i ] ) continue;
+                    MonotonicMap changed = map;
+                    changed . bin_ [ i ] = value;
+                    if ( CheckMap ( changed, i, true, true ) ) moves . push_back ( changed );
+                  }
+                }
+                if ( moves . empty () ) break;
+                realizable_count += moves . size ();
+                map = moves [ engine () % moves . size () ];
+              }
+            }
+            if ( realizable_count == 0 ) {
+              throw std::logic_error ( "No realizable maps were checked for n = " + std::to_string ( n ) + ", m = " + std::to_string ( m ) );
+            }
+          }
+        }
+      }
+    }
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}
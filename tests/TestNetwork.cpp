@@ -43,6 +43,26 @@ int main ( int argc, char * argv [] ) {
     boost::archive::text_oarchive oa(std::cout);
     oa << network;
 
+    // Test serialization round trip
+    Network network3;
+    network3 . deserialize ( network . serialize () );
+    if ( network3 . size () != network . size () ) throw std::runtime_error ( "Network::deserialize bug" );
+    if ( network3 . specification () != network . specification () ) throw std::runtime_error ( "Network::deserialize bug" );
+    for ( uint64_t d = 0; d < network . size (); ++ d ) {
+      if ( network3 . name ( d ) != network . name ( d ) ||
+           network3 . logic ( d ) != network . logic ( d ) ||
+           network3 . outputs ( d ) != network . outputs ( d ) ||
+           network3 . essential ( d ) != network . essential ( d ) ||
+           network3 . num_thresholds ( d ) != network . num_thresholds ( d ) ) {
+        throw std::runtime_error ( "Network::deserialize bug" );
+      }
+    }
+    try {
+      Network net;
+      net . deserialize ( "not a network" );
+      return 1;
+    } catch ( std::runtime_error const& ) {}
+
     Network dbnet ( "networks/network5.db" );
     try { 
       Network net ( "networks/network6" ); // doesn't exist
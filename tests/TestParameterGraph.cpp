@@ -40,6 +40,26 @@ int main ( int argc, char * argv [] ) {
       }
     }
 
+    // Test ParameterGraph::coordinates
+    for ( uint64_t i = 0; i < N; ++i ) {
+      std::vector<uint64_t> c = pg . coordinates ( pg . parameter(i) );
+      if ( pg . index ( pg . parameter_from_coordinates ( c ) ) != i ) {
+        throw std::runtime_error("ParameterGraph::coordinates bug");
+      }
+    }
+
+    // Test sampled iteration
+    for ( uint64_t i : pg . random_indices ( 1000, 0 ) ) {
+      if ( i >= N ) throw std::runtime_error("ParameterGraph::random_indices bug");
+    }
+    for ( Parameter const& p : pg . random_parameters ( 100, 0 ) ) {
+      if ( pg . index ( p ) >= N ) throw std::runtime_error("ParameterGraph::random_parameters bug");
+    }
+    if ( pg . strided_indices ( 5, 10, 1000 ) . size () != 12 ) {
+      throw std::runtime_error("ParameterGraph::strided_indices bug");
+    }
+    if ( pg . overflow () ) throw std::runtime_error("ParameterGraph::overflow bug");
+
     // Test ParameterGraph::adjacencies
     std::cout << "Testing adjacencies.\n";
     auto adj = pg . adjacencies ( 57 );
@@ -0,0 +1,88 @@
+/// TestParameterSampler.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "DSGRN.h"
+
+#include <cstring>
+
+int main ( int argc, char * argv [] ) {
+  try {
+    // The CAD instances seeding the Gibbs chains ship with the sources
+    configuration () -> set_path ( "../src/DSGRN/Resources" );
+    Network network;
+    network . assign ( "X : X + Y \n"
+                       "Y : ~X \n" );
+    ParameterGraph pg ( network );
+    ParameterSampler sampler ( network );
+    uint64_t D = network . size ();
+    // The CAD rows are aligned with the factor graphs, so sample_indices
+    // can read them by logic coordinate
+    CADTable X_table ( "../src/DSGRN/Resources/CAD/2_2_1_1" );
+    CADTable Y_table ( "../src/DSGRN/Resources/CAD/1_1_1" );
+    if ( X_table . size () != pg . logicsize ( 0 ) || Y_table . size () != pg . logicsize ( 1 ) ) {
+      throw std::logic_error ( "CAD tables do not have a row per factor" );
+    }
+    for ( uint64_t i = 0; i < pg . logicsize ( 0 ); ++ i ) {
+      if ( X_table . hex ( i ) != pg . factorgraph ( 0 ) [ i ] ) throw std::logic_error ( "CAD table of X is not aligned with its factor graph" );
+    }
+    for ( uint64_t i = 0; i < pg . logicsize ( 1 ); ++ i ) {
+      if ( Y_table . hex ( i ) != pg . factorgraph ( 1 ) [ i ] ) throw std::logic_error ( "CAD table of Y is not aligned with its factor graph" );
+    }
+    uint64_t count = 20;
+    uint64_t seed = 7;
+    for ( uint64_t pi = 0; pi < pg . size (); ++ pi ) {
+      Parameter p = pg . parameter ( pi );
+      std::vector<std::string> names = sampler . names ( p );
+      std::vector<double> samples = sampler . sample_many ( p, count, seed, 2, pi );
+      // The same seed and index give the same samples
+      if ( samples != sampler . sample_many ( p, count, seed, 2, pi ) ) throw std::logic_error ( "sample_many is not reproducible" );
+      if ( sampler . sample ( p, seed, pi ) != sampler . sample ( p, seed, pi ) ) throw std::logic_error ( "sample is not reproducible" );
+      // Every sample lies inside the region of the parameter: lay the
+      // named columns out as L[s][i][j], U[s][i][j] and T[s][i][j]
+      std::vector<double> L ( count * D * D, 0.0 );
+      std::vector<double> U ( count * D * D, 0.0 );
+      std::vector<double> T ( count * D * D, 0.0 );
+      for ( uint64_t c = 0; c < names . size (); ++ c ) {
+        std::string const& name = names [ c ];
+        uint64_t arrow = name . find ( "->" );
+        uint64_t i = network . index ( name . substr ( 2, arrow - 2 ) );
+        uint64_t j = network . index ( name . substr ( arrow + 2, name . size () - arrow - 3 ) );
+        std::vector<double> & variable = ( name [ 0 ] == 'L' ) ? L : ( ( name [ 0 ] == 'U' ) ? U : T );
+        for ( uint64_t s = 0; s < count; ++ s ) {
+          variable [ s * D * D + i * D + j ] = samples [ s * names . size () + c ];
+        }
+      }
+      for ( uint64_t index : pg . index_from_samples ( L . data (), U . data (), T . data (), count, 1 ) ) {
+        if ( index != pi ) throw std::logic_error ( "Sample outside of the region of parameter " + std::to_string ( pi ) );
+      }
+    }
+    // A different seed gives different samples
+    Parameter p = pg . parameter ( 0 );
+    if ( sampler . sample_many ( p, count, seed, 2, 0 ) == sampler . sample_many ( p, count, seed + 1, 2, 0 ) ) {
+      throw std::logic_error ( "sample_many ignores its seed" );
+    }
+    // sample_indices gives the same bits at any number of threads
+    std::vector<uint64_t> indices;
+    for ( uint64_t pi = pg . size (); pi -- > 0; ) indices . push_back ( pi );
+    std::vector<double> sequential = sampler . sample_indices ( pg, indices, count, seed, 2, 1 );
+    for ( uint64_t num_threads : { 2, 4, 7 } ) {
+      std::vector<double> threaded = sampler . sample_indices ( pg, indices, count, seed, 2, num_threads );
+      if ( threaded . size () != sequential . size () ||
+           std::memcmp ( threaded . data (), sequential . data (), sequential . size () * sizeof ( double ) ) != 0 ) {
+        throw std::logic_error ( "sample_indices depends on the number of threads" );
+      }
+    }
+    // and its rows are those of sample_many
+    std::vector<double> rows = sampler . sample_many ( pg . parameter ( indices [ 1 ] ), count, seed, 2, indices [ 1 ] );
+    if ( not std::equal ( rows . begin (), rows . end (), sequential . begin () + rows . size () ) ) {
+      throw std::logic_error ( "sample_indices does not agree with sample_many" );
+    }
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -67,6 +67,9 @@ int main ( int argc, char * argv [] ) {
       // Confirm results
       if ( not cycle_match ) throw std::logic_error ( "Expected cycle match" );
       if ( not path_match ) throw std::logic_error ( "Expected path match" );
+      if ( CountCycleMatches ( mg ) == 0 ) throw std::logic_error ( "Expected nonzero cycle match count" );
+      MatchEnumerator enumerator ( mg, true );
+      if ( enumerator . take ( -1 ) . size () != enumerator . count () ) throw std::logic_error ( "Cycle match enumeration does not agree with count" );
     }
     // Test 2
     {
@@ -93,6 +96,94 @@ int main ( int argc, char * argv [] ) {
       // Confirm results
       if ( cycle_match ) throw std::logic_error ( "Unexpected cycle match" );
       if ( path_match ) throw std::logic_error ( "Unexpected path match" );      
+      if ( CountPathMatches ( mg ) != 0 ) throw std::logic_error ( "Unexpected path match count" );
+    }
+    // Test 3
+    {
+      // Build pattern: X max, then Y max, ending with both decreasing
+      Digraph digraph;
+      digraph . resize ( 2 );
+      digraph . add_edge ( 0, 1 );
+      std::vector<uint64_t> events = { 0, 1 };
+      uint64_t label = 3; // DD
+      uint64_t dimension = 2;
+      Poset poset ( digraph );
+      Pattern pattern ( poset, events, label, dimension);
+      PatternGraph pg ( pattern );
+      LinearPathMatcher matcher ( pg );
+      // Label sequences (bit d decreasing, bit 2+d increasing)
+      std::vector<std::vector<uint64_t>> sequences = { { 12, 9, 3 }, { 12, 6, 3 }, { 12, 12, 9, 9, 3 }, { 3 } };
+      for ( auto const& labels : sequences ) {
+        SearchGraph sg ( labels, dimension );
+        MatchingGraph mg ( sg, pg );
+        if ( matcher . query ( labels ) != QueryPathMatch ( mg ) ) throw std::logic_error ( "Linear path matcher does not agree with QueryPathMatch" );
+      }
+      if ( not matcher . query ( sequences [ 0 ] ) ) throw std::logic_error ( "Expected linear path match" );
+      if ( matcher . query ( sequences [ 1 ] ) ) throw std::logic_error ( "Unexpected linear path match" );
+      // Merged patterns: "X max, Y max", "Y max, X max" and a totally
+      // ordered alternation long enough to need several bitset words
+      auto chain = [&](std::vector<uint64_t> const& chain_events) {
+        Digraph chain_digraph;
+        chain_digraph . resize ( chain_events . size () );
+        for ( uint64_t i = 1; i < chain_events . size (); ++ i ) chain_digraph . add_edge ( i - 1, i );
+        return PatternGraph ( Pattern ( Poset ( chain_digraph ), chain_events, label, dimension ) );
+      };
+      std::vector<uint64_t> alternation;
+      for ( uint64_t i = 0; i < 80; ++ i ) alternation . push_back ( i % 2 );
+      std::vector<PatternGraph> patterngraphs = { pg, chain ( { 1, 0 } ), chain ( alternation ) };
+      MultiPatternGraph mpg ( patterngraphs );
+      LinearPathMatcher multimatcher ( mpg );
+      if ( mpg . size () <= 64 ) throw std::logic_error ( "Expected a multi-word MultiPatternGraph" );
+      // X min, Y min, X max, Y max, repeated: a match of the alternation
+      std::vector<uint64_t> alternating_labels = { 3 };
+      for ( uint64_t i = 0; i < 20; ++ i ) alternating_labels . insert ( alternating_labels . end (), { 6, 12, 9, 3 } );
+      sequences . push_back ( alternating_labels );
+      sequences . push_back ( { 12, 6, 3, 9, 3 } );
+      for ( auto const& labels : sequences ) {
+        SearchGraph sg ( labels, dimension );
+        std::vector<bool> matched = multimatcher . matches ( labels );
+        for ( uint64_t k = 0; k < patterngraphs . size (); ++ k ) {
+          MatchingGraph mg ( sg, patterngraphs [ k ] );
+          if ( matched [ k ] != QueryPathMatch ( mg ) ) throw std::logic_error ( "Linear path matcher on merged patterns does not agree with QueryPathMatch" );
+        }
+      }
+      if ( not multimatcher . matches ( alternating_labels ) [ 2 ] ) throw std::logic_error ( "Expected linear path match of the alternation" );
+    }
+    // Test 4
+    {
+      // Build patterns sharing the prefix "X max, Y max"
+      auto build = [](std::vector<uint64_t> const& events, std::vector<std::pair<uint64_t,uint64_t>> const& edges) {
+        Digraph digraph;
+        digraph . resize ( events . size () );
+        for ( auto const& e : edges ) digraph . add_edge ( e . first, e . second );
+        uint64_t label = 3; // DD
+        uint64_t dimension = 2;
+        return PatternGraph ( Pattern ( Poset ( digraph ), events, label, dimension ) );
+      };
+      std::vector<PatternGraph> patterngraphs = { build ( { 0, 1 }, { {0, 1} } ), 
+                                                  build ( { 0, 1, 0, 1 }, { {0, 1}, {1, 2}, {2, 3} } ), 
+                                                  build ( { 0, 1, 0, 1 }, { {0, 1}, {0, 2}, {1, 3} } ),
+                                                  build ( { 0, 1, 0, 1 }, { {0, 2}, {1, 3} } ),
+                                                  build ( { 0 }, { } ) };
+      MultiPatternGraph mpg ( patterngraphs );
+      uint64_t total = 0;
+      for ( auto const& pg : patterngraphs ) total += pg . size ();
+      if ( mpg . size () >= total ) throw std::logic_error ( "Expected shared prefixes in MultiPatternGraph" );
+      // Compare with the single pattern matchers on every Morse set
+      for ( uint64_t pi = 0; pi < parametergraph . size (); ++ pi ) {
+        DomainGraph dg ( parametergraph . parameter ( pi ) );
+        MorseDecomposition md ( dg . digraph () );
+        for ( uint64_t ms = 0; ms < md . recurrent () . size (); ++ ms ) {
+          SearchGraph sg ( dg, ms );
+          std::vector<bool> cycle_matches = QueryCycleMatches ( sg, mpg );
+          std::vector<bool> path_matches = QueryPathMatches ( sg, mpg );
+          for ( uint64_t k = 0; k < patterngraphs . size (); ++ k ) {
+            MatchingGraph mg ( sg, patterngraphs [ k ] );
+            if ( cycle_matches [ k ] != QueryCycleMatch ( mg ) ) throw std::logic_error ( "QueryCycleMatches does not agree with QueryCycleMatch" );
+            if ( path_matches [ k ] != QueryPathMatch ( mg ) ) throw std::logic_error ( "QueryPathMatches does not agree with QueryPathMatch" );
+          }
+        }
+      }
     }
   } catch ( std::exception & e ) {
     std::cout << "Failed: " << e . what () << "\n";
@@ -38,6 +38,91 @@ int main ( int argc, char * argv [] ) {
     if ( output != expected_output ) {
       throw std::logic_error("Did not get expected output");
     }
+    // Construct the same search graph labelling only the domains of the Morse set
+    MorseDecomposition md ( dg . digraph () );
+    std::vector<uint64_t> morse_set ( md . recurrent () [ 0 ] . begin (), md . recurrent () [ 0 ] . end () );
+    LazyDomainGraph ldg ( p );
+    if ( SearchGraph ( ldg, morse_set ) . graphviz () != expected_output ) {
+      throw std::logic_error("Did not get expected output from Morse set domains");
+    }
+    // Construct it again exploring from a domain of the Morse set
+    // (its vertices are then sorted by domain)
+    SearchGraph local ( ldg, morse_set [ 0 ] );
+    std::sort ( morse_set . begin (), morse_set . end () );
+    if ( local . graphviz () != SearchGraph ( ldg, morse_set ) . graphviz () ) {
+      throw std::logic_error("Did not get expected output from seed domain");
+    }
+    // Non-adjacent domains have no edge label
+    bool thrown = false;
+    try { ldg . label ( 0, ldg . size () - 1 ); } catch ( std::invalid_argument & ) { thrown = true; }
+    if ( not thrown ) throw std::logic_error("Expected an error for the label of non-adjacent domains");
+    thrown = false;
+    try { ldg . wide_label ( 0, ldg . size () - 1 ); } catch ( std::invalid_argument & ) { thrown = true; }
+    if ( not thrown ) throw std::logic_error("Expected an error for the wide label of non-adjacent domains");
+    // Every Morse set of a parameter with a fixed point and a cycle
+    Parameter q = pg . parameter ( 92 );
+    DomainGraph dgq ( q );
+    MorseDecomposition mdq ( dgq . digraph () );
+    if ( mdq . recurrent () . size () != 2 ) throw std::logic_error("Expected two Morse sets");
+    for ( uint64_t ms = 0; ms < mdq . recurrent () . size (); ++ ms ) {
+      std::vector<uint64_t> domains ( mdq . recurrent () [ ms ] . begin (), mdq . recurrent () [ ms ] . end () );
+      LazyDomainGraph lazy ( q );
+      if ( SearchGraph ( lazy, domains ) . graphviz () != SearchGraph ( dgq, ms ) . graphviz () ) {
+        throw std::logic_error("Did not get expected output from Morse set domains");
+      }
+      // Only the domains near the Morse set are labelled from a seed
+      LazyDomainGraph seeded ( q );
+      if ( seeded . explored () != 0 ) throw std::logic_error("Expected no explored domains");
+      SearchGraph from_seed ( seeded, domains [ 0 ] );
+      if ( seeded . explored () < domains . size () || seeded . explored () > seeded . size () ) {
+        throw std::logic_error("Unexpected number of explored domains");
+      }
+      if ( domains . size () == 1 && seeded . explored () == seeded . size () ) {
+        throw std::logic_error("Expected a fixed point to be found without labelling all domains");
+      }
+      std::sort ( domains . begin (), domains . end () );
+      if ( from_seed . graphviz () != SearchGraph ( lazy, domains ) . graphviz () ) {
+        throw std::logic_error("Did not get expected output from seed domain");
+      }
+    }
+    // A Morse set which is not an attractor is found without labelling
+    // everything downstream of it
+    Network downstream_network ( "X : (X)(~Z) \n"
+                                 "Y : X + Y \n"
+                                 "Z : X + Y \n" );
+    Parameter r = ParameterGraph ( downstream_network ) . parameter ( 1020 );
+    MorseDecomposition mdr ( DomainGraph ( r ) . digraph () );
+    if ( mdr . poset () . children ( 0 ) . empty () ) throw std::logic_error("Expected a Morse set which is not an attractor");
+    std::vector<uint64_t> repelling ( mdr . recurrent () [ 0 ] . begin (), mdr . recurrent () [ 0 ] . end () );
+    LazyDomainGraph lazy_r ( r );
+    SearchGraph from_repelling ( lazy_r, repelling [ 0 ] );
+    if ( lazy_r . explored () == lazy_r . size () ) throw std::logic_error("Expected the Morse set to be found without labelling all domains");
+    std::sort ( repelling . begin (), repelling . end () );
+    if ( from_repelling . graphviz () != SearchGraph ( lazy_r, repelling ) . graphviz () ) {
+      throw std::logic_error("Did not get expected output from seed domain");
+    }
+    // Pattern matching labels are uint64_t's: 40 dimensions are refused
+    // up front, while the lazy domain graph labels them with two words
+    std::string ring;
+    for ( uint64_t i = 0; i < 40; ++ i ) {
+      ring += "X" + std::to_string ( i ) + " : ~X" + std::to_string ( ( i + 39 ) % 40 ) + "\n";
+    }
+    Network wide_network;
+    wide_network . assign ( ring );
+    LazyDomainGraph wide ( ParameterGraph ( wide_network ) . parameter ( 0 ) );
+    if ( wide . label_words () != 2 ) throw std::logic_error("Expected labels of two words");
+    thrown = false;
+    try { SearchGraph wide_search ( wide, 0 ); } catch ( std::length_error & ) { thrown = true; }
+    if ( not thrown ) throw std::logic_error("Expected an error for the search graph of 40 dimensions");
+    if ( wide . explored () != 0 ) throw std::logic_error("Expected no domain explored before the error");
+    // Label strings of a label and of its words agree
+    MatchingRelation mr ( 2 );
+    for ( uint64_t L = 0; L < 16; ++ L ) {
+      if ( mr . vertex_labelstring ( L ) != mr . vertex_labelstring ( std::vector<uint64_t> { L } ) ||
+           mr . edge_labelstring ( L ) != mr . edge_labelstring ( std::vector<uint64_t> { L } ) ) {
+        throw std::logic_error("Label strings of a label and of its words differ");
+      }
+    }
   } catch ( std::exception & e ) {
     std::cout << "Failed: " << e . what () << "\n";
     return 1;
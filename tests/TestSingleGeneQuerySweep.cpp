@@ -0,0 +1,138 @@
+/// TestSingleGeneQuerySweep.cpp
+/// Shaun Harker
+/// 2026-10-19
+/// MIT LICENSE
+
+#include "common.h"
+#include "DSGRN.h"
+
+/// hysteresis_label
+///   The label HysteresisQuery gives a Morse graph: 'Q' ('P') if its only
+///   minimal Morse node is a fixed point with the gene off (fully on), 'B'
+///   if it has both fixed points, 'q' ('p') if it has only the first (second)
+///   and 'O' otherwise
+char
+hysteresis_label ( MorseGraph const& mg, uint64_t gene, uint64_t top ) {
+  uint64_t minimal = 0;
+  bool off = false, on = false;
+  for ( uint64_t v = 0; v < mg . poset () . size (); ++ v ) {
+    if ( not mg . poset () . children ( v ) . empty () ) continue;
+    ++ minimal;
+    for ( std::string const& label : mg . annotation ( v ) ) {
+      if ( label . compare ( 0, 2, "FP" ) != 0 ) continue;
+      std::vector<uint64_t> x;
+      std::stringstream ss ( label . substr ( label . find ( '{' ) + 1 ) );
+      uint64_t value;
+      while ( ss >> value ) { x . push_back ( value ); ss . ignore ( 1 ); }
+      off = off or ( x [ gene ] == 0 );
+      on = on or ( x [ gene ] == top );
+    }
+  }
+  if ( minimal == 1 and off ) return 'Q';
+  if ( minimal == 1 and on ) return 'P';
+  if ( off and on ) return 'B';
+  if ( off ) return 'q';
+  if ( on ) return 'p';
+  return 'O';
+}
+
+/// hysteresis
+///   Per parameter HysteresisQuery: align the graph of adjacent gene hex
+///   codes (labelled by "labels") with the pattern graph Q -> B -> P and
+///   check that the leaf of the pattern is reachable from the root
+bool
+hysteresis ( std::vector<std::string> const& hexcodes, std::string const& labels ) {
+  uint64_t N = hexcodes . size ();
+  auto adjacent = [&]( uint64_t u, uint64_t v ) {
+    uint64_t a = std::stoull ( hexcodes [ u ], nullptr, 16 );
+    uint64_t b = std::stoull ( hexcodes [ v ], nullptr, 16 );
+    return a < b and __builtin_popcountll ( a ^ b ) == 1;
+  };
+  std::string const pattern_labels = "QqBpP";
+  std::vector<std::vector<uint64_t>> pattern = { { 0, 1, 2 }, { 1, 0, 2 }, { 2, 3, 4 }, { 3, 4 }, { 4, 3 } };
+  std::vector<bool> visited ( N * 5, false );
+  std::vector<std::pair<uint64_t,uint64_t>> stack;
+  if ( labels [ 0 ] == 'Q' ) { stack . push_back ( { 0, 0 } ); visited [ 0 ] = true; }
+  while ( not stack . empty () ) {
+    auto [ u, s ] = stack . back ();
+    stack . pop_back ();
+    if ( u == N - 1 and s == 4 ) return true;
+    for ( uint64_t v = 0; v < N; ++ v ) {
+      if ( not adjacent ( u, v ) ) continue;
+      for ( uint64_t t : pattern [ s ] ) {
+        if ( labels [ v ] != pattern_labels [ t ] or visited [ v * 5 + t ] ) continue;
+        visited [ v * 5 + t ] = true;
+        stack . push_back ( { v, t } );
+      }
+    }
+  }
+  return false;
+}
+
+int main ( int argc, char * argv [] ) {
+  try {
+    configuration () -> set_path ( "../src/DSGRN/Resources" );
+    Network network ( "X : (X)(~Y) \n"
+                      "Y : X + Y \n" );
+    ParameterGraph pg ( network );
+    std::string gene = "X";
+    uint64_t g = network . index ( gene );
+    uint64_t top = network . outputs ( g ) . size ();
+    // Signatures and labels, one Morse graph index per distinct Morse graph
+    std::vector<uint64_t> morsegraphindices;
+    std::vector<char> labels;
+    std::unordered_map<std::string, uint64_t> lookup;
+    for ( uint64_t pi = 0; pi < pg . size (); ++ pi ) {
+      MorseGraph mg ( DomainGraph ( pg . parameter ( pi ) ) );
+      std::string gv = mg . graphviz ();
+      if ( not lookup . count ( gv ) ) {
+        lookup [ gv ] = labels . size ();
+        labels . push_back ( hysteresis_label ( mg, g, top ) );
+      }
+      morsegraphindices . push_back ( lookup [ gv ] );
+    }
+    SingleGeneQuerySweep sweep ( network, gene, morsegraphindices, labels );
+    ComputeSingleGeneQuery query ( network, gene, [&]( uint64_t pi ) { return labels [ morsegraphindices [ pi ] ]; } );
+    std::vector<std::string> hexcodes = pg . factorgraph ( g );
+    uint64_t R = sweep . number_of_reduced_parameters ();
+    if ( R * hexcodes . size () != pg . size () ) throw std::logic_error ( "Reduced parameters do not cover the parameter graph" );
+    // Per parameter reference: the reduced parameter of a parameter is
+    // everything but the logic of the gene
+    auto rest = [&]( uint64_t pi ) {
+      Parameter p = pg . parameter ( pi );
+      std::stringstream ss;
+      for ( uint64_t d = 0; d < network . size (); ++ d ) if ( d != g ) ss << p . logic () [ d ] . hex () << " ";
+      for ( auto const& order : p . order () ) ss << order << " ";
+      return std::pair<std::string,std::string> ( ss . str (), p . logic () [ g ] . hex () );
+    };
+    std::unordered_map<std::string, std::string> reference;
+    for ( uint64_t pi = 0; pi < pg . size (); ++ pi ) {
+      auto key = rest ( pi );
+      std::string & s = reference [ key . first ];
+      s . resize ( hexcodes . size (), ' ' );
+      uint64_t gpi = std::find ( hexcodes . begin (), hexcodes . end (), key . second ) - hexcodes . begin ();
+      s [ gpi ] = labels [ morsegraphindices [ pi ] ];
+    }
+    if ( reference . size () != R ) throw std::logic_error ( "Wrong number of reduced parameters" );
+    NFA pattern = CompileRegexToNFA ( "Q(Q|q)*B+(p|P)*P" );
+    std::vector<uint8_t> expected ( R );
+    uint64_t positives = 0;
+    for ( uint64_t rpi = 0; rpi < R; ++ rpi ) {
+      std::string key = rest ( query . full_parameter_index ( rpi, 0 ) ) . first;
+      if ( sweep . labelstring ( rpi ) != reference [ key ] ) throw std::logic_error ( "Wrong labels for reduced parameter " + std::to_string ( rpi ) );
+      expected [ rpi ] = hysteresis ( hexcodes, reference [ key ] );
+      positives += expected [ rpi ];
+      if ( sweep . match ( pattern, rpi ) != (bool) expected [ rpi ] ) {
+        throw std::logic_error ( "Sweep disagrees with HysteresisQuery on reduced parameter " + std::to_string ( rpi ) + " labelled " + reference [ key ] );
+      }
+    }
+    if ( positives == 0 || positives == R ) throw std::logic_error ( "The hysteresis query does not separate the reduced parameters" );
+    for ( uint64_t num_threads : { 1, 2, 5 } ) {
+      if ( sweep ( pattern, num_threads ) != expected ) throw std::logic_error ( "Sweep depends on the number of threads" );
+    }
+  } catch ( std::exception & e ) {
+    std::cout << "Failed: " << e . what () << "\n";
+    return 1;
+  }
+  return 0;
+}